@@ -50,6 +50,7 @@
  * - Macro Def Statements     - number of statements defined in macro files (only the first occurence of the macro)
  * - Lookahead Statements     - number of statements processed in lookahead mode
  * - Reparsed Statements      - number of statements that were reparsed later (e.g. model statements)
+ * - LL Fallback Statements   - number of operand fields that had to be parsed again with the full LL prediction
  * - Continued Statements     - number of statements that were continued (multiple continuations of one statement count
  *as one continued statement)
  * - Non-continued Statements - number of statements that were not continued
@@ -193,6 +194,7 @@ json parse_one_file(const std::string& source_file,
                   << "Macro Def Statements: " << collector.metrics_.macro_def_statements << '\n'
                   << "Lookahead Statements: " << collector.metrics_.lookahead_statements << '\n'
                   << "Reparsed Statements: " << collector.metrics_.reparsed_statements << '\n'
+                  << "LL Fallback Statements: " << collector.metrics_.ll_fallback_statements << '\n'
                   << "Continued Statements: " << collector.metrics_.continued_statements << '\n'
                   << "Non-continued Statements: " << collector.metrics_.non_continued_statements << '\n'
                   << "Lines: " << collector.metrics_.lines << '\n'
@@ -217,6 +219,7 @@ json parse_one_file(const std::string& source_file,
         { "Macro Def Statements", collector.metrics_.macro_def_statements },
         { "Lookahead Statements", collector.metrics_.lookahead_statements },
         { "Reparsed Statements", collector.metrics_.reparsed_statements },
+        { "LL Fallback Statements", collector.metrics_.ll_fallback_statements },
         { "Continued Statements", collector.metrics_.continued_statements },
         { "Non-continued Statements", collector.metrics_.non_continued_statements },
         { "Executed Statements", exec_statements },
@@ -217,6 +217,8 @@ struct PARSER_LIBRARY_EXPORT performance_metrics
     size_t copy_def_statements = 0;
     size_t copy_statements = 0;
     size_t reparsed_statements = 0;
+    size_t ll_fallback_statements = 0;
+    size_t reused_statements = 0;
     size_t lookahead_statements = 0;
     size_t continued_statements = 0;
     size_t non_continued_statements = 0;
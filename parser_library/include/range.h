@@ -58,6 +58,14 @@ struct PARSER_LIBRARY_EXPORT range
     position end;
 };
 
+// moves the range by the number of lines, the line numbers wrap around, so a negated count moves the range up
+inline range shift_lines(range r, position_t lines)
+{
+    r.start.line += lines;
+    r.end.line += lines;
+    return r;
+}
+
 struct PARSER_LIBRARY_EXPORT file_range
 {
     file_range(range r, const std::string* file)
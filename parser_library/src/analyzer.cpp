@@ -49,7 +49,8 @@ analyzer::analyzer(
     : analyzer(text,
         file_name,
         analyzing_context {
-            std::make_unique<context::hlasm_context>(file_name, lib_provider.get_asm_options(file_name)),
+            std::make_unique<context::hlasm_context>(
+                file_name, lib_provider.get_asm_options(file_name), lib_provider.get_id_storage()),
             std::make_unique<lsp::lsp_context>() },
         lib_provider,
         library_data { processing::processing_kind::ORDINARY, context::id_storage::empty_id },
@@ -86,3 +87,17 @@ void analyzer::register_stmt_analyzer(statement_analyzer* stmt_analyzer)
 {
     mngr_.register_stmt_analyzer(stmt_analyzer);
 }
+
+void analyzer::use_checkpoints(parsing::statement_checkpoints checkpoints)
+{
+    // statements refer to identifiers of the storage they were parsed with
+    if (checkpoints.ids() != ctx_.hlasm_ctx->ids_ptr())
+        checkpoints = parsing::statement_checkpoints(ctx_.hlasm_ctx->ids_ptr());
+    parser_->use_checkpoints(std::move(checkpoints));
+}
+
+parsing::statement_checkpoints analyzer::take_checkpoints() { return parser_->take_checkpoints(); }
+
+void analyzer::set_two_stage_prediction(bool enabled) { parser_->set_two_stage_prediction(enabled); }
+
+void analyzer::set_mach_operand_parser(bool enabled) { parser_->set_mach_operand_parser(enabled); }
@@ -67,6 +67,15 @@ public:
     const performance_metrics& get_metrics() const;
 
     void register_stmt_analyzer(processing::statement_analyzer* stmt_analyzer);
+
+    // lets the analysis of the open code record its statements and reuse the ones recorded by a previous analysis
+    void use_checkpoints(parsing::statement_checkpoints checkpoints);
+    parsing::statement_checkpoints take_checkpoints();
+
+    // parses operand fields with the SLL prediction first, with the full LL prediction only when it fails (default)
+    void set_two_stage_prediction(bool enabled);
+    // parses the common machine operand fields without the grammar (default)
+    void set_mach_operand_parser(bool enabled);
 };
 
 } // namespace hlasm_plugin::parser_library
@@ -15,12 +15,16 @@
 #ifndef CONTEXT_CODE_SCOPE_H
 #define CONTEXT_CODE_SCOPE_H
 
+#include <optional>
+
 #include "macro.h"
 #include "variables/set_symbol.h"
 #include "variables/system_variable.h"
 
 namespace hlasm_plugin::parser_library::context {
 
+class section;
+
 // helper struct for HLASM code scopes
 // contains locally valid set symbols, sequence symbols and pointer to macro class (if code is in any)
 struct code_scope
@@ -41,6 +45,16 @@ struct code_scope
     // number of changed branch counters
     size_t branch_counter_change;
 
+    // state at the macro entry, the local system variables are created from it when they are first accessed
+    struct system_variable_seed
+    {
+        const section* sect;
+        id_index loctr;
+        size_t sysndx;
+        size_t nest;
+    };
+    std::optional<system_variable_seed> pending_system_variables;
+
     bool is_in_macro() const { return !!this_macro; }
 
     code_scope(macro_invo_ptr macro_invo, macro_def_ptr macro_def)
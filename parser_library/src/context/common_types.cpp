@@ -15,6 +15,8 @@
 #include "common_types.h"
 
 #include <cctype>
+#include <new>
+#include <utility>
 
 namespace hlasm_plugin::parser_library::context {
 
@@ -33,50 +35,120 @@ std::string to_upper_copy(std::string s)
 }
 
 SET_t::SET_t(context::A_t value)
-    : a_value(value)
-    , b_value(value)
-    , c_value(object_traits<C_t>::default_v())
+    : scalar { value, value != 0 }
     , type(SET_t_enum::A_TYPE)
 {}
 
 SET_t::SET_t(context::B_t value)
-    : a_value(value)
-    , b_value(value)
-    , c_value(object_traits<C_t>::default_v())
+    : scalar { value, value }
     , type(SET_t_enum::B_TYPE)
 {}
 
-SET_t::SET_t(context::C_t value)
-    : a_value(object_traits<A_t>::default_v())
-    , b_value(object_traits<B_t>::default_v())
-    , c_value(value)
+SET_t::SET_t(const context::C_t& value)
+    : c_value(value)
+    , type(SET_t_enum::C_TYPE)
+{}
+
+SET_t::SET_t(context::C_t&& value)
+    : c_value(std::move(value))
     , type(SET_t_enum::C_TYPE)
 {}
 
 SET_t::SET_t(const char* value)
-    : a_value(object_traits<A_t>::default_v())
-    , b_value(object_traits<B_t>::default_v())
-    , c_value(value)
+    : c_value(value)
     , type(SET_t_enum::C_TYPE)
 {}
 
 SET_t::SET_t(SET_t_enum type)
-    : a_value(object_traits<A_t>::default_v())
-    , b_value(object_traits<B_t>::default_v())
-    , c_value(object_traits<C_t>::default_v())
-    , type(type)
-{}
+    : type(type)
+{
+    if (holds_c())
+        new (&c_value) C_t();
+    else
+        scalar = { object_traits<A_t>::default_v(), object_traits<B_t>::default_v() };
+}
+
+SET_t::SET_t(const SET_t& other)
+    : type(other.type)
+{
+    if (holds_c())
+        new (&c_value) C_t(other.c_value);
+    else
+        scalar = other.scalar;
+}
+
+SET_t::SET_t(SET_t&& other) noexcept
+    : type(other.type)
+{
+    if (holds_c())
+        new (&c_value) C_t(std::move(other.c_value));
+    else
+        scalar = other.scalar;
+}
+
+SET_t& SET_t::operator=(const SET_t& other)
+{
+    if (this == &other)
+        return *this;
+    if (holds_c() && other.holds_c())
+        c_value = other.c_value;
+    else if (other.holds_c())
+        new (&c_value) C_t(other.c_value);
+    else
+    {
+        if (holds_c())
+            c_value.~C_t();
+        scalar = other.scalar;
+    }
+    type = other.type;
+    return *this;
+}
+
+SET_t& SET_t::operator=(SET_t&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+    if (holds_c() && other.holds_c())
+        c_value = std::move(other.c_value);
+    else if (other.holds_c())
+        new (&c_value) C_t(std::move(other.c_value));
+    else
+    {
+        if (holds_c())
+            c_value.~C_t();
+        scalar = other.scalar;
+    }
+    type = other.type;
+    return *this;
+}
+
+SET_t::~SET_t()
+{
+    if (holds_c())
+        c_value.~C_t();
+}
+
+namespace {
+// the value of the other representation, reset to default at each access
+template<typename T>
+T& detached_default()
+{
+    thread_local T value;
+    value = object_traits<T>::default_v();
+    return value;
+}
+} // namespace
 
-A_t& SET_t::access_a() { return a_value; }
+A_t& SET_t::access_a() { return holds_c() ? detached_default<A_t>() : scalar.a_value; }
 
-B_t& SET_t::access_b() { return b_value; }
+B_t& SET_t::access_b() { return holds_c() ? detached_default<B_t>() : scalar.b_value; }
 
-C_t& SET_t::access_c() { return c_value; }
+C_t& SET_t::access_c() { return holds_c() ? c_value : detached_default<C_t>(); }
 
-const A_t& SET_t::access_a() const { return a_value; }
+const A_t& SET_t::access_a() const { return holds_c() ? object_traits<A_t>::default_v() : scalar.a_value; }
 
-const B_t& SET_t::access_b() const { return b_value; }
+const B_t& SET_t::access_b() const { return holds_c() ? object_traits<B_t>::default_v() : scalar.b_value; }
 
-const C_t& SET_t::access_c() const { return c_value; }
+const C_t& SET_t::access_c() const { return holds_c() ? c_value : object_traits<C_t>::default_v(); }
 
 } // namespace hlasm_plugin::parser_library::context
@@ -91,23 +91,45 @@ struct object_traits<C_t>
 };
 
 // struct agregating SET types for easier usage
+// holds either the arithmetic and binary value or the character value, so that arithmetic and binary values
+// do not carry an empty string around; the character value relies on the small string optimization of C_t
 struct SET_t
 {
 private:
-    A_t a_value;
-    B_t b_value;
-    C_t c_value;
+    // arithmetic and binary values are kept together, so that each can be accessed as the other
+    struct scalar_t
+    {
+        A_t a_value;
+        B_t b_value;
+    };
+
+    union
+    {
+        scalar_t scalar;
+        C_t c_value;
+    };
 
 public:
     SET_t(A_t value);
     SET_t(B_t value);
-    SET_t(C_t value);
+    SET_t(const C_t& value);
+    // lets functions return their local strings without a copy
+    SET_t(C_t&& value);
     // for string literals (otherwise they prefer coversion to bool rather than to string)
     SET_t(const char* value);
     SET_t(SET_t_enum type = SET_t_enum::UNDEF_TYPE);
 
+    SET_t(const SET_t& other);
+    SET_t(SET_t&& other) noexcept;
+    SET_t& operator=(const SET_t& other);
+    SET_t& operator=(SET_t&& other) noexcept;
+    ~SET_t();
+
+    // may only be switched between A_TYPE and B_TYPE, the character value is stored differently
     SET_t_enum type;
 
+    // values of the other representation are read as defaults,
+    // writes into them are not kept
     A_t& access_a();
     B_t& access_b();
     C_t& access_c();
@@ -115,6 +137,9 @@ public:
     const A_t& access_a() const;
     const B_t& access_b() const;
     const C_t& access_c() const;
+
+private:
+    bool holds_c() const { return type == SET_t_enum::C_TYPE; }
 };
 
 // just mock method for now, will be implemented later with respect to UTF/EBCDIC
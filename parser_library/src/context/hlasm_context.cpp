@@ -14,8 +14,11 @@
 
 #include "hlasm_context.h"
 
+#include <algorithm>
 #include <ctime>
+#include <mutex>
 #include <stdexcept>
+#include <string_view>
 
 #include "ebcdic_encoding.h"
 #include "expressions/conditional_assembly/terms/ca_constant.h"
@@ -28,66 +31,117 @@ code_scope* hlasm_context::curr_scope() { return &scope_stack_.back(); }
 
 const code_scope* hlasm_context::curr_scope() const { return &scope_stack_.back(); }
 
-hlasm_context::instruction_storage hlasm_context::init_instruction_map()
+namespace {
+// open addressing table of the instruction names, filled once and only read afterwards
+class instruction_table
 {
-    hlasm_context::instruction_storage instr_map;
-    for (auto& [name, instr] : instruction::machine_instructions)
+    struct entry
     {
-        auto id = ids_.add(name);
-        instr_map.emplace(id, &instr);
+        std::string_view name;
+        opcode_t::opcode_variant detail;
+    };
+    std::vector<entry> entries_;
+
+    static size_t hash(std::string_view name)
+    {
+        size_t result = 0;
+        for (char c : name)
+            result = result * 31 + (unsigned char)c;
+        return result;
     }
-    for (auto& [name, instr] : instruction::assembler_instructions)
+
+    // the first instruction of the name takes precedence
+    void insert(std::string_view name, opcode_t::opcode_variant detail)
     {
-        auto id = ids_.add(name);
-        instr_map.emplace(id, &instr);
+        const size_t mask = entries_.size() - 1;
+        for (size_t i = hash(name) & mask;; i = (i + 1) & mask)
+        {
+            if (entries_[i].name.empty())
+            {
+                entries_[i] = { name, std::move(detail) };
+                return;
+            }
+            if (entries_[i].name == name)
+                return;
+        }
     }
-    for (auto& instr : instruction::ca_instructions)
+
+public:
+    instruction_table()
     {
-        auto id = ids_.add(instr.name);
-        instr_map.emplace(id, &instr);
+        const size_t count = instruction::machine_instructions.size() + instruction::assembler_instructions.size()
+            + instruction::ca_instructions.size() + instruction::mnemonic_codes.size();
+        // the table is kept sparse, so the lookups rarely probe more than one entry
+        size_t size = 1;
+        while (size < 4 * count)
+            size *= 2;
+        entries_.resize(size);
+
+        for (const auto& [name, instr] : instruction::machine_instructions)
+            insert(name, &instr);
+        for (const auto& [name, instr] : instruction::assembler_instructions)
+            insert(name, &instr);
+        for (const auto& instr : instruction::ca_instructions)
+            insert(instr.name, &instr);
+        for (const auto& [name, instr] : instruction::mnemonic_codes)
+            insert(name, &instr);
     }
-    for (auto& [name, instr] : instruction::mnemonic_codes)
+
+    const opcode_t::opcode_variant* find(std::string_view name) const
     {
-        auto id = ids_.add(name);
-        instr_map.emplace(id, &instr);
+        if (name.empty())
+            return nullptr;
+        const size_t mask = entries_.size() - 1;
+        for (size_t i = hash(name) & mask; !entries_[i].name.empty(); i = (i + 1) & mask)
+            if (entries_[i].name == name)
+                return &entries_[i].detail;
+        return nullptr;
     }
-    return instr_map;
+};
+
+const instruction_table& all_instructions()
+{
+    static const instruction_table table;
+    return table;
 }
+} // namespace
 
-void hlasm_context::add_system_vars_to_scope()
+const opcode_t::opcode_variant* hlasm_context::find_instruction(id_index symbol)
 {
-    if (curr_scope()->is_in_macro())
+    return symbol ? all_instructions().find(*symbol) : nullptr;
+}
+
+void hlasm_context::add_system_vars_to_scope(code_scope& scope)
+{
+    if (scope.pending_system_variables)
     {
-        {
-            auto SYSECT = ids().add("SYSECT");
+        const auto seed = *scope.pending_system_variables;
+        scope.pending_system_variables.reset();
 
-            auto val_sect = std::make_shared<set_symbol<C_t>>(SYSECT, true, false);
-            auto sect_name = ord_ctx.current_section() ? ord_ctx.current_section()->name : id_storage::empty_id;
+        {
+            auto val_sect = std::make_shared<set_symbol<C_t>>(system_ids_.SYSECT, true, false);
+            auto sect_name = seed.sect ? seed.sect->name : id_storage::empty_id;
             val_sect->set_value(*sect_name);
-            curr_scope()->variables.insert({ SYSECT, val_sect });
+            scope.variables.insert({ system_ids_.SYSECT, val_sect });
         }
 
         {
-            auto SYSNDX = ids().add("SYSNDX");
-
-            auto val_ndx = std::make_shared<set_symbol<C_t>>(SYSNDX, true, false);
+            auto val_ndx = std::make_shared<set_symbol<C_t>>(system_ids_.SYSNDX, true, false);
 
-            std::string value = std::to_string(SYSNDX_);
+            std::string value = std::to_string(seed.sysndx);
             int tmp_size = (int)value.size();
             for (int i = 0; i < 4 - tmp_size; ++i)
                 value.insert(value.begin(), '0');
 
             val_ndx->set_value(std::move(value));
-            curr_scope()->variables.insert({ SYSNDX, val_ndx });
+            scope.variables.insert({ system_ids_.SYSNDX, val_ndx });
         }
 
         {
-            auto SYSSTYP = ids().add("SYSSTYP");
-
-            auto val_styp = std::make_shared<set_symbol<C_t>>(SYSSTYP, true, false);
-            if (ord_ctx.current_section())
+            auto val_styp = std::make_shared<set_symbol<C_t>>(system_ids_.SYSSTYP, true, false);
+            if (seed.sect)
             {
-                switch (ord_ctx.current_section()->kind)
+                switch (seed.sect->kind)
                 {
                     case context::section_kind::COMMON:
                         val_styp->set_value("COM");
@@ -105,41 +159,36 @@ void hlasm_context::add_system_vars_to_scope()
                         break;
                 }
             }
-            curr_scope()->variables.insert({ SYSSTYP, val_styp });
+            scope.variables.insert({ system_ids_.SYSSTYP, val_styp });
         }
 
         {
-            auto SYSLOC = ids().add("SYSLOC");
+            auto var = std::make_shared<set_symbol<C_t>>(system_ids_.SYSLOC, true, false);
 
-            auto var = std::make_shared<set_symbol<C_t>>(SYSLOC, true, false);
-
-            if (ord_ctx.current_section())
+            if (seed.loctr)
             {
-                var->set_value(*ord_ctx.current_section()->current_location_counter().name);
+                var->set_value(*seed.loctr);
             }
-            curr_scope()->variables.insert({ SYSLOC, var });
+            scope.variables.insert({ system_ids_.SYSLOC, var });
         }
 
         {
-            auto SYSNEST = ids().add("SYSNEST");
-
-            auto var = std::make_shared<set_symbol<A_t>>(SYSNEST, true, false);
+            auto var = std::make_shared<set_symbol<A_t>>(system_ids_.SYSNEST, true, false);
 
-            var->set_value((context::A_t)scope_stack_.size() - 1);
+            var->set_value((context::A_t)seed.nest);
 
-            curr_scope()->variables.insert({ SYSNEST, var });
+            scope.variables.insert({ system_ids_.SYSNEST, var });
         }
 
         {
-            auto SYSMAC = ids().add("SYSMAC");
-
             std::vector<macro_data_ptr> data;
 
-            for (auto it = scope_stack_.rbegin(); it != scope_stack_.rend(); ++it)
+            // the scopes below the macro do not change while it is being processed
+            for (size_t i = seed.nest + 1; i-- > 0;)
             {
                 std::string tmp;
-                if (it->is_in_macro())
-                    tmp = *it->this_macro->id;
+                if (scope_stack_[i].is_in_macro())
+                    tmp = *scope_stack_[i].this_macro->id;
                 else
                     tmp = "OPEN CODE";
                 data.push_back(std::make_unique<macro_param_data_single>(std::move(tmp)));
@@ -147,30 +196,55 @@ void hlasm_context::add_system_vars_to_scope()
 
             macro_data_ptr mac_data = std::make_unique<macro_param_data_composite>(std::move(data));
 
-            auto var = std::make_shared<system_variable>(SYSMAC, std::move(mac_data), false);
+            auto var = std::make_shared<system_variable>(system_ids_.SYSMAC, std::move(mac_data), false);
 
-            curr_scope()->system_variables.insert({ SYSMAC, var });
+            scope.system_variables.insert({ system_ids_.SYSMAC, var });
         }
+
+        add_global_system_vars(scope);
     }
-    add_global_system_vars();
 }
 
-void hlasm_context::add_global_system_vars()
+void hlasm_context::add_system_vars_on_access(id_index name)
+{
+    auto scope = curr_scope();
+    if (!scope->pending_system_variables)
+        return;
+
+    // all the system variables are named SYS..., the other names are rejected by the first characters
+    if (name->size() < 6 || name->compare(0, 3, "SYS") != 0)
+        return;
+
+    if (name == system_ids_.SYSECT || name == system_ids_.SYSNDX || name == system_ids_.SYSSTYP
+        || name == system_ids_.SYSLOC || name == system_ids_.SYSNEST || name == system_ids_.SYSMAC
+        || name == system_ids_.SYSDATC || name == system_ids_.SYSDATE || name == system_ids_.SYSTIME
+        || name == system_ids_.SYSPARM || name == system_ids_.SYSOPT_RENT)
+        add_system_vars_to_scope(*scope);
+}
+
+void hlasm_context::add_global_system_vars(code_scope& scope)
 {
-    auto SYSDATC = ids().add("SYSDATC");
-    auto SYSDATE = ids().add("SYSDATE");
-    auto SYSTIME = ids().add("SYSTIME");
-    auto SYSPARM = ids().add("SYSPARM");
-    auto SYSOPT_RENT = ids().add("SYSOPT_RENT");
+    auto SYSDATC = system_ids_.SYSDATC;
+    auto SYSDATE = system_ids_.SYSDATE;
+    auto SYSTIME = system_ids_.SYSTIME;
+    auto SYSPARM = system_ids_.SYSPARM;
+    auto SYSOPT_RENT = system_ids_.SYSOPT_RENT;
 
-    if (!is_in_macro())
+    if (!scope.is_in_macro())
     {
         auto datc = std::make_shared<set_symbol<C_t>>(SYSDATC, true, true);
         auto date = std::make_shared<set_symbol<C_t>>(SYSDATE, true, true);
         auto time = std::make_shared<set_symbol<C_t>>(SYSTIME, true, true);
 
         auto tmp_now = std::time(0);
-        auto now = std::localtime(&tmp_now);
+        std::tm now_tm;
+        {
+            // std::localtime returns a pointer to shared static storage
+            static std::mutex localtime_mutex;
+            std::lock_guard guard(localtime_mutex);
+            now_tm = *std::localtime(&tmp_now);
+        }
+        auto now = &now_tm;
 
         std::string datc_val;
         std::string date_val;
@@ -235,33 +309,45 @@ void hlasm_context::add_global_system_vars()
     }
 
     auto glob = globals_.find(SYSDATC);
-    curr_scope()->variables.insert({ glob->second->id, glob->second });
+    scope.variables.insert({ glob->second->id, glob->second });
     glob = globals_.find(SYSDATE);
-    curr_scope()->variables.insert({ glob->second->id, glob->second });
+    scope.variables.insert({ glob->second->id, glob->second });
     glob = globals_.find(SYSTIME);
-    curr_scope()->variables.insert({ glob->second->id, glob->second });
+    scope.variables.insert({ glob->second->id, glob->second });
     glob = globals_.find(SYSPARM);
-    curr_scope()->variables.insert({ glob->second->id, glob->second });
+    scope.variables.insert({ glob->second->id, glob->second });
     glob = globals_.find(SYSOPT_RENT);
-    curr_scope()->variables.insert({ glob->second->id, glob->second });
+    scope.variables.insert({ glob->second->id, glob->second });
 }
 
 bool hlasm_context::is_opcode(id_index symbol) const
 {
-    return macros_.find(symbol) != macros_.end() || instruction_map_.find(symbol) != instruction_map_.end();
+    return macros_.find(symbol) != macros_.end() || find_instruction(symbol);
 }
 
-hlasm_context::hlasm_context(std::string file_name, asm_option asm_options)
-    : opencode_file_name_(file_name)
+hlasm_context::hlasm_context(std::string file_name, asm_option asm_options, std::shared_ptr<id_storage> init_ids)
+    : ids_(std::move(init_ids))
+    , opencode_file_name_(file_name)
     , asm_options_(std::move(asm_options))
-    , instruction_map_(init_instruction_map())
     , SYSNDX_(0)
-    , ord_ctx(ids_)
+    , system_ids_ { ids_->add("SYSLIST"),
+        ids_->add("SYSECT"),
+        ids_->add("SYSNDX"),
+        ids_->add("SYSSTYP"),
+        ids_->add("SYSLOC"),
+        ids_->add("SYSNEST"),
+        ids_->add("SYSMAC"),
+        ids_->add("SYSDATC"),
+        ids_->add("SYSDATE"),
+        ids_->add("SYSTIME"),
+        ids_->add("SYSPARM"),
+        ids_->add("SYSOPT_RENT") }
+    , ord_ctx(*ids_)
 {
     scope_stack_.emplace_back();
     visited_files_.insert(file_name);
     push_statement_processing(processing::processing_kind::ORDINARY, std::move(file_name));
-    add_global_system_vars();
+    add_global_system_vars(scope_stack_.front());
 }
 
 void hlasm_context::set_source_position(position pos) { source_stack_.back().current_instruction.pos = pos; }
@@ -333,9 +419,11 @@ void hlasm_context::pop_statement_processing()
     proc_stack_.pop_back();
 }
 
-id_storage& hlasm_context::ids() { return ids_; }
+id_storage& hlasm_context::ids() { return *ids_; }
+
+std::shared_ptr<id_storage> hlasm_context::ids_ptr() { return ids_; }
 
-const hlasm_context::instruction_storage& hlasm_context::instruction_map() const { return instruction_map_; }
+const std::shared_ptr<statement_arena>& hlasm_context::statement_memory() const { return statement_memory_; }
 
 processing_stack_t hlasm_context::processing_stack() const
 {
@@ -423,6 +511,8 @@ const code_scope::set_sym_storage& hlasm_context::globals() const { return globa
 
 var_sym_ptr hlasm_context::get_var_sym(id_index name)
 {
+    add_system_vars_on_access(name);
+
     auto tmp = curr_scope()->variables.find(name);
     if (tmp != curr_scope()->variables.end())
         return tmp->second;
@@ -433,14 +523,20 @@ var_sym_ptr hlasm_context::get_var_sym(id_index name)
 
     if (curr_scope()->is_in_macro())
     {
-        auto m_tmp = curr_scope()->this_macro->named_params.find(name);
-        if (m_tmp != curr_scope()->this_macro->named_params.end())
-            return m_tmp->second;
+        // the parameter shares the ownership of the invocation it is stored in
+        if (auto param = curr_scope()->this_macro->find_param(name))
+            return var_sym_ptr(curr_scope()->this_macro, param);
     }
 
     return var_sym_ptr();
 }
 
+void hlasm_context::create_system_variables()
+{
+    for (auto& scope : scope_stack_)
+        add_system_vars_to_scope(scope);
+}
+
 void hlasm_context::add_sequence_symbol(sequence_symbol_ptr seq_sym)
 {
     auto& opencode = scope_stack_.front();
@@ -502,8 +598,8 @@ void hlasm_context::add_mnemonic(id_index mnemo, id_index op_code)
 
         if (auto mac_it = macros_.find(op_code); mac_it != macros_.end())
             value.opcode_detail = mac_it->second;
-        else if (auto instr_it = instruction_map_.find(op_code); instr_it != instruction_map_.end())
-            value.opcode_detail = instr_it->second;
+        else if (auto instr = find_instruction(op_code))
+            value.opcode_detail = *instr;
         else
             throw std::invalid_argument("undefined operation code");
 
@@ -519,6 +615,19 @@ void hlasm_context::remove_mnemonic(id_index mnemo)
         throw std::invalid_argument("undefined operation code");
 }
 
+std::vector<std::pair<id_index, id_index>> hlasm_context::get_opsyn_state() const
+{
+    std::vector<std::pair<id_index, id_index>> result;
+    result.reserve(opcode_mnemo_.size());
+
+    for (const auto& [mnemo, opcode] : opcode_mnemo_)
+        result.emplace_back(mnemo, opcode.opcode);
+
+    std::sort(result.begin(), result.end());
+
+    return result;
+}
+
 opcode_t hlasm_context::get_operation_code(id_index symbol) const
 {
     if (auto it = opcode_mnemo_.find(symbol); it != opcode_mnemo_.end())
@@ -528,8 +637,8 @@ opcode_t hlasm_context::get_operation_code(id_index symbol) const
 
     if (auto mac_it = macros_.find(symbol); mac_it != macros_.end())
         value = opcode_t { symbol, mac_it->second };
-    else if (auto instr_it = instruction_map_.find(symbol); instr_it != instruction_map_.end())
-        value = opcode_t { symbol, instr_it->second };
+    else if (auto instr = find_instruction(symbol))
+        value = opcode_t { symbol, *instr };
 
     return value;
 }
@@ -622,7 +731,7 @@ C_t hlasm_context::get_type_attr(var_sym_ptr var_symbol, const std::vector<size_
     if (res)
         return "N";
 
-    id_index symbol_name = ids_.add(std::move(value));
+    id_index symbol_name = ids_->add(std::move(value));
     auto tmp_symbol = ord_ctx.get_symbol(symbol_name);
 
     if (tmp_symbol)
@@ -646,18 +755,13 @@ struct opcode_attr_visitor
 
 C_t hlasm_context::get_opcode_attr(id_index symbol)
 {
-    auto it = instruction_map_.find(symbol);
-
     auto mac_it = macros_.find(symbol);
 
     if (mac_it != macros_.end())
         return "M";
 
-    if (it != instruction_map_.end())
-    {
-        auto& [opcode, detail] = *it;
-        return std::visit(opcode_attr_visitor(), detail);
-    }
+    if (auto instr = find_instruction(symbol))
+        return std::visit(opcode_attr_visitor(), *instr);
 
     return "U";
 }
@@ -682,6 +786,12 @@ macro_def_ptr hlasm_context::add_macro(id_index name,
         .first->second;
 }
 
+void hlasm_context::add_macro(macro_def_ptr macro)
+{
+    auto name = macro->id;
+    macros_.insert_or_assign(name, std::move(macro));
+}
+
 const hlasm_context::macro_storage& hlasm_context::macros() const { return macros_; }
 
 macro_def_ptr hlasm_context::get_macro_definition(id_index name) const
@@ -707,9 +817,13 @@ macro_invo_ptr hlasm_context::enter_macro(id_index name, macro_data_ptr label_pa
     macro_def_ptr macro_def = get_macro_definition(name);
     assert(macro_def);
 
-    auto invo((macro_def->call(std::move(label_param_data), std::move(params), ids().add("SYSLIST"))));
+    auto invo((macro_def->call(std::move(label_param_data), std::move(params), system_ids_.SYSLIST)));
     scope_stack_.emplace_back(invo, macro_def);
-    add_system_vars_to_scope();
+
+    const auto sect = ord_ctx.current_section();
+    curr_scope()->pending_system_variables = code_scope::system_variable_seed {
+        sect, sect ? sect->current_location_counter().name : nullptr, SYSNDX_, scope_stack_.size() - 1
+    };
 
     visited_files_.insert(macro_def->definition_location.file);
 
@@ -730,6 +844,8 @@ const std::string& hlasm_context::opencode_file_name() const { return opencode_f
 
 const std::set<std::string>& hlasm_context::get_visited_files() { return visited_files_; }
 
+const asm_option& hlasm_context::get_asm_options() const { return asm_options_; }
+
 copy_member_ptr hlasm_context::add_copy_member(
     id_index member, statement_block definition, location definition_location)
 {
@@ -741,6 +857,13 @@ copy_member_ptr hlasm_context::add_copy_member(
     return copydef;
 }
 
+void hlasm_context::add_copy_member(copy_member_ptr member)
+{
+    visited_files_.insert(member->definition_location.file);
+    auto name = member->name;
+    copy_members_.try_emplace(name, std::move(member));
+}
+
 void hlasm_context::enter_copy_member(id_index member_name)
 {
     auto tmp = copy_members_.find(member_name);
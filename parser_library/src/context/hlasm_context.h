@@ -25,6 +25,7 @@
 #include "operation_code.h"
 #include "ordinary_assembly/ordinary_assembly_context.h"
 #include "processing_context.h"
+#include "statement_arena.h"
 
 
 namespace hlasm_plugin::parser_library::context {
@@ -40,9 +41,11 @@ class hlasm_context
 {
     using macro_storage = std::unordered_map<id_index, macro_def_ptr>;
     using copy_member_storage = std::unordered_map<id_index, copy_member_ptr>;
-    using instruction_storage = std::unordered_map<id_index, opcode_t::opcode_variant>;
     using opcode_map = std::unordered_map<id_index, opcode_t>;
 
+    // memory of the statements parsed in the context, declared first so that it outlives the objects it holds,
+    // the statements themselves keep it alive
+    std::shared_ptr<statement_arena> statement_memory_ = std::make_shared<statement_arena>();
     // storage of global variables
     code_scope::set_sym_storage globals_;
     // storage of defined macros
@@ -52,7 +55,7 @@ class hlasm_context
     // map of OPSYN mnemonics
     opcode_map opcode_mnemo_;
     // storage of identifiers
-    id_storage ids_;
+    std::shared_ptr<id_storage> ids_;
 
     // stack of nested scopes
     std::deque<code_scope> scope_stack_;
@@ -73,24 +76,43 @@ class hlasm_context
     // Compiler options
     asm_option asm_options_;
 
-    // map of all instruction in HLASM
-    const instruction_storage instruction_map_;
-    instruction_storage init_instruction_map();
-
     // value of system variable SYSNDX
     size_t SYSNDX_;
-    void add_system_vars_to_scope();
-    void add_global_system_vars();
+    // names of the system variables, added to the identifier storage once
+    struct system_variable_ids
+    {
+        id_index SYSLIST;
+        id_index SYSECT;
+        id_index SYSNDX;
+        id_index SYSSTYP;
+        id_index SYSLOC;
+        id_index SYSNEST;
+        id_index SYSMAC;
+        id_index SYSDATC;
+        id_index SYSDATE;
+        id_index SYSTIME;
+        id_index SYSPARM;
+        id_index SYSOPT_RENT;
+    };
+    system_variable_ids system_ids_;
+    void add_system_vars_to_scope(code_scope& scope);
+    void add_global_system_vars(code_scope& scope);
+    // creates the pending system variables of the current scope when the name is one of them
+    void add_system_vars_on_access(id_index name);
 
     bool is_opcode(id_index symbol) const;
 
 public:
-    hlasm_context(std::string file_name = "", asm_option asm_opts = {});
+    hlasm_context(std::string file_name = "",
+        asm_option asm_opts = {},
+        std::shared_ptr<id_storage> init_ids = std::make_shared<id_storage>());
 
     // gets name of file where is open-code located
     const std::string& opencode_file_name() const;
     // accesses visited files
     const std::set<std::string>& get_visited_files();
+    // gets assembler options the context was created with
+    const asm_option& get_asm_options() const;
 
     // gets current source
     const source_context& current_source() const;
@@ -126,9 +148,13 @@ public:
 
     // index storage
     id_storage& ids();
+    std::shared_ptr<id_storage> ids_ptr();
+
+    // memory for the open code statements
+    const std::shared_ptr<statement_arena>& statement_memory() const;
 
-    // map of instructions
-    const instruction_storage& instruction_map() const;
+    // finds the instruction in the table of all HLASM instructions, which is built once for all the contexts
+    static const opcode_t::opcode_variant* find_instruction(id_index symbol);
 
     // field that accessed ordinary assembly context
     ordinary_assembly_context ord_ctx;
@@ -143,6 +169,8 @@ public:
     // return variable symbol in current scope
     // returns empty shared_ptr if there is none in the current scope
     var_sym_ptr get_var_sym(id_index name);
+    // creates the system variables of all the scopes that have not been accessed yet
+    void create_system_variables();
 
     // registers sequence symbol
     void add_sequence_symbol(sequence_symbol_ptr seq_sym);
@@ -161,6 +189,8 @@ public:
     void add_mnemonic(id_index mnemo, id_index op_code);
     // removes opsyn mnemonic
     void remove_mnemonic(id_index mnemo);
+    // gets current opsyn mnemonics as pairs of mnemonic and operation code, sorted by mnemonic
+    std::vector<std::pair<id_index, id_index>> get_opsyn_state() const;
 
     // checks wheter the symbol is an operation code (is a valid instruction or a mnemonic)
     opcode_t get_operation_code(id_index symbol) const;
@@ -189,6 +219,8 @@ public:
         copy_nest_storage copy_nests,
         label_storage labels,
         location definition_location);
+    // registers already constructed macro (e.g. shared from a macro cache)
+    void add_macro(macro_def_ptr macro);
     // enters a macro with actual params
     macro_invo_ptr enter_macro(id_index name, macro_data_ptr label_param_data, std::vector<macro_arg> params);
     // leaves current macro
@@ -198,6 +230,8 @@ public:
     const copy_member_storage& copy_members();
     // registers new copy member
     copy_member_ptr add_copy_member(id_index member, statement_block definition, location definition_location);
+    // registers already constructed copy member (e.g. shared from a macro cache)
+    void add_copy_member(copy_member_ptr member);
     // enters a copy member
     void enter_copy_member(id_index member);
     // leaves current copy member
@@ -207,6 +241,8 @@ public:
     template<typename T>
     set_sym_ptr create_global_variable(id_index id, bool is_scalar)
     {
+        add_system_vars_on_access(id);
+
         auto tmp = curr_scope()->variables.find(id);
         if (tmp != curr_scope()->variables.end())
             return tmp->second;
@@ -230,6 +266,8 @@ public:
     template<typename T>
     set_sym_ptr create_local_variable(id_index id, bool is_scalar)
     {
+        add_system_vars_on_access(id);
+
         auto tmp = curr_scope()->variables.find(id);
         if (tmp != curr_scope()->variables.end())
             return tmp->second;
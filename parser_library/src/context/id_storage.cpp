@@ -14,61 +14,148 @@
 
 #include "id_storage.h"
 
-#include "common_types.h"
+#include <cstdint>
+#include <cstring>
 
 using namespace hlasm_plugin::parser_library::context;
 
+namespace {
+constexpr size_t initial_slots = 256;
+
+char upper_char(char c) { return c >= 'a' && c <= 'z' ? static_cast<char>(c - ('a' - 'A')) : c; }
+
+// FNV-1a of the stored form of the identifier
+size_t hash_id(std::string_view value, bool upper)
+{
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (char c : value)
+    {
+        hash ^= (unsigned char)(upper ? upper_char(c) : c);
+        hash *= 0x100000001b3ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+bool equal_id(const std::string& stored, std::string_view value, bool upper)
+{
+    if (stored.size() != value.size())
+        return false;
+    if (!upper)
+        return std::memcmp(stored.data(), value.data(), value.size()) == 0;
+    for (size_t i = 0; i < value.size(); ++i)
+        if (stored[i] != upper_char(value[i]))
+            return false;
+    return true;
+}
+} // namespace
+
 const std::string id_storage::empty_string_("");
 
 const id_storage::const_pointer id_storage::empty_id = &id_storage::empty_string_;
 
 hlasm_plugin::parser_library::context::id_storage::id_storage()
-    : well_known(lit_)
+    : slots_(initial_slots)
+    , well_known(*this)
 {}
 
-size_t id_storage::size() const { return lit_.size(); }
+size_t id_storage::size() const
+{
+    std::lock_guard guard(mutex_);
+    return strings_.size();
+}
 
-id_storage::const_iterator id_storage::begin() const { return lit_.begin(); }
+bool id_storage::empty() const
+{
+    std::lock_guard guard(mutex_);
+    return strings_.empty();
+}
 
-id_storage::const_iterator id_storage::end() const { return lit_.end(); }
+const std::string* id_storage::lookup(std::string_view value, bool upper, size_t hash) const
+{
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask)
+    {
+        const auto& s = slots_[i];
+        if (!s.value)
+            return nullptr;
+        if (s.hash == hash && equal_id(*s.value, value, upper))
+            return s.value;
+    }
+}
 
-bool id_storage::empty() const { return lit_.empty(); }
+const std::string* id_storage::insert(std::string_view value, bool upper)
+{
+    const size_t hash = hash_id(value, upper);
+    if (auto found = lookup(value, upper, hash))
+        return found;
+
+    if (2 * (used_slots_ + 1) > slots_.size())
+        grow();
+
+    auto& stored = strings_.emplace_back(value);
+    if (upper)
+        for (auto& c : stored)
+            c = upper_char(c);
+
+    const size_t mask = slots_.size() - 1;
+    size_t i = hash & mask;
+    while (slots_[i].value)
+        i = (i + 1) & mask;
+    slots_[i] = { hash, &stored };
+    ++used_slots_;
+
+    return &stored;
+}
 
-id_storage::const_pointer id_storage::find(std::string val) const
+void id_storage::grow()
 {
-    to_upper(val);
+    std::vector<slot> slots(2 * slots_.size());
+    const size_t mask = slots.size() - 1;
+    for (const auto& s : slots_)
+    {
+        if (!s.value)
+            continue;
+        size_t i = s.hash & mask;
+        while (slots[i].value)
+            i = (i + 1) & mask;
+        slots[i] = s;
+    }
+    slots_.swap(slots);
+}
 
+id_storage::const_pointer id_storage::find(std::string_view val) const
+{
     if (val.empty())
         return empty_id;
 
-    const_iterator tmp = lit_.find(val);
+    const size_t hash = hash_id(val, true);
 
-    return tmp == lit_.end() ? nullptr : &*tmp;
+    std::lock_guard guard(mutex_);
+    return lookup(val, true, hash);
 }
 
-id_storage::const_pointer id_storage::add(std::string value, bool is_uri)
+id_storage::const_pointer id_storage::add(std::string_view value, bool is_uri)
 {
     if (value.empty())
         return empty_id;
-    if (!is_uri)
-        to_upper(value);
-    return &*lit_.insert(std::move(value)).first;
+
+    std::lock_guard guard(mutex_);
+    return insert(value, !is_uri);
 }
 
-hlasm_plugin::parser_library::context::id_storage::well_known_strings::well_known_strings(
-    std::unordered_set<std::string>& ptr)
-    : COPY(&*ptr.emplace("COPY").first)
-    , SETA(&*ptr.emplace("SETA").first)
-    , SETB(&*ptr.emplace("SETB").first)
-    , SETC(&*ptr.emplace("SETC").first)
-    , GBLA(&*ptr.emplace("GBLA").first)
-    , GBLB(&*ptr.emplace("GBLB").first)
-    , GBLC(&*ptr.emplace("GBLC").first)
-    , LCLA(&*ptr.emplace("LCLA").first)
-    , LCLB(&*ptr.emplace("LCLB").first)
-    , LCLC(&*ptr.emplace("LCLC").first)
-    , MACRO(&*ptr.emplace("MACRO").first)
-    , MEND(&*ptr.emplace("MEND").first)
-    , ASPACE(&*ptr.emplace("ASPACE").first)
-    , empty(&*ptr.emplace("").first)
+hlasm_plugin::parser_library::context::id_storage::well_known_strings::well_known_strings(id_storage& storage)
+    : COPY(storage.insert("COPY", false))
+    , SETA(storage.insert("SETA", false))
+    , SETB(storage.insert("SETB", false))
+    , SETC(storage.insert("SETC", false))
+    , GBLA(storage.insert("GBLA", false))
+    , GBLB(storage.insert("GBLB", false))
+    , GBLC(storage.insert("GBLC", false))
+    , LCLA(storage.insert("LCLA", false))
+    , LCLB(storage.insert("LCLB", false))
+    , LCLC(storage.insert("LCLC", false))
+    , MACRO(storage.insert("MACRO", false))
+    , MEND(storage.insert("MEND", false))
+    , ASPACE(storage.insert("ASPACE", false))
+    , empty(storage.insert("", false))
 {}
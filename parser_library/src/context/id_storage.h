@@ -15,36 +15,53 @@
 #ifndef CONTEXT_LITERAL_STORAGE_H
 #define CONTEXT_LITERAL_STORAGE_H
 
+#include <deque>
+#include <mutex>
 #include <string>
-#include <unordered_set>
+#include <string_view>
+#include <vector>
 
 namespace hlasm_plugin::parser_library::context {
 
 
 // storage for identifiers
 // changes strings of identifiers to indexes of this storage class for easier and unified work
+// find and add may be called concurrently, as the storage can be shared by analyses running in parallel
 class id_storage
 {
 private:
-    std::unordered_set<std::string> lit_;
+    struct slot
+    {
+        size_t hash = 0;
+        const std::string* value = nullptr;
+    };
+
+    // the strings are never moved, so the indexes stay valid for the lifetime of the storage
+    std::deque<std::string> strings_;
+    // open addressing table with linear probing, never more than half full
+    std::vector<slot> slots_;
+    size_t used_slots_ = 0;
+    mutable std::mutex mutex_;
     static const std::string empty_string_;
 
+    // identifiers are compared and hashed upper-cased without making an upper-cased copy first
+    const std::string* lookup(std::string_view value, bool upper, size_t hash) const;
+    const std::string* insert(std::string_view value, bool upper);
+    void grow();
+
 public:
     id_storage();
     using const_pointer = const std::string*;
-    using const_iterator = typename std::unordered_set<std::string>::const_iterator;
 
     // represents value of empty identifier
     static const const_pointer empty_id;
 
     size_t size() const;
-    const_iterator begin() const;
-    const_iterator end() const;
     bool empty() const;
 
-    const_pointer find(std::string val) const;
+    const_pointer find(std::string_view val) const;
 
-    const_pointer add(std::string value, bool is_uri = false);
+    const_pointer add(std::string_view value, bool is_uri = false);
 
     struct well_known_strings
     {
@@ -62,7 +79,7 @@ public:
         const std::string* MEND;
         const std::string* ASPACE;
         const std::string* empty;
-        well_known_strings(std::unordered_set<std::string>& ptr);
+        well_known_strings(id_storage& storage);
 
     } const well_known;
 };
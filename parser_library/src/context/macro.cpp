@@ -36,7 +36,8 @@ macro_definition::macro_definition(id_index name,
     copy_nest_storage copy_nests,
     label_storage labels,
     location definition_location)
-    : label_param_name_(label_param_name)
+    : named_positional_count_(0)
+    , label_param_name_(label_param_name)
     , id(name)
     , copy_nests(std::move(copy_nests))
     , labels(std::move(labels))
@@ -49,6 +50,7 @@ macro_definition::macro_definition(id_index name,
     {
         auto tmp = std::make_unique<positional_param>(label_param_name, 0, *macro_param_data_component::dummy);
         named_params_.emplace(label_param_name, &*tmp);
+        param_layout_.emplace(label_param_name, macro_param_slot { false, named_positional_count_++ });
         positional_params_.push_back(std::move(tmp));
     }
     else
@@ -66,6 +68,7 @@ macro_definition::macro_definition(id_index name,
 
             auto tmp = std::make_unique<keyword_param>(it->id, move(it->data), nullptr);
             named_params_.emplace(it->id, &*tmp);
+            param_layout_.emplace(it->id, macro_param_slot { true, keyword_params_.size() });
             keyword_params_.push_back(std::move(tmp));
         }
         else
@@ -74,6 +77,7 @@ macro_definition::macro_definition(id_index name,
             {
                 auto tmp = std::make_unique<positional_param>(it->id, idx, *macro_param_data_component::dummy);
                 named_params_.emplace(it->id, &*tmp);
+                param_layout_.emplace(it->id, macro_param_slot { false, named_positional_count_++ });
                 positional_params_.push_back(std::move(tmp));
             }
             else
@@ -89,69 +93,62 @@ macro_invo_ptr macro_definition::call(
     macro_data_ptr label_param_data, std::vector<macro_arg> actual_params, id_index syslist_name)
 {
     std::vector<macro_data_ptr> syslist;
-    std::unordered_map<id_index, macro_param_ptr> named_cpy;
+    std::vector<macro_data_ptr> keyword_data(keyword_params_.size());
+    std::vector<bool> keyword_assigned(keyword_params_.size());
 
     if (label_param_data)
         syslist.push_back(std::move(label_param_data));
     else
         syslist.push_back(std::make_unique<macro_param_data_dummy>());
 
-    if (positional_params_[0])
-    {
-        named_cpy.emplace(positional_params_[0]->id,
-            std::make_unique<positional_param>(positional_params_[0]->id, 0, *syslist.back()));
-    }
-
     for (auto&& param : actual_params)
     {
         if (param.id)
         {
-            auto tmp = named_params_.find(param.id);
+            auto slot = param_layout_.find(param.id);
 
-            if (tmp == named_params_.end() || tmp->second->param_type == macro_param_type::POS_PAR_TYPE)
+            if (slot == param_layout_.end() || !slot->second.keyword)
                 throw std::invalid_argument("use of undefined keyword parameter");
 
-            const auto& key_par = dynamic_cast<const keyword_param&>(*tmp->second);
-            named_cpy.emplace(
-                param.id, std::make_unique<keyword_param>(param.id, key_par.default_data, std::move(param.data)));
-        }
-        else
-        {
-            if (positional_params_.size() > syslist.size() && positional_params_[syslist.size()])
+            // the first occurrence of the keyword is used
+            if (!keyword_assigned[slot->second.index])
             {
-                named_cpy.emplace(positional_params_[syslist.size()]->id,
-                    std::make_unique<positional_param>(positional_params_[syslist.size()]->id,
-                        positional_params_[syslist.size()]->position,
-                        *param.data));
+                keyword_assigned[slot->second.index] = true;
+                keyword_data[slot->second.index] = std::move(param.data);
             }
-            syslist.push_back(move(param.data));
         }
+        else
+            syslist.push_back(move(param.data));
     }
 
-    for (size_t i = syslist.size(); i < positional_params_.size(); ++i)
+    // the parameters refer to the data owned by SYSLIST
+    std::vector<positional_param> positional;
+    positional.reserve(named_positional_count_);
+    for (size_t i = 0; i < positional_params_.size(); ++i)
     {
         if (positional_params_[i])
         {
-            named_cpy.emplace(positional_params_[i]->id,
-                std::make_unique<positional_param>(
-                    positional_params_[i]->id, positional_params_[i]->position, *macro_param_data_component::dummy));
-        }
-    }
-    for (auto&& key_par : keyword_params_)
-    {
-        if (named_cpy.find(key_par->id) == named_cpy.end())
-        {
-            named_cpy.emplace(
-                key_par->id, std::make_unique<keyword_param>(key_par->id, key_par->default_data, nullptr));
+            positional.emplace_back(positional_params_[i]->id,
+                positional_params_[i]->position,
+                i < syslist.size() ? *syslist[i] : *macro_param_data_component::dummy);
         }
     }
 
-    named_cpy.emplace(syslist_name,
-        std::make_unique<system_variable>(
-            syslist_name, std::make_unique<macro_param_data_composite>(std::move(syslist)), false));
-
-    return std::make_shared<macro_invocation>(
-        id, cached_definition, copy_nests, labels, std::move(named_cpy), definition_location);
+    std::vector<keyword_param> keyword;
+    keyword.reserve(keyword_params_.size());
+    for (size_t i = 0; i < keyword_params_.size(); ++i)
+        keyword.emplace_back(keyword_params_[i]->id, keyword_params_[i]->default_data, std::move(keyword_data[i]));
+
+    return std::make_shared<macro_invocation>(id,
+        cached_definition,
+        copy_nests,
+        labels,
+        param_layout_,
+        std::move(positional),
+        std::move(keyword),
+        syslist_name,
+        std::make_unique<macro_param_data_composite>(std::move(syslist)),
+        definition_location);
 }
 
 bool macro_definition::operator=(const macro_definition& m) { return id == m.id; }
@@ -168,17 +165,49 @@ const std::vector<std::unique_ptr<keyword_param>>& macro_definition::get_keyword
 
 const id_index& macro_definition::get_label_param_name() const { return label_param_name_; }
 
+bool macro_definition::defined_in_single_file() const
+{
+    for (const auto& nest : copy_nests)
+    {
+        for (const auto& loc : nest)
+            if (loc.file != definition_location.file)
+                return false;
+    }
+    return true;
+}
+
 macro_invocation::macro_invocation(id_index name,
     cached_block& cached_definition,
     const copy_nest_storage& copy_nests,
     const label_storage& labels,
-    std::unordered_map<id_index, macro_param_ptr> named_params,
+    const macro_param_layout& param_layout,
+    std::vector<positional_param> positional_params,
+    std::vector<keyword_param> keyword_params,
+    id_index syslist_name,
+    macro_data_ptr syslist_data,
     const location& definition_location)
-    : id(name)
-    , named_params(std::move(named_params))
+    : param_layout_(param_layout)
+    , id(name)
+    , positional_params(std::move(positional_params))
+    , keyword_params(std::move(keyword_params))
+    , syslist(syslist_name, std::move(syslist_data), false)
     , cached_definition(cached_definition)
     , copy_nests(copy_nests)
     , labels(labels)
     , definition_location(definition_location)
     , current_statement(-1)
 {}
+
+macro_param_base* macro_invocation::find_param(id_index name)
+{
+    if (name == syslist.id)
+        return &syslist;
+
+    auto slot = param_layout_.find(name);
+    if (slot == param_layout_.end())
+        return nullptr;
+
+    if (slot->second.keyword)
+        return &keyword_params[slot->second.index];
+    return &positional_params[slot->second.index];
+}
@@ -22,6 +22,7 @@
 #include "sequence_symbol.h"
 #include "statement_cache.h"
 #include "variables/macro_param.h"
+#include "variables/system_variable.h"
 
 namespace hlasm_plugin::parser_library::context {
 
@@ -48,6 +49,14 @@ using macro_def_ptr = std::shared_ptr<macro_definition>;
 using label_storage = std::unordered_map<id_index, sequence_symbol_ptr>;
 using copy_nest_storage = std::vector<std::vector<location>>;
 
+// position of a parameter in the parameters of macro_invocation
+struct macro_param_slot
+{
+    bool keyword;
+    size_t index;
+};
+using macro_param_layout = std::unordered_map<id_index, macro_param_slot>;
+
 // class representing macro definition
 // contains info about keyword, positional parameters of HLASM macro as well as list of statements
 // has the 'call' method to represent macro instruction call
@@ -59,6 +68,9 @@ class macro_definition
     std::vector<std::unique_ptr<positional_param>> positional_params_;
     std::vector<std::unique_ptr<keyword_param>> keyword_params_;
     std::unordered_map<id_index, const macro_param_base*> named_params_;
+    // where the parameters are stored in each invocation, computed once with the definition
+    macro_param_layout param_layout_;
+    size_t named_positional_count_;
     const id_index label_param_name_;
 
 public:
@@ -92,17 +104,27 @@ public:
     const std::vector<std::unique_ptr<positional_param>>& get_positional_params() const;
     const std::vector<std::unique_ptr<keyword_param>>& get_keyword_params() const;
     const id_index& get_label_param_name() const;
+
+    // whether all the statements come from the file of the definition, i.e. none of them from a COPY member
+    bool defined_in_single_file() const;
 };
 
 // represent macro instruction call
 // contains parameters with set values provided with the call
 struct macro_invocation
 {
+private:
+    const macro_param_layout& param_layout_;
+
 public:
     // identifier of macro
     const id_index id;
-    // params of macro
-    const std::unordered_map<id_index, macro_param_ptr> named_params;
+    // params of macro, in the order of their definition
+    // the vectors are filled once, the parameters are referenced by their address
+    std::vector<positional_param> positional_params;
+    std::vector<keyword_param> keyword_params;
+    // the SYSLIST system variable
+    system_variable syslist;
     // vector of statements representing macro definition
     cached_block& cached_definition;
     // vector assigning each statement its copy nest
@@ -118,8 +140,15 @@ public:
         cached_block& cached_definition,
         const copy_nest_storage& copy_nests,
         const label_storage& labels,
-        std::unordered_map<id_index, macro_param_ptr> named_params,
+        const macro_param_layout& param_layout,
+        std::vector<positional_param> positional_params,
+        std::vector<keyword_param> keyword_params,
+        id_index syslist_name,
+        macro_data_ptr syslist_data,
         const location& definition_location);
+
+    // finds the parameter with the name (including SYSLIST), returns nullptr if there is none
+    macro_param_base* find_param(id_index name);
 };
 
 } // namespace hlasm_plugin::parser_library::context
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "statement_arena.h"
+
+#include <algorithm>
+#include <new>
+
+using namespace hlasm_plugin::parser_library::context;
+
+namespace {
+constexpr size_t alignment = alignof(std::max_align_t);
+
+// the objects are preceded by a header telling where their memory comes from
+constexpr size_t object_header_size = alignment;
+enum class object_origin : unsigned char
+{
+    heap,
+    arena,
+};
+} // namespace
+
+void* statement_arena::allocate(size_t size)
+{
+    size = std::max<size_t>((size + alignment - 1) / alignment * alignment, alignment);
+
+    if (size > available_)
+    {
+        // large objects get a chunk of their own, the current one is still used for the following ones
+        if (size > last_chunk_size / 4)
+        {
+            auto& chunk = chunks_.emplace_back(new unsigned char[size]);
+            size_ += size;
+            return chunk.get();
+        }
+
+        chunk_size_ = chunks_.empty() ? first_chunk_size : std::min(2 * chunk_size_, last_chunk_size);
+        // the remainder of the previous chunk is not used
+        next_ = chunks_.emplace_back(new unsigned char[chunk_size_]).get();
+        available_ = chunk_size_;
+        size_ += chunk_size_;
+    }
+
+    void* result = next_;
+    next_ += size;
+    available_ -= size;
+    return result;
+}
+
+void* statement_arena::allocate_object(size_t size, statement_arena* arena)
+{
+    unsigned char* block;
+    object_origin origin;
+    if (arena && !arena->exhausted())
+    {
+        block = static_cast<unsigned char*>(arena->allocate(object_header_size + size));
+        origin = object_origin::arena;
+    }
+    else
+    {
+        block = static_cast<unsigned char*>(::operator new(object_header_size + size));
+        origin = object_origin::heap;
+    }
+    new (block) object_origin(origin);
+    return block + object_header_size;
+}
+
+void statement_arena::release_object(void* p) noexcept
+{
+    if (!p)
+        return;
+    auto block = static_cast<unsigned char*>(p) - object_header_size;
+    if (*reinterpret_cast<object_origin*>(block) == object_origin::heap)
+        ::operator delete(block);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#ifndef CONTEXT_STATEMENT_ARENA_H
+#define CONTEXT_STATEMENT_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hlasm_plugin::parser_library::context {
+
+// Memory for the statements parsed by one analysis, together with their operands and expressions.
+// Nothing is returned before the arena is destroyed, then all the memory is released at once.
+// The statements keep their arena alive, so it outlives the analysis when the checkpoints keep them.
+// Only the thread running the analysis allocates, the objects themselves may be destroyed on any thread.
+class statement_arena
+{
+    // arenas of small library members stay small, the chunks grow with the number of statements
+    static constexpr size_t first_chunk_size = 4 * 1024;
+    static constexpr size_t last_chunk_size = 64 * 1024;
+
+    std::vector<std::unique_ptr<unsigned char[]>> chunks_;
+    unsigned char* next_ = nullptr;
+    size_t available_ = 0;
+    size_t chunk_size_ = 0;
+    size_t size_ = 0;
+
+public:
+    // the released objects are not reused, so the memory of an analysis that parses more,
+    // e.g. a long open code loop, is taken from the general heap, where they are returned
+    static constexpr size_t capacity = 8 * 1024 * 1024;
+
+    statement_arena() = default;
+
+    statement_arena(const statement_arena&) = delete;
+    statement_arena& operator=(const statement_arena&) = delete;
+    statement_arena(statement_arena&&) = delete;
+    statement_arena& operator=(statement_arena&&) = delete;
+
+    // returns storage aligned for any object
+    void* allocate(size_t size);
+    bool exhausted() const { return size_ >= capacity; }
+
+    // operator new and delete of the objects that are owned through std::unique_ptr,
+    // they are taken from the arena unless there is none or it is exhausted
+    static void* allocate_object(size_t size, statement_arena* arena);
+    static void release_object(void* p) noexcept;
+};
+
+// creates the object in the arena, or on the general heap when there is none or it is exhausted,
+// the class provides operator new taking the arena
+template<typename T, typename... Args>
+std::unique_ptr<T> make_arena_unique(statement_arena* arena, Args&&... args)
+{
+    return std::unique_ptr<T>(new (arena) T(std::forward<Args>(args)...));
+}
+
+// allocator for std::allocate_shared, the object keeps the arena alive and its memory is returned with it
+template<typename T>
+class statement_allocator
+{
+    template<typename U>
+    friend class statement_allocator;
+
+    std::shared_ptr<statement_arena> arena_;
+
+public:
+    using value_type = T;
+
+    explicit statement_allocator(std::shared_ptr<statement_arena> arena)
+        : arena_(std::move(arena))
+    {}
+    template<typename U>
+    statement_allocator(const statement_allocator<U>& other)
+        : arena_(other.arena_)
+    {}
+
+    T* allocate(size_t n) { return static_cast<T*>(arena_->allocate(n * sizeof(T))); }
+    void deallocate(T*, size_t) noexcept {}
+
+    template<typename U>
+    bool operator==(const statement_allocator<U>& other) const
+    {
+        return arena_ == other.arena_;
+    }
+    template<typename U>
+    bool operator!=(const statement_allocator<U>& other) const
+    {
+        return arena_ != other.arena_;
+    }
+};
+
+// creates the object in the arena, or on the general heap when there is none or it is exhausted
+template<typename T, typename... Args>
+std::shared_ptr<T> make_arena_shared(const std::shared_ptr<statement_arena>& arena, Args&&... args)
+{
+    if (!arena || arena->exhausted())
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    return std::allocate_shared<T>(statement_allocator<T>(arena), std::forward<Args>(args)...);
+}
+
+} // namespace hlasm_plugin::parser_library::context
+
+#endif
@@ -14,6 +14,8 @@
 
 #include "statement_cache.h"
 
+#include <atomic>
+
 #include "semantics/statement.h"
 
 namespace hlasm_plugin::parser_library::context {
@@ -22,25 +24,16 @@ statement_cache::statement_cache(shared_stmt_ptr base)
     : base_stmt_(std::move(base))
 {}
 
-bool statement_cache::contains(processing::processing_form format) const
-{
-    for (const auto& entry : cache_)
-        if (entry.first == format)
-            return true;
-    return false;
-}
+bool statement_cache::contains(processing::processing_form format) const { return get(format) != nullptr; }
 
 void statement_cache::insert(processing::processing_form format, cached_statement_t statement)
 {
-    cache_.emplace_back(format, std::move(statement));
+    std::atomic_store(&cache_[(size_t)format], std::move(statement));
 }
 
 statement_cache::cached_statement_t statement_cache::get(processing::processing_form format) const
 {
-    for (const auto& entry : cache_)
-        if (entry.first == format)
-            return entry.second;
-    return nullptr;
+    return std::atomic_load(&cache_[(size_t)format]);
 }
 
 shared_stmt_ptr statement_cache::get_base() const { return base_stmt_; }
@@ -15,6 +15,8 @@
 #ifndef CONTEXT_PROCESSING_STATEMENT_CACHE_H
 #define CONTEXT_PROCESSING_STATEMENT_CACHE_H
 
+#include <array>
+
 #include "hlasm_statement.h"
 #include "processing/processing_format.h"
 
@@ -26,17 +28,15 @@ namespace hlasm_plugin::parser_library::context {
 
 // storage used to store one deferred statement in many parsed formats
 // used by macro and copy definition to avoid multiple re-parsing of a deferrend stataments
+// the definitions may be shared by analyses running in parallel, so the reparsed formats are accessed atomically
 class statement_cache
 {
 public:
     using cached_statement_t = std::shared_ptr<semantics::complete_statement>;
 
-    // pair of processing format and reparsed statement
-    // processing format serves as an identifier of reparsing kind
-    using cache_t = std::pair<processing::processing_form, cached_statement_t>;
-
 private:
-    std::vector<cache_t> cache_;
+    // reparsed statements indexed by processing form, which serves as an identifier of reparsing kind
+    std::array<cached_statement_t, (size_t)processing::processing_form::UNKNOWN + 1> cache_;
     shared_stmt_ptr base_stmt_;
 
 public:
@@ -62,7 +62,7 @@ using macro_param_ptr = std::shared_ptr<macro_param_base>;
 // represent macro param with stated position and name, positional param
 class keyword_param : public macro_param_base
 {
-    const macro_data_ptr assigned_data_;
+    macro_data_ptr assigned_data_;
 
 public:
     keyword_param(id_index name, macro_data_shared_ptr default_value, macro_data_ptr assigned_value);
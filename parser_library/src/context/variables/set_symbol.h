@@ -15,7 +15,9 @@
 #ifndef CONTEXT_SET_SYMBOL_H
 #define CONTEXT_SET_SYMBOL_H
 
+#include <algorithm>
 #include <map>
+#include <optional>
 #include <vector>
 
 #include "variable.h"
@@ -63,9 +65,21 @@ class set_symbol : public set_symbol_base
 {
     static_assert(object_traits<T>::type_enum != SET_t_enum::UNDEF_TYPE, "Not a SET variable type.");
 
-    // data holding this set_symbol
-    // can be scalar or only array of scallars - no other nesting allowed
-    std::map<size_t, T> data;
+    // value of scalar set symbol
+    std::optional<T> scalar_data;
+
+    // values of non scalar set symbol, indexed directly by the subscript
+    // it grows on demand as long as it stays reasonably filled
+    std::vector<std::optional<T>> dense_data;
+    size_t dense_count = 0;
+
+    // values with subscripts too far beyond the dense part, all keys are at least dense_data.size()
+    std::map<size_t, T> sparse_data;
+
+    // the dense part may have at most this many empty slots for each value
+    static constexpr size_t dense_ratio = 2;
+    // the dense part may always grow up to this size
+    static constexpr size_t dense_minimum = 64;
 
 public:
     set_symbol(id_index name, bool is_scalar, bool is_global)
@@ -79,73 +93,129 @@ public:
         if (is_scalar)
             return object_traits<T>::default_v();
 
-        auto tmp = data.find(idx);
-        if (tmp == data.end())
+        auto tmp = find(idx);
+        if (!tmp)
             return object_traits<T>::default_v();
-        return tmp->second;
+        return *tmp;
     }
 
     // gets value from scalar set symbol
     const T& get_value() const
     {
-        if (!is_scalar)
-            return object_traits<T>::default_v();
-
-        auto tmp = data.find(0);
-        if (tmp == data.end())
+        if (!is_scalar || !scalar_data)
             return object_traits<T>::default_v();
-        return tmp->second;
+        return *scalar_data;
     }
 
     // sets value to scalar set symbol
-    void set_value(T value) { data.insert_or_assign(0, std::move(value)); }
+    void set_value(T value)
+    {
+        if (is_scalar)
+            scalar_data = std::move(value);
+        else
+            set_element(std::move(value), 0);
+    }
 
     // sets value to non scalar set symbol
     // any index can be accessed
     void set_value(T value, size_t idx)
     {
         if (is_scalar)
-            data.insert_or_assign(0, std::move(value));
+            scalar_data = std::move(value);
         else
-            data.insert_or_assign(idx, std::move(value));
+            set_element(std::move(value), idx);
     }
 
     // N' attribute of the symbol
     A_t number(std::vector<size_t>) const override
     {
-        return (A_t)(is_scalar || data.empty() ? 0 : data.rbegin()->first + 1);
+        if (is_scalar)
+            return 0;
+        // the last slot of the dense part is always set
+        return (A_t)(sparse_data.empty() ? dense_data.size() : sparse_data.rbegin()->first + 1);
     }
 
     // K' attribute of the symbol
     A_t count(std::vector<size_t> offset) const override;
 
-    size_t size() const override { return data.size(); };
+    size_t size() const override
+    {
+        if (is_scalar)
+            return scalar_data ? 1 : 0;
+        return dense_count + sparse_data.size();
+    }
 
     std::vector<size_t> keys() const override
     {
         std::vector<size_t> keys;
-        keys.reserve(data.size());
-        for (auto& [key, value] : data)
+        if (is_scalar)
+        {
+            if (scalar_data)
+                keys.push_back(0);
+            return keys;
+        }
+
+        keys.reserve(size());
+        for (size_t i = 0; i < dense_data.size(); ++i)
+            if (dense_data[i])
+                keys.push_back(i);
+        for (auto& [key, value] : sparse_data)
             keys.push_back(key);
         return keys;
     }
 
 private:
-    const T* get_data(std::vector<size_t> offset) const
+    const T* find(size_t idx) const
     {
-        if ((is_scalar && !offset.empty()) || (!is_scalar && offset.size() != 1))
+        if (idx < dense_data.size())
+            return dense_data[idx] ? &*dense_data[idx] : nullptr;
+
+        auto tmp = sparse_data.find(idx);
+        if (tmp == sparse_data.end())
             return nullptr;
+        return &tmp->second;
+    }
 
-        auto tmp_offs = is_scalar ? 0 : offset.front() - 1;
+    void set_element(T value, size_t idx)
+    {
+        if (idx >= dense_data.size() && idx < std::max(dense_minimum, dense_ratio * (size() + 1)))
+            grow_dense(idx + 1);
+
+        if (idx < dense_data.size())
+        {
+            auto& slot = dense_data[idx];
+            if (!slot)
+                ++dense_count;
+            slot = std::move(value);
+        }
+        else
+            sparse_data.insert_or_assign(idx, std::move(value));
+    }
 
-        if (data.find(tmp_offs) == data.end())
+    // moves the sparse values that fall into the new dense part
+    void grow_dense(size_t new_size)
+    {
+        dense_data.resize(new_size);
+        while (!sparse_data.empty() && sparse_data.begin()->first < new_size)
+        {
+            auto node = sparse_data.extract(sparse_data.begin());
+            dense_data[node.key()] = std::move(node.mapped());
+            ++dense_count;
+        }
+    }
+
+    const T* get_data(std::vector<size_t> offset) const
+    {
+        if ((is_scalar && !offset.empty()) || (!is_scalar && offset.size() != 1))
             return nullptr;
 
-        return &data.at(tmp_offs);
+        if (is_scalar)
+            return scalar_data ? &*scalar_data : nullptr;
+
+        return find(offset.front() - 1);
     }
 };
 
-
 template<>
 inline A_t set_symbol<A_t>::count(std::vector<size_t> offset) const
 {
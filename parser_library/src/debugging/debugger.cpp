@@ -188,6 +188,8 @@ public:
             variables_.clear();
             stack_frames_.clear();
             scopes_.clear();
+            // the system variables are otherwise created only when the code accesses them
+            ctx_->create_system_variables();
             proc_stack_ = ctx_->processing_stack();
             variable_mtx_.unlock();
 
@@ -312,12 +314,22 @@ public:
 
 
         if (proc_stack_[frame_id].scope.is_in_macro())
-            for (auto it : proc_stack_[frame_id].scope.this_macro->named_params)
+        {
+            const auto& invo = *proc_stack_[frame_id].scope.this_macro;
+            std::vector<const context::macro_param_base*> params;
+            for (const auto& param : invo.positional_params)
+                params.push_back(&param);
+            for (const auto& param : invo.keyword_params)
+                params.push_back(&param);
+            params.push_back(&invo.syslist);
+
+            for (auto param : params)
             {
-                if (it.first == context::id_storage::empty_id)
+                if (param->id == context::id_storage::empty_id)
                     continue;
-                scope_vars.push_back(std::make_unique<macro_param_variable>(*it.second, std::vector<size_t> {}));
+                scope_vars.push_back(std::make_unique<macro_param_variable>(*param, std::vector<size_t> {}));
             }
+        }
 
         for (auto it : proc_stack_[frame_id].scope.variables)
         {
@@ -2025,5 +2025,12 @@ diagnostic_s diagnostic_s::error_S101(const std::string& filename, const std::st
         filename, range, diagnostic_severity::error, "S101", "Illegal attribute reference - " + message, {});
 }
 
+std::vector<diagnostic_op> shift_lines(std::vector<diagnostic_op> diags, position_t lines)
+{
+    for (auto& d : diags)
+        d.diag_range = shift_lines(d.diag_range, lines);
+    return diags;
+}
+
 
 } // namespace hlasm_plugin::parser_library
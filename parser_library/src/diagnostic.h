@@ -624,6 +624,9 @@ struct diagnostic_op
     static diagnostic_op error_CW001(const range& range);
 };
 
+// copy of the diagnostics moved by the number of lines
+std::vector<diagnostic_op> shift_lines(std::vector<diagnostic_op> diags, position_t lines);
+
 struct range_uri_s
 {
     range_uri_s() {};
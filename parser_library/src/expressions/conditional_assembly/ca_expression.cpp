@@ -23,6 +23,27 @@ ca_expression::ca_expression(context::SET_t_enum expr_kind, range expr_range)
     , expr_kind(expr_kind)
 {}
 
+context::A_t ca_expression::evaluate_a(const evaluation_context& eval_ctx) const
+{
+    return evaluate(eval_ctx).access_a();
+}
+
+context::B_t ca_expression::evaluate_b(const evaluation_context& eval_ctx) const
+{
+    return evaluate(eval_ctx).access_b();
+}
+
+bool ca_expression::keeps_kind() const { return false; }
+
+context::SET_t ca_expression::constant_result() const
+{
+    if (expr_kind == context::SET_t_enum::B_TYPE)
+        return *constant_ != 0;
+    return *constant_;
+}
+
+bool ca_expression::is_constant(const ca_expression& expr) { return expr.constant_ && expr.diags().empty(); }
+
 context::SET_t ca_expression::convert_return_types(
     context::SET_t retval, context::SET_t_enum type, const evaluation_context& eval_ctx) const
 {
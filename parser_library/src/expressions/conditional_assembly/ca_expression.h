@@ -16,10 +16,12 @@
 #define HLASMPLUGIN_PARSERLIBRARY_CA_EXPRESSION_H
 
 #include <memory>
+#include <optional>
 #include <set>
 
 #include "context/common_types.h"
 #include "context/ordinary_assembly/dependable.h"
+#include "context/statement_arena.h"
 #include "diagnosable_impl.h"
 
 namespace hlasm_plugin::parser_library::expressions {
@@ -55,9 +57,41 @@ public:
 
     virtual context::SET_t evaluate(const evaluation_context& eval_ctx) const = 0;
 
+    // arithmetic and binary value of the expression, the same as evaluate(eval_ctx).access_a() (access_b())
+    // but overridden by the expressions that can compute it without creating SET_t values
+    virtual context::A_t evaluate_a(const evaluation_context& eval_ctx) const;
+    virtual context::B_t evaluate_b(const evaluation_context& eval_ctx) const;
+
+    // evaluate always returns the value of expr_kind type, so no conversion is needed
+    virtual bool keeps_kind() const;
+
+    // value of the expression computed when the expression tree was resolved (binary value as 0 or 1)
+    const std::optional<context::A_t>& constant_value() const { return constant_; }
+    // restores the value of an expression tree that was resolved before, e.g. when it is deserialized
+    void set_constant_value(std::optional<context::A_t> value) { constant_ = value; }
+
+    // the nodes share the memory of the statement the expression is parsed in, see make_arena_unique
+    static void* operator new(size_t size) { return context::statement_arena::allocate_object(size, nullptr); }
+    static void* operator new(size_t size, context::statement_arena* arena)
+    {
+        return context::statement_arena::allocate_object(size, arena);
+    }
+    static void operator delete(void* p) noexcept { context::statement_arena::release_object(p); }
+    static void operator delete(void* p, context::statement_arena*) noexcept
+    {
+        context::statement_arena::release_object(p);
+    }
+
     virtual ~ca_expression() = default;
 
 protected:
+    std::optional<context::A_t> constant_;
+
+    context::SET_t constant_result() const;
+
+    // the expression has the constant value and no errors
+    static bool is_constant(const ca_expression& expr);
+
     context::SET_t convert_return_types(
         context::SET_t retval, context::SET_t_enum type, const evaluation_context& eval_ctx) const;
 };
@@ -67,6 +101,18 @@ template<typename T>
 inline T ca_expression::evaluate(const evaluation_context& eval_ctx) const
 {
     static_assert(context::object_traits<T>::type_enum != context::SET_t_enum::UNDEF_TYPE);
+
+    if constexpr (context::object_traits<T>::type_enum == context::SET_t_enum::A_TYPE)
+    {
+        if (expr_kind == context::SET_t_enum::A_TYPE && keeps_kind())
+            return evaluate_a(eval_ctx);
+    }
+    if constexpr (context::object_traits<T>::type_enum == context::SET_t_enum::B_TYPE)
+    {
+        if (expr_kind == context::SET_t_enum::B_TYPE && keeps_kind())
+            return evaluate_b(eval_ctx);
+    }
+
     auto ret = evaluate(eval_ctx);
 
     ret = convert_return_types(std::move(ret), context::object_traits<T>::type_enum, eval_ctx);
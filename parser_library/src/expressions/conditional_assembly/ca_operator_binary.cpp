@@ -64,6 +64,8 @@ void ca_binary_operator::apply(ca_expr_visitor& visitor) const
 
 context::SET_t ca_binary_operator::evaluate(const evaluation_context& eval_ctx) const
 {
+    if (constant_)
+        return constant_result();
     return operation(left_expr->evaluate(eval_ctx), right_expr->evaluate(eval_ctx), eval_ctx);
 }
 
@@ -96,9 +98,32 @@ void ca_function_binary_operator::resolve_expression_tree(context::SET_t_enum ki
 
         left_expr->resolve_expression_tree(operands_kind);
         right_expr->resolve_expression_tree(operands_kind);
+
+        if (!uses_characters() && diags().empty() && is_constant(*left_expr) && is_constant(*right_expr))
+            constant_ = compute(*left_expr->constant_value(), *right_expr->constant_value());
     }
 }
 
+context::A_t ca_function_binary_operator::evaluate_a(const evaluation_context& eval_ctx) const
+{
+    if (constant_)
+        return *constant_;
+    if (uses_characters())
+        return ca_binary_operator::evaluate_a(eval_ctx);
+    auto lhs = left_expr->evaluate_a(eval_ctx);
+    auto rhs = right_expr->evaluate_a(eval_ctx);
+    return compute(lhs, rhs);
+}
+
+context::B_t ca_function_binary_operator::evaluate_b(const evaluation_context& eval_ctx) const
+{
+    if (uses_characters())
+        return ca_binary_operator::evaluate_b(eval_ctx);
+    return evaluate_a(eval_ctx) != 0;
+}
+
+bool ca_function_binary_operator::keeps_kind() const { return true; }
+
 context::A_t shift_operands(context::A_t lhs, context::A_t rhs, ca_expr_ops shift)
 {
     auto shift_part = rhs & 0x3f; // first 6 bits
@@ -241,6 +266,78 @@ int ca_function_binary_operator::compare_relational(
     }
 }
 
+context::A_t ca_function_binary_operator::compute(context::A_t lhs, context::A_t rhs) const
+{
+    if (expr_kind == context::SET_t_enum::A_TYPE)
+    {
+        switch (function)
+        {
+            case ca_expr_ops::SLA:
+            case ca_expr_ops::SLL:
+            case ca_expr_ops::SRA:
+            case ca_expr_ops::SRL:
+                return shift_operands(lhs, rhs, function);
+            case ca_expr_ops::AND:
+                return lhs & rhs;
+            case ca_expr_ops::OR:
+                return lhs | rhs;
+            case ca_expr_ops::XOR:
+                return lhs ^ rhs;
+            default:
+                break;
+        }
+    }
+    else if (expr_kind == context::SET_t_enum::B_TYPE)
+    {
+        int comp = 0;
+        if (is_relational() && left_expr->expr_kind == context::SET_t_enum::A_TYPE)
+            comp = lhs - rhs;
+
+        const bool lhs_b = lhs != 0;
+        const bool rhs_b = rhs != 0;
+
+        switch (function)
+        {
+            case ca_expr_ops::EQ:
+                return comp == 0;
+            case ca_expr_ops::NE:
+                return comp != 0;
+            case ca_expr_ops::LE:
+                return comp <= 0;
+            case ca_expr_ops::LT:
+                return comp < 0;
+            case ca_expr_ops::GE:
+                return comp >= 0;
+            case ca_expr_ops::GT:
+                return comp > 0;
+            case ca_expr_ops::AND:
+                return lhs_b && rhs_b;
+            case ca_expr_ops::OR:
+                return lhs_b || rhs_b;
+            case ca_expr_ops::XOR:
+                return lhs_b != rhs_b;
+            case ca_expr_ops::AND_NOT:
+                return lhs_b && !rhs_b;
+            case ca_expr_ops::OR_NOT:
+                return lhs_b || !rhs_b;
+            case ca_expr_ops::XOR_NOT:
+                return lhs_b != !rhs_b;
+            default:
+                break;
+        }
+    }
+    return 0;
+}
+
+bool ca_function_binary_operator::uses_characters() const
+{
+    if (function == ca_expr_ops::FIND || function == ca_expr_ops::INDEX)
+        return true;
+    if (is_relational() && left_expr->expr_kind == context::SET_t_enum::C_TYPE)
+        return true;
+    return expr_kind == context::SET_t_enum::C_TYPE;
+}
+
 bool ca_function_binary_operator::is_relational() const
 {
     switch (function)
@@ -273,30 +370,79 @@ context::A_t overflow_transform(std::int64_t val, range expr_range, const evalua
         return (context::A_t)val;
 }
 
+std::optional<context::A_t> fold_transform(std::int64_t val)
+{
+    if (val > std::numeric_limits<context::A_t>::max() || val < std::numeric_limits<context::A_t>::min())
+        return std::nullopt;
+    return (context::A_t)val;
+}
+
 context::SET_t ca_add::operation(
     const context::SET_t& lhs, const context::SET_t& rhs, range expr_range, const evaluation_context& eval_ctx)
 {
-    return overflow_transform((std::int64_t)lhs.access_a() + (std::int64_t)rhs.access_a(), expr_range, eval_ctx);
+    return compute(lhs.access_a(), rhs.access_a(), std::move(expr_range), eval_ctx);
+}
+
+context::A_t ca_add::compute(context::A_t lhs, context::A_t rhs, range expr_range, const evaluation_context& eval_ctx)
+{
+    return overflow_transform((std::int64_t)lhs + (std::int64_t)rhs, expr_range, eval_ctx);
+}
+
+std::optional<context::A_t> ca_add::fold(context::A_t lhs, context::A_t rhs)
+{
+    return fold_transform((std::int64_t)lhs + (std::int64_t)rhs);
 }
 
 context::SET_t ca_sub::operation(
     const context::SET_t& lhs, const context::SET_t& rhs, range expr_range, const evaluation_context& eval_ctx)
 {
-    return overflow_transform((std::int64_t)lhs.access_a() - (std::int64_t)rhs.access_a(), expr_range, eval_ctx);
+    return compute(lhs.access_a(), rhs.access_a(), std::move(expr_range), eval_ctx);
+}
+
+context::A_t ca_sub::compute(context::A_t lhs, context::A_t rhs, range expr_range, const evaluation_context& eval_ctx)
+{
+    return overflow_transform((std::int64_t)lhs - (std::int64_t)rhs, expr_range, eval_ctx);
+}
+
+std::optional<context::A_t> ca_sub::fold(context::A_t lhs, context::A_t rhs)
+{
+    return fold_transform((std::int64_t)lhs - (std::int64_t)rhs);
 }
 
 context::SET_t ca_mul::operation(
     const context::SET_t& lhs, const context::SET_t& rhs, range expr_range, const evaluation_context& eval_ctx)
 {
-    return overflow_transform((std::int64_t)lhs.access_a() * (std::int64_t)rhs.access_a(), expr_range, eval_ctx);
+    return compute(lhs.access_a(), rhs.access_a(), std::move(expr_range), eval_ctx);
+}
+
+context::A_t ca_mul::compute(context::A_t lhs, context::A_t rhs, range expr_range, const evaluation_context& eval_ctx)
+{
+    return overflow_transform((std::int64_t)lhs * (std::int64_t)rhs, expr_range, eval_ctx);
+}
+
+std::optional<context::A_t> ca_mul::fold(context::A_t lhs, context::A_t rhs)
+{
+    return fold_transform((std::int64_t)lhs * (std::int64_t)rhs);
 }
 
 context::SET_t ca_div::operation(
     const context::SET_t& lhs, const context::SET_t& rhs, range expr_range, const evaluation_context& eval_ctx)
 {
-    if (rhs.access_a() == 0)
+    return compute(lhs.access_a(), rhs.access_a(), std::move(expr_range), eval_ctx);
+}
+
+context::A_t ca_div::compute(context::A_t lhs, context::A_t rhs, range expr_range, const evaluation_context& eval_ctx)
+{
+    if (rhs == 0)
+        return 0;
+    return overflow_transform((std::int64_t)lhs / (std::int64_t)rhs, expr_range, eval_ctx);
+}
+
+std::optional<context::A_t> ca_div::fold(context::A_t lhs, context::A_t rhs)
+{
+    if (rhs == 0)
         return 0;
-    return overflow_transform((std::int64_t)lhs.access_a() / (std::int64_t)rhs.access_a(), expr_range, eval_ctx);
+    return fold_transform((std::int64_t)lhs / (std::int64_t)rhs);
 }
 
 context::SET_t ca_conc::operation(
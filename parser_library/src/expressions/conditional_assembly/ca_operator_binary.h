@@ -15,6 +15,8 @@
 #ifndef HLASMPLUGIN_PARSERLIBRARY_CA_OPERATOR_BINARY_H
 #define HLASMPLUGIN_PARSERLIBRARY_CA_OPERATOR_BINARY_H
 
+#include <optional>
+
 #include "ca_expr_policy.h"
 #include "ca_expression.h"
 
@@ -54,6 +56,41 @@ public:
         : ca_binary_operator(std::move(left_expr), std::move(right_expr), OP::type, std::move(expr_range))
     {}
 
+    void resolve_expression_tree(context::SET_t_enum kind) override
+    {
+        ca_binary_operator::resolve_expression_tree(kind);
+
+        if constexpr (OP::type == context::SET_t_enum::A_TYPE)
+        {
+            if (diags().empty() && is_constant(*left_expr) && is_constant(*right_expr))
+                constant_ = OP::fold(*left_expr->constant_value(), *right_expr->constant_value());
+        }
+    }
+
+    context::A_t evaluate_a(const evaluation_context& eval_ctx) const override
+    {
+        if constexpr (OP::type == context::SET_t_enum::A_TYPE)
+        {
+            if (constant_)
+                return *constant_;
+            auto lhs = left_expr->evaluate_a(eval_ctx);
+            auto rhs = right_expr->evaluate_a(eval_ctx);
+            return OP::compute(lhs, rhs, expr_range, eval_ctx);
+        }
+        else
+            return ca_binary_operator::evaluate_a(eval_ctx);
+    }
+
+    context::B_t evaluate_b(const evaluation_context& eval_ctx) const override
+    {
+        if constexpr (OP::type == context::SET_t_enum::A_TYPE)
+            return evaluate_a(eval_ctx) != 0;
+        else
+            return ca_binary_operator::evaluate_b(eval_ctx);
+    }
+
+    bool keeps_kind() const override { return OP::type == context::SET_t_enum::A_TYPE; }
+
     context::SET_t operation(context::SET_t lhs, context::SET_t rhs, const evaluation_context& eval_ctx) const override
     {
         return OP::operation(std::move(lhs), std::move(rhs), expr_range, eval_ctx);
@@ -74,6 +111,12 @@ public:
 
     void resolve_expression_tree(context::SET_t_enum kind) override;
 
+    context::A_t evaluate_a(const evaluation_context& eval_ctx) const override;
+
+    context::B_t evaluate_b(const evaluation_context& eval_ctx) const override;
+
+    bool keeps_kind() const override;
+
     context::SET_t operation(context::SET_t lhs, context::SET_t rhs, const evaluation_context& eval_ctx) const override;
 
     static int compare_string(const context::C_t& lhs, const context::C_t& rhs);
@@ -81,14 +124,24 @@ public:
 
 private:
     bool is_relational() const;
+    // the operands or the result are character strings
+    bool uses_characters() const;
+    // the same as operation, for arithmetic and binary operands (binary result as 0 or 1)
+    context::A_t compute(context::A_t lhs, context::A_t rhs) const;
 };
 
+// arithmetic operators compute the result from A_t operands as well,
+// fold computes the result of constant operands and fails on overflow instead of reporting it
 struct ca_add
 {
     static constexpr context::SET_t_enum type = context::SET_t_enum::A_TYPE;
 
     static context::SET_t operation(
         const context::SET_t& lhs, const context::SET_t& rhs, range expr_range, const evaluation_context& eval_ctx);
+
+    static context::A_t compute(
+        context::A_t lhs, context::A_t rhs, range expr_range, const evaluation_context& eval_ctx);
+    static std::optional<context::A_t> fold(context::A_t lhs, context::A_t rhs);
 };
 
 struct ca_sub
@@ -97,6 +150,10 @@ struct ca_sub
 
     static context::SET_t operation(
         const context::SET_t& lhs, const context::SET_t& rhs, range expr_range, const evaluation_context& eval_ctx);
+
+    static context::A_t compute(
+        context::A_t lhs, context::A_t rhs, range expr_range, const evaluation_context& eval_ctx);
+    static std::optional<context::A_t> fold(context::A_t lhs, context::A_t rhs);
 };
 
 struct ca_mul
@@ -105,6 +162,10 @@ struct ca_mul
 
     static context::SET_t operation(
         const context::SET_t& lhs, const context::SET_t& rhs, range expr_range, const evaluation_context& eval_ctx);
+
+    static context::A_t compute(
+        context::A_t lhs, context::A_t rhs, range expr_range, const evaluation_context& eval_ctx);
+    static std::optional<context::A_t> fold(context::A_t lhs, context::A_t rhs);
 };
 
 struct ca_div
@@ -113,6 +174,10 @@ struct ca_div
 
     static context::SET_t operation(
         const context::SET_t& lhs, const context::SET_t& rhs, range expr_range, const evaluation_context& eval_ctx);
+
+    static context::A_t compute(
+        context::A_t lhs, context::A_t rhs, range expr_range, const evaluation_context& eval_ctx);
+    static std::optional<context::A_t> fold(context::A_t lhs, context::A_t rhs);
 };
 
 struct ca_conc
@@ -15,6 +15,7 @@
 #include "ca_operator_unary.h"
 
 #include <algorithm>
+#include <limits>
 
 #include "ebcdic_encoding.h"
 #include "expressions/evaluation_context.h"
@@ -48,6 +49,8 @@ void ca_unary_operator::apply(ca_expr_visitor& visitor) const { expr->apply(visi
 
 context::SET_t ca_unary_operator::evaluate(const evaluation_context& eval_ctx) const
 {
+    if (constant_)
+        return constant_result();
     return operation(expr->evaluate(eval_ctx), eval_ctx);
 }
 
@@ -62,7 +65,45 @@ void ca_function_unary_operator::resolve_expression_tree(context::SET_t_enum kin
     if (expr_kind != kind)
         add_diagnostic(diagnostic_op::error_CE004(expr_range));
     else
+    {
         expr->resolve_expression_tree(ca_common_expr_policy::get_operands_type(function, kind));
+
+        if (function == ca_expr_ops::NOT && expr_kind != context::SET_t_enum::C_TYPE && diags().empty()
+            && is_constant(*expr))
+        {
+            const auto value = *expr->constant_value();
+            constant_ = expr_kind == context::SET_t_enum::A_TYPE ? ~value : (context::A_t)(value == 0);
+        }
+    }
+}
+
+context::A_t ca_function_unary_operator::evaluate_a(const evaluation_context& eval_ctx) const
+{
+    if (constant_)
+        return *constant_;
+    if (expr_kind == context::SET_t_enum::A_TYPE)
+    {
+        auto value = expr->evaluate_a(eval_ctx);
+        return function == ca_expr_ops::NOT ? ~value : 0;
+    }
+    if (expr_kind == context::SET_t_enum::B_TYPE)
+    {
+        auto value = expr->evaluate_b(eval_ctx);
+        return function == ca_expr_ops::NOT && !value;
+    }
+    return ca_unary_operator::evaluate_a(eval_ctx);
+}
+
+context::B_t ca_function_unary_operator::evaluate_b(const evaluation_context& eval_ctx) const
+{
+    if (expr_kind == context::SET_t_enum::C_TYPE)
+        return ca_unary_operator::evaluate_b(eval_ctx);
+    return evaluate_a(eval_ctx) != 0;
+}
+
+bool ca_function_unary_operator::keeps_kind() const
+{
+    return expr_kind == context::SET_t_enum::A_TYPE || expr_kind == context::SET_t_enum::B_TYPE;
 }
 
 context::SET_t ca_function_unary_operator::operation(context::SET_t operand, const evaluation_context& eval_ctx) const
@@ -103,6 +144,28 @@ ca_plus_operator::ca_plus_operator(ca_expr_ptr expr, range expr_range)
     : ca_unary_operator(std::move(expr), context::SET_t_enum::A_TYPE, std::move(expr_range))
 {}
 
+void ca_plus_operator::resolve_expression_tree(context::SET_t_enum kind)
+{
+    ca_unary_operator::resolve_expression_tree(kind);
+
+    if (diags().empty() && is_constant(*expr))
+        constant_ = expr->constant_value();
+}
+
+context::A_t ca_plus_operator::evaluate_a(const evaluation_context& eval_ctx) const
+{
+    if (constant_)
+        return *constant_;
+    return expr->evaluate_a(eval_ctx);
+}
+
+context::B_t ca_plus_operator::evaluate_b(const evaluation_context& eval_ctx) const
+{
+    return evaluate_a(eval_ctx) != 0;
+}
+
+bool ca_plus_operator::keeps_kind() const { return true; }
+
 context::SET_t ca_plus_operator::operation(context::SET_t operand, const evaluation_context&) const
 {
     return operand.access_a();
@@ -112,6 +175,29 @@ ca_minus_operator::ca_minus_operator(ca_expr_ptr expr, range expr_range)
     : ca_unary_operator(std::move(expr), context::SET_t_enum::A_TYPE, std::move(expr_range))
 {}
 
+void ca_minus_operator::resolve_expression_tree(context::SET_t_enum kind)
+{
+    ca_unary_operator::resolve_expression_tree(kind);
+
+    if (diags().empty() && is_constant(*expr)
+        && *expr->constant_value() != std::numeric_limits<context::A_t>::min())
+        constant_ = -*expr->constant_value();
+}
+
+context::A_t ca_minus_operator::evaluate_a(const evaluation_context& eval_ctx) const
+{
+    if (constant_)
+        return *constant_;
+    return -expr->evaluate_a(eval_ctx);
+}
+
+context::B_t ca_minus_operator::evaluate_b(const evaluation_context& eval_ctx) const
+{
+    return evaluate_a(eval_ctx) != 0;
+}
+
+bool ca_minus_operator::keeps_kind() const { return true; }
+
 context::SET_t ca_minus_operator::operation(context::SET_t operand, const evaluation_context&) const
 {
     return -operand.access_a();
@@ -125,8 +211,22 @@ void ca_par_operator::resolve_expression_tree(context::SET_t_enum kind)
 {
     expr->resolve_expression_tree(kind);
     expr_kind = expr->expr_kind;
+    if (is_constant(*expr))
+        constant_ = expr->constant_value();
+}
+
+context::A_t ca_par_operator::evaluate_a(const evaluation_context& eval_ctx) const
+{
+    return expr->evaluate_a(eval_ctx);
+}
+
+context::B_t ca_par_operator::evaluate_b(const evaluation_context& eval_ctx) const
+{
+    return expr->evaluate_b(eval_ctx);
 }
 
+bool ca_par_operator::keeps_kind() const { return expr->keeps_kind(); }
+
 context::SET_t ca_par_operator::operation(context::SET_t operand, const evaluation_context&) const { return operand; }
 
 } // namespace hlasm_plugin::parser_library::expressions
@@ -47,6 +47,14 @@ class ca_plus_operator : public ca_unary_operator
 public:
     ca_plus_operator(ca_expr_ptr expr, range expr_range);
 
+    void resolve_expression_tree(context::SET_t_enum kind) override;
+
+    context::A_t evaluate_a(const evaluation_context& eval_ctx) const override;
+
+    context::B_t evaluate_b(const evaluation_context& eval_ctx) const override;
+
+    bool keeps_kind() const override;
+
     context::SET_t operation(context::SET_t operand, const evaluation_context& eval_ctx) const override;
 };
 
@@ -55,6 +63,14 @@ class ca_minus_operator : public ca_unary_operator
 public:
     ca_minus_operator(ca_expr_ptr expr, range expr_range);
 
+    void resolve_expression_tree(context::SET_t_enum kind) override;
+
+    context::A_t evaluate_a(const evaluation_context& eval_ctx) const override;
+
+    context::B_t evaluate_b(const evaluation_context& eval_ctx) const override;
+
+    bool keeps_kind() const override;
+
     context::SET_t operation(context::SET_t operand, const evaluation_context& eval_ctx) const override;
 };
 
@@ -65,6 +81,12 @@ public:
 
     void resolve_expression_tree(context::SET_t_enum kind) override;
 
+    context::A_t evaluate_a(const evaluation_context& eval_ctx) const override;
+
+    context::B_t evaluate_b(const evaluation_context& eval_ctx) const override;
+
+    bool keeps_kind() const override;
+
     context::SET_t operation(context::SET_t operand, const evaluation_context& eval_ctx) const override;
 };
 
@@ -78,6 +100,12 @@ public:
 
     void resolve_expression_tree(context::SET_t_enum kind) override;
 
+    context::A_t evaluate_a(const evaluation_context& eval_ctx) const override;
+
+    context::B_t evaluate_b(const evaluation_context& eval_ctx) const override;
+
+    bool keeps_kind() const override;
+
     context::SET_t operation(context::SET_t operand, const evaluation_context& eval_ctx) const override;
 };
 
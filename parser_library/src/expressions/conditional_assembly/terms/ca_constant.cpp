@@ -22,7 +22,9 @@ namespace hlasm_plugin::parser_library::expressions {
 ca_constant::ca_constant(context::A_t value, range expr_range)
     : ca_expression(context::SET_t_enum::A_TYPE, std::move(expr_range))
     , value(value)
-{}
+{
+    constant_ = value;
+}
 
 undef_sym_set ca_constant::get_undefined_attributed_symbols(const evaluation_context&) const { return undef_sym_set(); }
 
@@ -43,6 +45,12 @@ void ca_constant::apply(ca_expr_visitor& visitor) const { visitor.visit(*this);
 
 context::SET_t ca_constant::evaluate(const evaluation_context&) const { return value; }
 
+context::A_t ca_constant::evaluate_a(const evaluation_context&) const { return value; }
+
+context::B_t ca_constant::evaluate_b(const evaluation_context&) const { return value != 0; }
+
+bool ca_constant::keeps_kind() const { return true; }
+
 context::A_t ca_constant::self_defining_term(
     std::string_view type, std::string_view value, diagnostic_adder& add_diagnostic)
 {
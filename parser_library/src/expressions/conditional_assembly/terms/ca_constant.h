@@ -44,6 +44,12 @@ public:
 
     context::SET_t evaluate(const evaluation_context& eval_ctx) const override;
 
+    context::A_t evaluate_a(const evaluation_context& eval_ctx) const override;
+
+    context::B_t evaluate_b(const evaluation_context& eval_ctx) const override;
+
+    bool keeps_kind() const override;
+
     static context::A_t self_defining_term(
         std::string_view type, std::string_view value, diagnostic_adder& add_diagnostic);
 
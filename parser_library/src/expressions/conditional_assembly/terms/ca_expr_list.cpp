@@ -56,6 +56,9 @@ void ca_expr_list::resolve_expression_tree(context::SET_t_enum kind)
         resolve<context::C_t>();
     else
         assert(false);
+
+    if (expr_list.size() == 1 && expr_list.front()->expr_kind == kind && is_constant(*expr_list.front()))
+        constant_ = expr_list.front()->constant_value();
 }
 
 void ca_expr_list::collect_diags() const
@@ -77,6 +80,25 @@ context::SET_t ca_expr_list::evaluate(const evaluation_context& eval_ctx) const
     return expr_list.front()->evaluate(eval_ctx);
 }
 
+context::A_t ca_expr_list::evaluate_a(const evaluation_context& eval_ctx) const
+{
+    if (expr_list.empty())
+        return context::object_traits<context::A_t>::default_v();
+    return expr_list.front()->evaluate_a(eval_ctx);
+}
+
+context::B_t ca_expr_list::evaluate_b(const evaluation_context& eval_ctx) const
+{
+    if (expr_list.empty())
+        return context::object_traits<context::B_t>::default_v();
+    return expr_list.front()->evaluate_b(eval_ctx);
+}
+
+bool ca_expr_list::keeps_kind() const
+{
+    return expr_list.size() == 1 && expr_list.front()->expr_kind == expr_kind && expr_list.front()->keeps_kind();
+}
+
 void ca_expr_list::unknown_functions_to_operators()
 {
     for (int idx = (int)expr_list.size() - 1; idx >= 0; --idx)
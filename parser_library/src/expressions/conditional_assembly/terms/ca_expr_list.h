@@ -42,6 +42,12 @@ public:
 
     context::SET_t evaluate(const evaluation_context& eval_ctx) const override;
 
+    context::A_t evaluate_a(const evaluation_context& eval_ctx) const override;
+
+    context::B_t evaluate_b(const evaluation_context& eval_ctx) const override;
+
+    bool keeps_kind() const override;
+
 private:
     // this function is present due to the fact that in hlasm you can omit space between operator and operands if
     // operators are in parentheses (eg. ('A')FIND('B') )
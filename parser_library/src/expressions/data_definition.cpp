@@ -253,6 +253,26 @@ void data_definition::assign_location_counter(context::address loctr_value)
     }
 }
 
+data_definition data_definition::clone(position_t line_shift) const
+{
+    auto clone_expr = [line_shift](const mach_expr_ptr& expr) { return expr ? expr->clone(line_shift) : nullptr; };
+
+    data_definition result;
+    result.dupl_factor = clone_expr(dupl_factor);
+    result.type = type;
+    result.type_range = shift_lines(type_range, line_shift);
+    result.extension = extension;
+    result.extension_range = shift_lines(extension_range, line_shift);
+    result.program_type = clone_expr(program_type);
+    result.length = clone_expr(length);
+    result.scale = clone_expr(scale);
+    result.exponent = clone_expr(exponent);
+    result.nominal_value = nominal_value ? nominal_value->clone(line_shift) : nullptr;
+    result.length_type = length_type;
+    result.diags() = shift_lines(diags(), line_shift);
+    return result;
+}
+
 void data_definition::collect_diags() const {}
 
 checking::data_def_field<int32_t> set_data_def_field(
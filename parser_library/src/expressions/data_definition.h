@@ -98,6 +98,9 @@ struct data_definition : public diagnosable_op_impl, public context::dependable
     // Assigns location counter to all expressions used to represent this data_definition.
     void assign_location_counter(context::address loctr_value);
 
+    // Returns a deep copy of the data definition including its diagnostics, moved by the number of lines.
+    data_definition clone(position_t line_shift = 0) const;
+
     void collect_diags() const override;
 
     // When any of the evaluated expressions have dependencies, resulting modifier will have data_def_field::present set
@@ -40,6 +40,10 @@ mach_expr_constant::mach_expr_constant(int value, range rng)
     , value_(value)
 {}
 
+mach_expr_constant::mach_expr_constant(range rng)
+    : mach_expression(rng)
+{}
+
 context::dependency_collector mach_expr_constant::get_dependencies(context::dependency_solver&) const
 {
     return context::dependency_collector();
@@ -53,6 +57,19 @@ const mach_expression* mach_expr_constant::leftmost_term() const { return this;
 
 void mach_expr_constant::apply(mach_expr_visitor& visitor) const { visitor.visit(*this); }
 
+mach_expr_ptr mach_expr_constant::clone(position_t line_shift) const
+{
+    // a defined symbol_value cannot be assigned over, so the clone is created with the value right away
+    const auto rng = shift_lines(get_range(), line_shift);
+    std::unique_ptr<mach_expr_constant> result;
+    if (value_.value_kind() == context::symbol_value_kind::ABS)
+        result = std::make_unique<mach_expr_constant>(value_.get_abs(), rng);
+    else
+        result.reset(new mach_expr_constant(rng));
+    result->diags() = shift_lines(diags(), line_shift);
+    return result;
+}
+
 
 
 //***********  mach_expr_symbol ************
@@ -86,6 +103,13 @@ mach_expr_constant::value_t mach_expr_symbol::evaluate(mach_evaluate_info info)
 void mach_expr_symbol::fill_location_counter(context::address) {}
 const mach_expression* mach_expr_symbol::leftmost_term() const { return this; }
 void mach_expr_symbol::apply(mach_expr_visitor& visitor) const { visitor.visit(*this); }
+
+mach_expr_ptr mach_expr_symbol::clone(position_t line_shift) const
+{
+    auto result = std::make_unique<mach_expr_symbol>(value, shift_lines(get_range(), line_shift));
+    result->diags() = shift_lines(diags(), line_shift);
+    return result;
+}
 //***********  mach_expr_self_def ************
 mach_expr_self_def::mach_expr_self_def(std::string option, std::string value, range rng)
     : mach_expression(rng)
@@ -94,6 +118,11 @@ mach_expr_self_def::mach_expr_self_def(std::string option, std::string value, ra
     value_ = ca_constant::self_defining_term(option, value, add_diagnostic);
 }
 
+mach_expr_self_def::mach_expr_self_def(context::A_t value, range rng)
+    : mach_expression(rng)
+    , value_(value)
+{}
+
 context::dependency_collector mach_expr_self_def::get_dependencies(context::dependency_solver&) const
 {
     return context::dependency_collector();
@@ -107,6 +136,13 @@ const mach_expression* mach_expr_self_def::leftmost_term() const { return this;
 
 void mach_expr_self_def::apply(mach_expr_visitor& visitor) const { visitor.visit(*this); }
 
+mach_expr_ptr mach_expr_self_def::clone(position_t line_shift) const
+{
+    auto result = std::make_unique<mach_expr_self_def>(value_.get_abs(), shift_lines(get_range(), line_shift));
+    result->diags() = shift_lines(diags(), line_shift);
+    return result;
+}
+
 mach_expr_location_counter::mach_expr_location_counter(range rng)
     : mach_expression(rng)
 {}
@@ -133,6 +169,14 @@ const mach_expression* mach_expr_location_counter::leftmost_term() const { retur
 
 void mach_expr_location_counter::apply(mach_expr_visitor& visitor) const { visitor.visit(*this); }
 
+mach_expr_ptr mach_expr_location_counter::clone(position_t line_shift) const
+{
+    auto result = std::make_unique<mach_expr_location_counter>(shift_lines(get_range(), line_shift));
+    result->location_counter = location_counter;
+    result->diags() = shift_lines(diags(), line_shift);
+    return result;
+}
+
 mach_expr_default::mach_expr_default(range rng)
     : mach_expression(rng)
 {}
@@ -150,6 +194,13 @@ const mach_expression* mach_expr_default::leftmost_term() const { return this; }
 
 void mach_expr_default::apply(mach_expr_visitor& visitor) const { visitor.visit(*this); }
 
+mach_expr_ptr mach_expr_default::clone(position_t line_shift) const
+{
+    auto result = std::make_unique<mach_expr_default>(shift_lines(get_range(), line_shift));
+    result->diags() = shift_lines(diags(), line_shift);
+    return result;
+}
+
 void mach_expr_default::collect_diags() const {}
 
 mach_expr_data_attr::mach_expr_data_attr(
@@ -200,4 +251,12 @@ const mach_expression* mach_expr_data_attr::leftmost_term() const { return this;
 
 void mach_expr_data_attr::apply(mach_expr_visitor& visitor) const { visitor.visit(*this); }
 
+mach_expr_ptr mach_expr_data_attr::clone(position_t line_shift) const
+{
+    auto result = std::make_unique<mach_expr_data_attr>(
+        value, attribute, shift_lines(get_range(), line_shift), shift_lines(symbol_range, line_shift));
+    result->diags() = shift_lines(diags(), line_shift);
+    return result;
+}
+
 } // namespace hlasm_plugin::parser_library::expressions
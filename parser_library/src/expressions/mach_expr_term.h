@@ -25,6 +25,9 @@ class mach_expr_constant : public mach_expression
 {
     value_t value_;
 
+    // constant out of range, its value stays undefined
+    explicit mach_expr_constant(range rng);
+
 public:
     mach_expr_constant(std::string value_text, range rng);
     mach_expr_constant(int value, range rng);
@@ -39,6 +42,8 @@ public:
 
     void apply(mach_expr_visitor& visitor) const override;
 
+    mach_expr_ptr clone(position_t line_shift) const override;
+
     void collect_diags() const override {}
 };
 
@@ -62,6 +67,8 @@ public:
 
     void apply(mach_expr_visitor& visitor) const override;
 
+    mach_expr_ptr clone(position_t line_shift) const override;
+
     void collect_diags() const override {}
 };
 
@@ -84,6 +91,8 @@ public:
 
     void apply(mach_expr_visitor& visitor) const override;
 
+    mach_expr_ptr clone(position_t line_shift) const override;
+
     void collect_diags() const override {}
 };
 
@@ -105,6 +114,8 @@ public:
 
     void apply(mach_expr_visitor& visitor) const override;
 
+    mach_expr_ptr clone(position_t line_shift) const override;
+
     void collect_diags() const override {}
 };
 
@@ -115,6 +126,7 @@ class mach_expr_self_def : public mach_expression
 
 public:
     mach_expr_self_def(std::string option, std::string value, range rng);
+    mach_expr_self_def(context::A_t value, range rng);
 
     context::dependency_collector get_dependencies(context::dependency_solver& solver) const override;
 
@@ -126,6 +138,8 @@ public:
 
     void apply(mach_expr_visitor& visitor) const override;
 
+    mach_expr_ptr clone(position_t line_shift) const override;
+
     void collect_diags() const override {}
 };
 
@@ -146,6 +160,8 @@ public:
 
     void apply(mach_expr_visitor& visitor) const override;
 
+    mach_expr_ptr clone(position_t line_shift) const override;
+
     void collect_diags() const override;
 };
 
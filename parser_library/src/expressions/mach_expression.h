@@ -19,6 +19,7 @@
 #include <string>
 
 #include "context/ordinary_assembly/dependable.h"
+#include "context/statement_arena.h"
 #include "diagnosable_impl.h"
 
 
@@ -53,7 +54,22 @@ public:
 
     virtual void apply(mach_expr_visitor& visitor) const = 0;
 
+    // Returns a deep copy of the expression including its diagnostics, moved by the number of lines.
+    virtual mach_expr_ptr clone(position_t line_shift = 0) const = 0;
+
     range get_range() const;
+
+    static void* operator new(size_t size) { return context::statement_arena::allocate_object(size, nullptr); }
+    static void* operator new(size_t size, context::statement_arena* arena)
+    {
+        return context::statement_arena::allocate_object(size, arena);
+    }
+    static void operator delete(void* p) noexcept { context::statement_arena::release_object(p); }
+    static void operator delete(void* p, context::statement_arena*) noexcept
+    {
+        context::statement_arena::release_object(p);
+    }
+
     virtual ~mach_expression() {}
 
     static mach_expr_ptr assign_expr(mach_expr_ptr expr, range expr_range);
@@ -56,6 +56,14 @@ public:
         right_->apply(visitor);
     }
 
+    mach_expr_ptr clone(position_t line_shift) const override
+    {
+        auto result = std::make_unique<mach_expr_binary>(
+            left_->clone(line_shift), right_->clone(line_shift), shift_lines(get_range(), line_shift));
+        result->diags() = shift_lines(diags(), line_shift);
+        return result;
+    }
+
     const mach_expression* leftmost_term() const override { return left_->leftmost_term(); }
 
     void collect_diags() const override
@@ -89,6 +97,14 @@ public:
 
     void apply(mach_expr_visitor& visitor) const override { child_->apply(visitor); }
 
+    mach_expr_ptr clone(position_t line_shift) const override
+    {
+        auto result =
+            std::make_unique<mach_expr_unary>(child_->clone(line_shift), shift_lines(get_range(), line_shift));
+        result->diags() = shift_lines(diags(), line_shift);
+        return result;
+    }
+
     const mach_expression* leftmost_term() const override { return child_->leftmost_term(); }
 
     void collect_diags() const override { collect_diags_from_child(*child_); }
@@ -19,6 +19,13 @@
 using namespace hlasm_plugin::parser_library::expressions;
 using namespace hlasm_plugin::parser_library::context;
 
+namespace {
+mach_expr_ptr clone_expr(const mach_expr_ptr& expr, hlasm_plugin::parser_library::position_t line_shift)
+{
+    return expr ? expr->clone(line_shift) : nullptr;
+}
+} // namespace
+
 nominal_value_string* nominal_value_t::access_string() { return dynamic_cast<nominal_value_string*>(this); }
 
 nominal_value_exprs* nominal_value_t::access_exprs() { return dynamic_cast<nominal_value_exprs*>(this); }
@@ -31,6 +38,11 @@ nominal_value_string::nominal_value_string(std::string value, hlasm_plugin::pars
     , value_range(rng)
 {}
 
+nominal_value_ptr nominal_value_string::clone(position_t line_shift) const
+{
+    return std::make_unique<nominal_value_string>(value, shift_lines(value_range, line_shift));
+}
+
 //*********** nominal_value_exprs ***************
 dependency_collector nominal_value_exprs::get_dependencies(dependency_solver& solver) const
 {
@@ -52,6 +64,20 @@ nominal_value_exprs::nominal_value_exprs(expr_or_address_list exprs)
     : exprs(std::move(exprs))
 {}
 
+nominal_value_ptr nominal_value_exprs::clone(position_t line_shift) const
+{
+    expr_or_address_list result;
+    result.reserve(exprs.size());
+    for (const auto& e : exprs)
+    {
+        if (std::holds_alternative<mach_expr_ptr>(e))
+            result.emplace_back(clone_expr(std::get<mach_expr_ptr>(e), line_shift));
+        else
+            result.emplace_back(std::get<address_nominal>(e).clone(line_shift));
+    }
+    return std::make_unique<nominal_value_exprs>(std::move(result));
+}
+
 
 
 //*********** nominal_value_list ***************
@@ -74,3 +100,8 @@ address_nominal::address_nominal(mach_expr_ptr displacement, mach_expr_ptr base)
     : displacement(std::move(displacement))
     , base(std::move(base))
 {}
+
+address_nominal address_nominal::clone(position_t line_shift) const
+{
+    return address_nominal(clone_expr(displacement, line_shift), clone_expr(base, line_shift));
+}
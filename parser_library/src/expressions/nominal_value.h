@@ -29,6 +29,8 @@ struct nominal_value_t : public context::dependable
     nominal_value_string* access_string();
     nominal_value_exprs* access_exprs();
 
+    virtual std::unique_ptr<nominal_value_t> clone(position_t line_shift = 0) const = 0;
+
     virtual ~nominal_value_t() = default;
 };
 
@@ -39,6 +41,9 @@ struct nominal_value_string final : public nominal_value_t
     context::dependency_collector get_dependencies(context::dependency_solver& solver) const override;
 
     nominal_value_string(std::string value, range rng);
+
+    nominal_value_ptr clone(position_t line_shift) const override;
+
     std::string value;
     range value_range;
 };
@@ -49,6 +54,9 @@ struct address_nominal : public context::dependable
     context::dependency_collector get_dependencies(context::dependency_solver& solver) const override;
     address_nominal();
     address_nominal(mach_expr_ptr displacement, mach_expr_ptr base);
+
+    address_nominal clone(position_t line_shift = 0) const;
+
     mach_expr_ptr displacement;
     mach_expr_ptr base;
 };
@@ -61,6 +69,9 @@ struct nominal_value_exprs final : public nominal_value_t
     context::dependency_collector get_dependencies(context::dependency_solver& solver) const override;
 
     nominal_value_exprs(expr_or_address_list exprs);
+
+    nominal_value_ptr clone(position_t line_shift) const override;
+
     expr_or_address_list exprs;
 };
 
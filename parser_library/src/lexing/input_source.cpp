@@ -14,92 +14,162 @@
 
 #include "input_source.h"
 
-#include <exception>
+#include <cassert>
+#include <utility>
 
 namespace hlasm_plugin::parser_library::lexing {
 
+namespace {
+bool continuation_byte(unsigned char c) { return (c & 0xC0) == 0x80; }
 
-input_source::input_source(const std::string& input)
-    : ANTLRInputStream(input)
+// length of the UTF-8 sequence by its first byte, invalid bytes are taken as single characters
+size_t sequence_length(unsigned char c)
+{
+    if (c < 0x80)
+        return 1;
+    if ((c & 0xE0) == 0xC0)
+        return 2;
+    if ((c & 0xF0) == 0xE0)
+        return 3;
+    if ((c & 0xF8) == 0xF0)
+        return 4;
+    return 1;
+}
+} // namespace
+
+input_source::input_source(std::string input)
+    : data_(std::move(input))
 {}
 
-void input_source::append(const UTF32String& str) { _data.append(str); }
+void input_source::append(const std::string& str) { data_.append(str); }
 
-void input_source::append(const std::string& str)
+void input_source::reset(std::string str)
 {
-    p = _data.size();
-    _data.append(antlrcpp::utf8_to_utf32(str.data(), str.data() + str.size()));
+    data_ = std::move(str);
+    p_ = 0;
 }
 
-void input_source::reset(const std::string& str) { load(str); }
-
-std::string input_source::getText(const antlr4::misc::Interval& interval)
+size_t input_source::next_character(std::string_view text, size_t index)
 {
-    std::string n;
-    for (auto i = interval.a; i <= interval.b; ++i)
-    {
-        uint32_t ch = _data[i];
-        constexpr unsigned int last6 = 0x3F;
-        constexpr unsigned int last5 = 0x1F;
-        constexpr unsigned int last4 = 0x0F;
-        constexpr unsigned int last3 = 0x07;
-        if (ch <= 0x007F) // U+0000 - U+007F
-            n.insert(n.end(), (char)ch);
-        else if (ch <= 0x7FF) // U+0080 - U+07FF
-        {
-            char utf8[2];
-            utf8[1] = '\x80'; // 10xxxxxx
-            utf8[1] += ch & last6;
+    // ascii fast path
+    if ((unsigned char)text[index] < 0x80)
+        return index + 1;
+
+    size_t length = sequence_length(text[index]);
+    size_t end = index + 1;
+    while (end < index + length && end < text.size() && continuation_byte(text[end]))
+        ++end;
+    return end;
+}
 
-            ch = ch >> 6;
-            utf8[0] = '\xc0'; // 110xxxxx
-            utf8[0] += ch & last5;
+size_t input_source::next(size_t index) const { return next_character(data_, index); }
 
-            n.append(utf8, 2);
-        }
-        else if (ch <= 0xFFFF) // U+0800 - U+FFFF
-        {
-            char utf8[3];
-            // third
-            utf8[2] = '\x80';
-            utf8[2] += ch & last6;
+size_t input_source::previous(size_t index) const
+{
+    --index;
+    while (index > 0 && continuation_byte(data_[index]))
+        --index;
+    return index;
+}
 
-            ch = ch >> 6;
-            // second
-            utf8[1] = '\x80';
-            utf8[1] += ch & last6;
+char32_t input_source::decode(size_t index) const
+{
+    unsigned char c = data_[index];
+    if (c < 0x80)
+        return c;
+
+    size_t length = next(index) - index;
+    if (length != sequence_length(c))
+        return c;
+
+    constexpr unsigned char first_byte_mask[] = { 0, 0, 0x1F, 0x0F, 0x07 };
+    char32_t ch = c & first_byte_mask[length];
+    for (size_t i = 1; i < length; ++i)
+        ch = (ch << 6) | (data_[index + i] & 0x3F);
+    return ch;
+}
 
-            ch = ch >> 6;
-            utf8[0] = '\xe0';
-            utf8[0] += ch & last4;
+void input_source::consume()
+{
+    if (p_ >= data_.size())
+        throw antlr4::IllegalStateException("cannot consume EOF");
+    p_ = next(p_);
+}
 
-            n.append(utf8, 3);
-        }
-        else if (ch <= 0x10FFFF) // U+10000 - U+10FFFF
+size_t input_source::LA(ssize_t i)
+{
+    if (i == 0)
+        return 0;
+
+    size_t index = p_;
+    if (i < 0)
+    {
+        for (; i < 0; ++i)
         {
-            char utf8[4];
-            for (int j = 3; j > 0; --j)
-            {
-                utf8[j] = '\x80';
-                utf8[j] += ch & last6;
-                ch = ch >> 6;
-            }
-
-            utf8[0] = '\xf0'; // 11110xxx
-            utf8[0] += ch & last3;
-
-            n.append(utf8, 4);
+            if (index == 0)
+                return EOF;
+            index = previous(index);
         }
-        else
-            throw std::runtime_error("not valid unicode character");
     }
-    return n;
+    else
+    {
+        for (; i > 1 && index < data_.size(); --i)
+            index = next(index);
+    }
+
+    if (index >= data_.size())
+        return EOF;
+    return decode(index);
+}
+
+ssize_t input_source::mark() { return -1; }
+
+void input_source::release(ssize_t) {}
+
+size_t input_source::index() { return p_; }
+
+void input_source::seek(size_t index)
+{
+    // the index must point to the beginning of a character
+    p_ = std::min(index, data_.size());
+}
+
+size_t input_source::size() { return data_.size(); }
+
+std::string input_source::getSourceName() const { return UNKNOWN_SOURCE_NAME; }
+
+std::string input_source::getText(const antlr4::misc::Interval& interval)
+{
+    if (interval.a < 0 || interval.b < interval.a || (size_t)interval.a >= data_.size())
+        return "";
+
+    // the interval ends with the character that contains the byte at its end
+    size_t begin = (size_t)interval.a;
+    size_t end = std::min((size_t)interval.b + 1, data_.size());
+    while (end < data_.size() && continuation_byte(data_[end]))
+        ++end;
+
+    return data_.substr(begin, end - begin);
+}
+
+std::string input_source::toString() const { return data_; }
+
+std::string_view input_source::rest() const { return std::string_view(data_).substr(std::min(p_, data_.size())); }
+
+std::string_view input_source::text() const { return data_; }
+
+size_t input_source::characters(size_t begin, size_t end) const
+{
+    size_t count = 0;
+    for (size_t i = begin; i < end && i < data_.size(); ++i)
+        count += !continuation_byte(data_[i]);
+    return count;
 }
 
 void input_source::rewind_input(size_t position)
 {
-    assert(position < _data.length());
-    p = position;
+    assert(position < data_.size());
+    p_ = position;
 }
 
-} // namespace hlasm_plugin::parser_library::lexing
\ No newline at end of file
+} // namespace hlasm_plugin::parser_library::lexing
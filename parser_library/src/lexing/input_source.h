@@ -15,24 +15,26 @@
 #ifndef HLASMPLUGIN_PARSER_HLASMINPUTSOURCE_H
 #define HLASMPLUGIN_PARSER_HLASMINPUTSOURCE_H
 
+#include <string>
+#include <string_view>
+
 #include "antlr4-runtime.h"
 
 #include "parser_library_export.h"
 
 namespace hlasm_plugin::parser_library::lexing {
 /*
-        custom ANTLRInputStream
+        custom CharStream working directly on UTF-8 text
         supports input rewinding, appending and resetting
+        stream indices are byte offsets into the text, LA returns whole code points
 */
-class input_source : public antlr4::ANTLRInputStream
+class input_source final : public antlr4::CharStream
 {
 public:
-    input_source(const std::string& input);
+    input_source(std::string input);
 
-    void append(const UTF32String& str);
     void append(const std::string& str);
-    using antlr4::ANTLRInputStream::reset;
-    void reset(const std::string& str);
+    void reset(std::string str);
     void rewind_input(size_t index);
 
     input_source(const input_source&) = delete;
@@ -40,9 +42,36 @@ public:
     input_source& operator=(input_source&&) = delete;
     input_source(input_source&&) = delete;
 
+    void consume() override;
+    size_t LA(ssize_t i) override;
+    ssize_t mark() override;
+    void release(ssize_t marker) override;
+    size_t index() override;
+    void seek(size_t index) override;
+    size_t size() override;
+    std::string getSourceName() const override;
     std::string getText(const antlr4::misc::Interval& interval) override;
+    std::string toString() const override;
+
+    // returns the text from the current position to the end of the input
+    std::string_view rest() const;
+    // returns the whole text of the input
+    std::string_view text() const;
+    // returns the number of characters between the stream indices
+    size_t characters(size_t begin, size_t end) const;
 
     virtual ~input_source() = default;
+
+    // returns the index of the character that follows the one at the index of the UTF-8 text
+    static size_t next_character(std::string_view text, size_t index);
+
+private:
+    std::string data_;
+    size_t p_ = 0;
+
+    size_t next(size_t index) const;
+    size_t previous(size_t index) const;
+    char32_t decode(size_t index) const;
 };
 
 } // namespace hlasm_plugin::parser_library::lexing
@@ -28,13 +28,6 @@ using namespace parser_library;
 using namespace lexing;
 
 
-/* UTF8 <-> UTF32 */
-#ifdef __GNUG__
-thread_local std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> converter;
-#elif _MSC_VER
-thread_local std::wstring_convert<std::codecvt_utf8<int32_t>, int32_t> converter;
-#endif
-
 lexer::lexer(input_source* input, semantics::source_info_processor* lsp_proc, performance_metrics* metrics)
     : input_(input)
     , src_proc_(lsp_proc)
@@ -68,6 +61,7 @@ void lexer::rewind_input(stream_position pos)
 
     file_input_state_.char_position = pos.offset;
     file_input_state_.line = pos.line;
+    file_input_state_.line_begin = pos.offset;
     file_input_state_.char_position_in_line = 0;
     file_input_state_.char_position_in_line_utf16 = 0;
 
@@ -83,10 +77,14 @@ void lexer::rewind_input(stream_position pos)
 
 bool lexer::is_last_line() const
 {
-    for (size_t i = 1; input_->LA(i) != antlr4::CharStream::EOF && i < 100; i++)
+    // line terminators never occur inside of multi-byte characters
+    auto rest = file_input_state_.input->rest();
+    size_t characters = 0;
+    for (size_t i = 0; i < rest.size() && characters < 99; ++i)
     {
-        if (input_->LA(i) == '\n' || input_->LA(i) == '\r')
+        if (rest[i] == '\n' || rest[i] == '\r')
             return false;
+        characters += char_start_utf8((unsigned char)rest[i]);
     }
     return true;
 }
@@ -101,6 +99,8 @@ void lexer::set_unlimited_line(bool unlimited_lines) { unlimited_line_ = unlimit
 void lexer::set_file_offset(position file_offset)
 {
     input_state_->line = (size_t)file_offset.line;
+    // the text in front of the offset is not part of the input, the line starts with it
+    input_state_->line_begin = input_state_->char_position;
     input_state_->char_position_in_line = (size_t)file_offset.column;
     input_state_->char_position_in_line_utf16 = (size_t)file_offset.column;
 }
@@ -110,6 +110,7 @@ void lexer::reset()
     token_queue_ = {};
     last_token_id_ = 0;
     input_state_->char_position = 0;
+    input_state_->line_begin = 0;
     file_input_state_.c = static_cast<char_t>(input_->LA(1));
     eof_generated_ = false;
 }
@@ -185,7 +186,8 @@ void lexer::create_token(size_t ttype, size_t channel = Channels::DEFAULT_CHANNE
         token_start_state_.char_position_in_line,
         last_token_id_ - 1,
         token_start_state_.char_position_in_line_utf16,
-        input_state_->char_position_in_line_utf16));
+        input_state_->char_position_in_line_utf16,
+        input_state_->characters - token_start_state_.characters));
 
     auto stop_position_in_line = last_char_utf16_long_ ? input_state_->char_position_in_line_utf16 - 1
                                                        : input_state_->char_position_in_line_utf16;
@@ -231,10 +233,12 @@ void lexer::consume()
     if (input_state_->c != static_cast<char_t>(-1))
     {
         input_state_->input->consume();
-        input_state_->char_position++;
+        input_state_->char_position = input_state_->input->index();
         input_state_->c = static_cast<char_t>(input_state_->input->LA(1));
+        ++input_state_->characters;
 
-        input_state_->char_position_in_line++;
+        if (++input_state_->char_position_in_line == 0)
+            input_state_->line_begin = input_state_->char_position;
         if (input_state_->c == static_cast<char32_t>(-1))
         {
             last_char_utf16_long_ = false;
@@ -253,6 +257,32 @@ void lexer::consume()
     }
 }
 
+void lexer::consume_to_column(size_t column)
+{
+    if (input_state_->char_position_in_line >= column)
+        return;
+
+    const auto rest = input_state_->input->rest();
+    const auto line = rest.substr(0, text_scan::find_new_line(rest, 0));
+    const auto span = line.substr(0, text_scan::column_offset(line, column - input_state_->char_position_in_line));
+    if (span.empty())
+        return;
+
+    // all the characters but the last one are skipped at once, the last one is consumed to update the state
+    const size_t skipped_characters = text_scan::characters(span) - 1;
+    const auto skipped = span.substr(0, text_scan::column_offset(span, skipped_characters));
+
+    input_state_->input->seek(input_state_->input->index() + skipped.size());
+    input_state_->char_position = input_state_->input->index();
+    input_state_->char_position_in_line += skipped_characters;
+    input_state_->characters += skipped_characters;
+    // consume counts the code units of the character it moves to
+    input_state_->char_position_in_line_utf16 +=
+        text_scan::utf16_units(span.substr(input_source::next_character(span, 0)));
+    input_state_->c = static_cast<char_t>(input_state_->input->LA(1));
+    consume();
+}
+
 bool lexer::from_buffer() const { return &buffer_input_state_ == input_state_; }
 
 bool lexer::eof() const { return input_->LA(1) == CharStream::EOF && ainsert_stream_->LA(1) == CharStream::EOF; }
@@ -267,8 +297,7 @@ void lexer::switch_input_streams()
 
     if (!ainsert_buffer_.empty())
     {
-        UTF32String f = ainsert_buffer_.front();
-        ainsert_stream_->append(f);
+        ainsert_stream_->append(ainsert_buffer_.front());
         ainsert_buffer_.pop_front();
         if (input_state_->input != ainsert_stream_.get())
         {
@@ -488,16 +517,14 @@ bool lexer::identifier_divider() const
 void lexer::lex_begin()
 {
     start_token();
-    while (input_state_->char_position_in_line < begin_ && !eof() && input_state_->c != '\n')
-        consume();
+    consume_to_column(begin_);
     create_token(IGNORED, HIDDEN_CHANNEL);
 }
 
 void lexer::lex_end(bool eolln)
 {
     start_token();
-    while (input_state_->c != '\n' && !eof() && input_state_->c != (char_t)-1)
-        consume();
+    consume_to_column(static_cast<size_t>(-1));
 
     if (!eof())
     {
@@ -516,8 +543,7 @@ void lexer::lex_comment()
     while (true)
     {
         start_token();
-        while (input_state_->char_position_in_line < end_ && !eof() && input_state_->c != '\n')
-            consume();
+        consume_to_column(end_);
         create_token(COMMENT, HIDDEN_CHANNEL);
 
         if (!isspace(input_state_->c) && !eof() && continuation_enabled_)
@@ -560,8 +586,7 @@ void lexer::lex_continuation()
 
     /* lex continuation */
     start_token();
-    while (input_state_->char_position_in_line < continue_ && !eof() && input_state_->c != '\n')
-        consume();
+    consume_to_column(continue_);
     create_token(IGNORED, HIDDEN_CHANNEL);
 }
 
@@ -721,7 +746,8 @@ void lexer::insert_EOLLN()
         token_start_state_.char_position_in_line,
         last_token_id_ - 1,
         token_start_state_.char_position_in_line_utf16,
-        input_state_->char_position_in_line_utf16));
+        input_state_->char_position_in_line_utf16,
+        input_state_->characters - token_start_state_.characters));
 
     eof_generated_ = false;
 }
@@ -793,12 +819,11 @@ std::string lexer::aread()
         return "";
 
     if (file_input_state_.char_position_in_line)
-        rewind_input(stream_position { file_input_state_.line,
-            file_input_state_.char_position
-                - file_input_state_.char_position_in_line }); // make sure we read the WHOLE line
+        rewind_input(stream_position {
+            file_input_state_.line, file_input_state_.line_begin }); // make sure we read the WHOLE line
     if (from_buffer() && buffer_input_state_.char_position_in_line)
     {
-        buffer_input_state_.char_position -= buffer_input_state_.char_position_in_line;
+        buffer_input_state_.char_position = buffer_input_state_.line_begin;
         buffer_input_state_.char_position_in_line = 0;
         buffer_input_state_.char_position_in_line_utf16 = 0;
         buffer_input_state_.input->rewind_input(buffer_input_state_.char_position);
@@ -807,10 +832,11 @@ std::string lexer::aread()
 
     start_token();
     while (!eof() && input_state_->c != '\r' && input_state_->c != '\n' && input_state_->c != static_cast<char_t>(-1))
-    {
-        str.append(converter.to_bytes(input_state_->c));
         consume();
-    }
+    // the stream indices are byte offsets, so the line is taken from the input as it is
+    if (token_start_state_.char_position != input_state_->char_position)
+        str = input_state_->input->getText(antlr4::misc::Interval(
+            token_start_state_.char_position, input_state_->char_position - 1));
     consume_new_line();
 
     if (input_state_ == &file_input_state_)
@@ -827,18 +853,24 @@ std::string lexer::aread()
 
 std::unique_ptr<input_source>& lexer::get_ainsert_stream() { return ainsert_stream_; }
 
+bool lexer::ainsert_pending() const { return !ainsert_buffer_.empty() || ainsert_stream_->LA(1) != CharStream::EOF; }
+
+source_format lexer::get_source_format() const { return { begin_, end_default_, continue_, continuation_enabled_ }; }
+
+std::string_view lexer::file_text() const { return file_input_state_.input->text(); }
+
 void lexer::ainsert_back(const std::string& back) { ainsert(back, false); }
 
 void lexer::ainsert_front(const std::string& back) { ainsert(back, true); }
 
 void lexer::ainsert(const std::string& inp, bool front)
 {
-    auto s = converter.from_bytes(inp);
-    UTF32String str(s.begin(), s.end());
-    if (str.size())
+    if (inp.size())
     {
-        if (str.size() < 80)
-            str.resize(80, ' ');
+        std::string str = inp;
+        size_t length = std::count_if(inp.begin(), inp.end(), [](unsigned char c) { return char_start_utf8(c); });
+        if (length < 80)
+            str.append(80 - length, ' ');
         str.push_back('\n');
         if (front)
             ainsert_buffer_.push_front(str);
@@ -846,9 +878,8 @@ void lexer::ainsert(const std::string& inp, bool front)
             ainsert_buffer_.push_back(str);
 
         if (file_input_state_.char_position_in_line)
-            rewind_input(stream_position { file_input_state_.line,
-                file_input_state_.char_position
-                    - file_input_state_.char_position_in_line }); // make sure we read the WHOLE line
+            rewind_input(stream_position {
+                file_input_state_.line, file_input_state_.line_begin }); // make sure we read the WHOLE line
 
         while (token_queue_.size())
             token_queue_.pop();
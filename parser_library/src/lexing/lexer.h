@@ -26,6 +26,7 @@
 #include "parser_library_export.h"
 #include "range.h"
 #include "semantics/source_info_processor.h"
+#include "statement_index.h"
 #include "token.h"
 #include "token_factory.h"
 
@@ -112,6 +113,8 @@ public:
     // executes AREAD instruction; consumes line from input
     std::string aread();
     std::unique_ptr<input_source>& get_ainsert_stream();
+    // are there AINSERTed records to be lexed before the file continues
+    bool ainsert_pending() const;
 
     static bool ord_char(char_t c);
 
@@ -132,11 +135,17 @@ public:
     stream_position last_lln_begin_position() const;
     stream_position last_lln_end_position() const;
 
+    source_format get_source_format() const;
+    // text of the file being lexed
+    std::string_view file_text() const;
+
 protected:
     // creates token and inserts to input stream
     void create_token(size_t ttype, size_t channel);
     // consumes char from input & updates lexer state
     void consume();
+    // consumes the characters up to the column or the end of the line
+    void consume_to_column(size_t column);
 
 private:
     bool eof_generated_ = false;
@@ -147,7 +156,7 @@ private:
     void ainsert(const std::string& inp, bool front);
     std::unique_ptr<input_source> ainsert_stream_;
     // must be dequeue - inserting & poping from both ends
-    std::deque<UTF32String> ainsert_buffer_;
+    std::deque<std::string> ainsert_buffer_;
 
     std::set<size_t> tokens_after_continuation_;
     size_t last_token_id_ = 0;
@@ -158,6 +167,8 @@ private:
     stream_position last_lln_end_pos_ = { static_cast<size_t>(-1), static_cast<size_t>(-1) };
     size_t last_line_pos_ = 0;
 
+    // the factory must outlive all the tokens it created
+    std::unique_ptr<token_factory> factory_;
     std::queue<token_ptr> token_queue_;
     Ref<antlr4::CommonTokenFactory> dummy_factory;
 
@@ -172,7 +183,6 @@ private:
 
     size_t tab_size_ = 1;
 
-    std::unique_ptr<token_factory> factory_;
     antlr4::CharStream* input_;
     semantics::source_info_processor* src_proc_;
     performance_metrics* metrics_;
@@ -182,9 +192,14 @@ private:
         input_source* input = nullptr;
         char_t c = 0;
         size_t line = 0;
+        // offset of the current character in the input in bytes
         size_t char_position = 0;
+        // offset of the beginning of the current line in bytes
+        size_t line_begin = 0;
         size_t char_position_in_line = 0;
         size_t char_position_in_line_utf16 = 0;
+        // number of characters consumed so far, the difference gives the length of a token
+        size_t characters = 0;
     };
 
     input_state file_input_state_;
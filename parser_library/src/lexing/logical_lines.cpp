@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "logical_lines.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "input_source.h"
+
+namespace hlasm_plugin::parser_library::lexing {
+
+namespace {
+constexpr size_t word_size = sizeof(std::uint64_t);
+constexpr std::uint64_t high_bits = 0x8080808080808080ULL;
+
+std::uint64_t load_word(const char* data)
+{
+    std::uint64_t word;
+    std::memcpy(&word, data, word_size);
+    return word;
+}
+
+// the text at the index starts with a whole word of ASCII characters
+bool ascii_word(std::string_view text, size_t index)
+{
+    return index + word_size <= text.size() && (load_word(text.data() + index) & high_bits) == 0;
+}
+
+bool is_space(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r'; }
+
+// the character takes two UTF-16 code units, the same way as the input source decodes it
+bool supplementary(std::string_view text, size_t index, size_t length)
+{
+    if (length != 4)
+        return false;
+    const auto byte = [text, index](size_t i) { return (std::uint32_t)(unsigned char)text[index + i]; };
+    return (((byte(0) & 0x07) << 18) | ((byte(1) & 0x3F) << 12) | ((byte(2) & 0x3F) << 6) | (byte(3) & 0x3F))
+        > 0xFFFF;
+}
+} // namespace
+
+size_t text_scan::find_new_line(std::string_view text, size_t offset)
+{
+    // single character search ends in memchr, which the standard libraries vectorize
+    auto pos = text.find('\n', offset);
+    return pos == std::string_view::npos ? text.size() : pos;
+}
+
+bool text_scan::ascii(std::string_view text)
+{
+    std::uint64_t bits = 0;
+    size_t i = 0;
+    for (; i + word_size <= text.size(); i += word_size)
+        bits |= load_word(text.data() + i);
+    for (; i < text.size(); ++i)
+        bits |= (unsigned char)text[i];
+    return (bits & high_bits) == 0;
+}
+
+size_t text_scan::column_offset(std::string_view line, size_t column)
+{
+    // there are never more characters than bytes
+    if (column >= line.size())
+        return line.size();
+    if (ascii(line.substr(0, column)))
+        return column;
+
+    size_t offset = 0;
+    for (size_t i = 0; i < column && offset < line.size(); ++i)
+        offset = input_source::next_character(line, offset);
+    return offset;
+}
+
+size_t text_scan::characters(std::string_view text)
+{
+    size_t count = 0;
+    size_t i = 0;
+    while (i < text.size())
+    {
+        if (ascii_word(text, i))
+        {
+            i += word_size;
+            count += word_size;
+            continue;
+        }
+        i = input_source::next_character(text, i);
+        ++count;
+    }
+    return count;
+}
+
+size_t text_scan::utf16_units(std::string_view text)
+{
+    size_t count = 0;
+    size_t i = 0;
+    while (i < text.size())
+    {
+        if (ascii_word(text, i))
+        {
+            i += word_size;
+            count += word_size;
+            continue;
+        }
+        size_t next = input_source::next_character(text, i);
+        count += supplementary(text, i, next - i) ? 2 : 1;
+        i = next;
+    }
+    return count;
+}
+
+logical_lines::logical_lines(std::string_view text, const source_format& format)
+    : format_(format)
+{
+    if (!split(text))
+    {
+        lines_.clear();
+        statements_.clear();
+    }
+}
+
+bool logical_lines::split(std::string_view text)
+{
+    // the lexer ends a statement at a lone carriage return without starting a new line
+    for (size_t i = text.find('\r'); i != std::string_view::npos; i = text.find('\r', i + 1))
+        if (i + 1 == text.size() || text[i + 1] != '\n')
+            return false;
+
+    bool continued = false;
+    size_t offset = 0;
+    while (offset < text.size())
+    {
+        const size_t end = text_scan::find_new_line(text, offset);
+        const auto line = text.substr(offset, end - offset);
+
+        if (!continued)
+            statements_.push_back({ lines_.size(), 0 });
+        lines_.push_back({ offset, line.size() });
+        ++statements_.back().count;
+
+        continued = false;
+        if (const size_t end_offset = text_scan::column_offset(line, format_.end); end_offset < line.size())
+        {
+            // the lexer decides about the continuation by the whole character
+            if ((unsigned char)line[end_offset] >= 0x80)
+                return false;
+            continued = format_.continuation_enabled && !is_space(line[end_offset]);
+        }
+
+        offset = end + 1;
+    }
+    return true;
+}
+
+} // namespace hlasm_plugin::parser_library::lexing
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#ifndef HLASMPLUGIN_PARSERLIBRARY_LOGICAL_LINES_H
+#define HLASMPLUGIN_PARSERLIBRARY_LOGICAL_LINES_H
+
+#include <string_view>
+#include <vector>
+
+namespace hlasm_plugin::parser_library::lexing {
+
+// columns of the source statements as set by ICTL
+struct source_format
+{
+    size_t begin = 0;
+    size_t end = 71;
+    size_t continuation = 15;
+    bool continuation_enabled = true;
+
+    bool operator==(const source_format& oth) const
+    {
+        return begin == oth.begin && end == oth.end && continuation == oth.continuation
+            && continuation_enabled == oth.continuation_enabled;
+    }
+    bool operator!=(const source_format& oth) const { return !(*this == oth); }
+};
+
+// physical line of the text, the offset and the length are in bytes and the length excludes the new line
+struct line_span
+{
+    size_t offset;
+    size_t length;
+};
+
+// logical line (statement) made of the physical lines joined by continuations
+struct logical_line_span
+{
+    // index of the first physical line and the number of the lines
+    size_t first;
+    size_t count;
+};
+
+// scanning of the source text by whole machine words instead of single characters
+namespace text_scan {
+// returns the offset of the first new line character at or after the offset, the size of the text when there is none
+size_t find_new_line(std::string_view text, size_t offset);
+// returns true if the text contains only ASCII characters
+bool ascii(std::string_view text);
+// returns the offset of the column in the line, or the length of the line when it is shorter
+size_t column_offset(std::string_view line, size_t column);
+// returns the number of characters and the number of UTF-16 code units of the text
+size_t characters(std::string_view text);
+size_t utf16_units(std::string_view text);
+} // namespace text_scan
+
+// splits the text into the logical lines the same way as the lexer, without lexing it
+// the table can be shared by anything that needs the statement boundaries, e.g. the lookahead pre-scan
+class logical_lines
+{
+public:
+    // the table stays empty when the text cannot be split reliably
+    logical_lines(std::string_view text, const source_format& format);
+
+    const source_format& format() const { return format_; }
+    const std::vector<line_span>& lines() const { return lines_; }
+    const std::vector<logical_line_span>& statements() const { return statements_; }
+
+private:
+    source_format format_;
+    std::vector<line_span> lines_;
+    std::vector<logical_line_span> statements_;
+
+    bool split(std::string_view text);
+};
+
+} // namespace hlasm_plugin::parser_library::lexing
+
+#endif
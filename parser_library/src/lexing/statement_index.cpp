@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "statement_index.h"
+
+#include <algorithm>
+
+#include "lexer.h"
+
+namespace hlasm_plugin::parser_library::lexing {
+
+namespace {
+context::id_index instruction_id(std::string_view word, context::id_storage& ids)
+{
+    if (word.size() > 63 || (word.front() >= '0' && word.front() <= '9'))
+        return nullptr;
+    for (char c : word)
+        if ((unsigned char)c >= 0x80 || !lexer::ord_char(c))
+            return nullptr;
+    return ids.add(std::string(word));
+}
+
+// reads the label and instruction fields from the first physical line of the statement
+void read_fields(indexed_statement& stmt, std::string_view line, const source_format& format, context::id_storage& ids)
+{
+    size_t i = text_scan::column_offset(line, format.begin);
+    if (i == line.size() || line[i] == '\r')
+        return;
+
+    const char c = line[i];
+    if (c == '*' || (c == '.' && i + 1 < line.size() && line[i + 1] == '*'))
+        return;
+    if (c != ' ')
+    {
+        stmt.has_label = true;
+        return;
+    }
+
+    // the instruction may continue on the next line when it reaches the end column
+    const size_t end = text_scan::column_offset(line, format.end);
+    const bool truncated = end < line.size();
+    const auto fields = line.substr(0, end);
+
+    const size_t word_begin = fields.find_first_not_of(' ', i);
+    if (word_begin == std::string_view::npos)
+    {
+        if (truncated)
+            stmt.instruction = nullptr;
+        return;
+    }
+
+    const size_t word_end = fields.find_first_of(" \r", word_begin);
+    if (word_end == std::string_view::npos && truncated)
+        stmt.instruction = nullptr;
+    else if (word_end != word_begin)
+        stmt.instruction = instruction_id(fields.substr(word_begin, word_end - word_begin), ids);
+}
+} // namespace
+
+statement_index::statement_index(std::string_view text, const source_format& format, context::id_storage& ids)
+    : lines_(text, format)
+{
+    const auto& lines = lines_.lines();
+    statements_.reserve(lines_.statements().size());
+    for (const auto& stmt : lines_.statements())
+    {
+        const auto& first = lines[stmt.first];
+        auto& indexed =
+            statements_.emplace_back(indexed_statement { stmt.first, first.offset, false, context::id_storage::empty_id });
+        read_fields(indexed, text.substr(first.offset, first.length), lines_.format(), ids);
+    }
+}
+
+size_t statement_index::find(size_t offset) const
+{
+    auto it = std::lower_bound(statements_.begin(),
+        statements_.end(),
+        offset,
+        [](const indexed_statement& stmt, size_t offset) { return stmt.offset < offset; });
+
+    if (it == statements_.end() || it->offset != offset)
+        return statements_.size();
+    return it - statements_.begin();
+}
+
+} // namespace hlasm_plugin::parser_library::lexing
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#ifndef HLASMPLUGIN_PARSERLIBRARY_STATEMENT_INDEX_H
+#define HLASMPLUGIN_PARSERLIBRARY_STATEMENT_INDEX_H
+
+#include <string_view>
+#include <vector>
+
+#include "context/id_storage.h"
+#include "logical_lines.h"
+
+namespace hlasm_plugin::parser_library::lexing {
+
+struct indexed_statement
+{
+    // first physical line of the statement and the offset of its beginning in bytes
+    size_t line;
+    size_t offset;
+    // the label field is not empty
+    bool has_label;
+    // the instruction field when it is an ordinary symbol, empty_id when the field is empty
+    // and nullptr when it cannot be told without lexing
+    context::id_index instruction;
+};
+
+// index of the statements of a source text
+// it looks only at the label and instruction fields of the logical lines, so it is much cheaper than lexing;
+// comment statements are indexed with empty fields
+class statement_index
+{
+public:
+    // the index stays empty when the text cannot be split reliably
+    statement_index(std::string_view text, const source_format& format, context::id_storage& ids);
+
+    const source_format& format() const { return lines_.format(); }
+    const logical_lines& lines() const { return lines_; }
+    const std::vector<indexed_statement>& statements() const { return statements_; }
+
+    // returns the index of the statement beginning at the offset, the number of statements when there is none
+    size_t find(size_t offset) const;
+
+private:
+    logical_lines lines_;
+    std::vector<indexed_statement> statements_;
+};
+
+} // namespace hlasm_plugin::parser_library::lexing
+
+#endif
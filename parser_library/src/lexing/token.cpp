@@ -16,12 +16,18 @@
 
 #include <CharStream.h>
 
+#include "token_factory.h"
+
 #include <misc/Interval.h>
 
 using namespace hlasm_plugin::parser_library::lexing;
 
 size_t token::get_end_of_token_in_line_utf16() const { return end_of_token_in_line_utf16_; }
 
+size_t token::get_char_length() const { return char_length_; }
+
+void token::operator delete(void* p) { token_pool::release(p); }
+
 ::token::token(antlr4::TokenSource* source,
     antlr4::CharStream* input,
     size_t type,
@@ -32,7 +38,8 @@ size_t token::get_end_of_token_in_line_utf16() const { return end_of_token_in_li
     size_t char_position_in_line,
     size_t token_index,
     size_t char_position_in_line_16,
-    size_t end_of_token_in_line_utf16)
+    size_t end_of_token_in_line_utf16,
+    size_t char_length)
     : source_(source)
     , input_(input)
     , type_(type)
@@ -44,6 +51,7 @@ size_t token::get_end_of_token_in_line_utf16() const { return end_of_token_in_li
     , token_index_(token_index)
     , char_position_in_line_16_(char_position_in_line_16)
     , end_of_token_in_line_utf16_(end_of_token_in_line_utf16)
+    , char_length_(char_length)
 {}
 
 std::string token::getText() const
@@ -37,7 +37,14 @@ public:
         size_t char_position_in_line,
         size_t token_index,
         size_t char_position_in_line_16,
-        size_t end_of_token_in_line_utf16);
+        size_t end_of_token_in_line_utf16,
+        size_t char_length);
+
+    // tokens are allocated only by the token_factory, the deleted ones return to its pool
+    static void* operator new(size_t) = delete;
+    static void* operator new(size_t, void* place) noexcept { return place; }
+    static void operator delete(void* p);
+
     std::string getText() const override;
 
     size_t getType() const override;
@@ -64,6 +71,9 @@ public:
 
     size_t get_end_of_token_in_line_utf16() const;
 
+    // length of the token in characters, the start and stop indices are byte offsets into utf-8 text
+    size_t get_char_length() const;
+
 private:
     antlr4::TokenSource* source_ {};
     antlr4::CharStream* input_ {};
@@ -76,6 +86,7 @@ private:
     size_t token_index_;
     size_t char_position_in_line_16_;
     size_t end_of_token_in_line_utf16_;
+    size_t char_length_;
 };
 
 } // namespace hlasm_plugin::parser_library::lexing
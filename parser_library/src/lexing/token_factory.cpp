@@ -15,11 +15,44 @@
 #include "token_factory.h"
 
 #include <assert.h>
+#include <cstddef>
 
 using namespace hlasm_plugin;
 using namespace parser_library;
 using namespace lexing;
 
+token_pool::~token_pool() { assert(allocated_ == 0); }
+
+void* token_pool::allocate()
+{
+    ++allocated_;
+    if (!free_slots_.empty())
+    {
+        auto s = free_slots_.back();
+        free_slots_.pop_back();
+        return s->storage;
+    }
+
+    if (used_in_last_chunk_ == chunk_size)
+    {
+        chunks_.emplace_back(new slot[chunk_size]);
+        used_in_last_chunk_ = 0;
+    }
+    auto s = &chunks_.back()[used_in_last_chunk_++];
+    s->owner = this;
+    return s->storage;
+}
+
+void token_pool::release(void* p)
+{
+    if (!p)
+        return;
+    auto s = reinterpret_cast<slot*>(static_cast<unsigned char*>(p) - offsetof(slot, storage));
+    auto pool = s->owner;
+    --pool->allocated_;
+    pool->free_slots_.push_back(s);
+}
+
 token_factory::token_factory() = default;
 
 token_factory::~token_factory() = default;
@@ -34,9 +67,10 @@ std::unique_ptr<token> token_factory::create(antlr4::TokenSource* source,
     size_t char_position_in_line,
     size_t index,
     size_t char_position_in_line_16,
-    size_t end_of_token_in_line_utf16)
+    size_t end_of_token_in_line_utf16,
+    size_t char_length)
 {
-    return std::make_unique<token>(source,
+    return std::unique_ptr<token>(new (pool_.allocate()) token(source,
         stream,
         type,
         channel,
@@ -46,5 +80,6 @@ std::unique_ptr<token> token_factory::create(antlr4::TokenSource* source,
         char_position_in_line,
         index,
         char_position_in_line_16,
-        end_of_token_in_line_utf16);
+        end_of_token_in_line_utf16,
+        char_length));
 }
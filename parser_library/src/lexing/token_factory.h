@@ -16,6 +16,7 @@
 #define HLASMPLUGIN_PARSER_HLASMHTF_H
 
 #include <memory>
+#include <vector>
 
 #include "antlr4-runtime.h"
 
@@ -25,6 +26,38 @@
 
 namespace hlasm_plugin::parser_library::lexing {
 
+// Memory pool for the tokens of one lexer. A deleted token returns its slot to the pool for reuse,
+// the memory is released all at once together with the pool, which must outlive all its tokens.
+class token_pool
+{
+    struct slot
+    {
+        token_pool* owner;
+        alignas(token) unsigned char storage[sizeof(token)];
+    };
+    static constexpr size_t chunk_size = 1024;
+
+    std::vector<std::unique_ptr<slot[]>> chunks_;
+    size_t used_in_last_chunk_ = chunk_size;
+    std::vector<slot*> free_slots_;
+    size_t allocated_ = 0;
+
+public:
+    token_pool() = default;
+
+    token_pool(const token_pool&) = delete;
+    token_pool& operator=(const token_pool&) = delete;
+    token_pool& operator=(token_pool&&) = delete;
+    token_pool(token_pool&&) = delete;
+
+    ~token_pool();
+
+    // returns storage for one token
+    void* allocate();
+    // returns the storage obtained from allocate back to its pool
+    static void release(void* p);
+};
+
 class token_factory
 {
 public:
@@ -47,7 +80,11 @@ public:
         size_t char_position_in_line,
         size_t index,
         size_t char_position_in_line_16,
-        size_t end_of_token_in_line_utf16);
+        size_t end_of_token_in_line_utf16,
+        size_t char_length);
+
+private:
+    token_pool pool_;
 };
 
 } // namespace hlasm_plugin::parser_library::lexing
@@ -106,6 +106,13 @@ void lsp_context::add_opencode(opencode_info_ptr opencode_i, text_data_ref_t tex
     distribute_file_occurences(opencode_->file_occurences);
 }
 
+macro_info_ptr lsp_context::get_macro_info(const context::macro_def_ptr& macro_def) const
+{
+    if (auto it = macros_.find(macro_def); it != macros_.end())
+        return it->second;
+    return nullptr;
+}
+
 location lsp_context::definition(const std::string& document_uri, const position pos) const
 {
     auto [occ, macro_scope] = find_occurence_with_scope(document_uri, pos);
@@ -368,6 +375,24 @@ occurence_scope_t lsp_context::find_occurence_with_scope(const std::string& docu
     return std::make_pair(nullptr, nullptr);
 }
 
+macro_info_ptr lsp_context::find_macro(const symbol_occurence& occ) const
+{
+    auto macro_def = occ.opcode;
+    if (!macro_def && occ.macro_by_name && opencode_)
+    {
+        // the macro valid at the end of the analysis
+        const auto& macros = opencode_->hlasm_ctx.macros();
+        if (auto found = macros.find(occ.name); found != macros.end())
+            macro_def = found->second;
+    }
+    if (!macro_def)
+        return nullptr;
+
+    auto it = macros_.find(macro_def);
+    assert(it != macros_.end() || !occ.opcode);
+    return it != macros_.end() ? it->second : nullptr;
+}
+
 std::optional<location> lsp_context::find_definition_location(
     const symbol_occurence& occ, macro_info_ptr macro_scope_i) const
 {
@@ -404,11 +429,8 @@ std::optional<location> lsp_context::find_definition_location(
             break;
         }
         case lsp::occurence_kind::INSTR: {
-            if (occ.opcode)
-            {
-                if (auto it = macros_.find(occ.opcode); it != macros_.end())
-                    return it->second->definition_location;
-            }
+            if (auto macro_i = find_macro(occ))
+                return macro_i->definition_location;
             break;
         }
         case lsp::occurence_kind::COPY_OP: {
@@ -450,12 +472,8 @@ hover_result lsp_context::find_hover(const symbol_occurence& occ, macro_info_ptr
             break;
         }
         case lsp::occurence_kind::INSTR: {
-            if (occ.opcode)
-            {
-                auto it = macros_.find(occ.opcode);
-                assert(it != macros_.end());
-                return get_macro_documentation(*it->second);
-            }
+            if (auto macro_i = find_macro(occ))
+                return get_macro_documentation(*macro_i);
             else
             {
                 auto it = std::find_if(completion_item_s::instruction_completion_items_.begin(),
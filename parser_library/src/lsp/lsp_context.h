@@ -38,6 +38,9 @@ public:
     void add_macro(macro_info_ptr macro_i, text_data_ref_t text_data = text_data_ref_t());
     void add_opencode(opencode_info_ptr opencode_i, text_data_ref_t text_data);
 
+    // returns lsp information about the macro definition or nullptr, if there is none
+    macro_info_ptr get_macro_info(const context::macro_def_ptr& macro_def) const;
+
     location definition(const std::string& document_uri, position pos) const override;
     location_list references(const std::string& document_uri, position pos) const override;
     hover_result hover(const std::string& document_uri, position pos) const override;
@@ -53,6 +56,9 @@ private:
 
     occurence_scope_t find_occurence_with_scope(const std::string& document_uri, const position pos) const;
 
+    // returns the macro called by the instruction occurence or nullptr
+    macro_info_ptr find_macro(const symbol_occurence& occ) const;
+
     std::optional<location> find_definition_location(const symbol_occurence& occ, macro_info_ptr macro_i) const;
     hover_result find_hover(const symbol_occurence& occ, macro_info_ptr macro_i) const;
 
@@ -39,6 +39,8 @@ struct symbol_occurence
 
     // in case of INSTR kind, holds potential macro opcode
     context::macro_def_ptr opcode = nullptr;
+    // the macro opcode was restored from the macro cache before the context knew the macro, it is found by the name
+    bool macro_by_name = false;
 
     symbol_occurence(occurence_kind kind, context::id_index name, const range& occurence_range)
         : kind(kind)
@@ -100,7 +100,8 @@ class error_strategy : public antlr4::DefaultErrorStrategy
             lexing_token.getCharPositionInLine(),
             (size_t)-1,
             lexing_token.get_char_position_in_line_16(),
-            lexing_token.get_end_of_token_in_line_utf16()));
+            lexing_token.get_end_of_token_in_line_utf16(),
+            0));
 
         return _errorSymbols.back().get();
     }
@@ -18,7 +18,7 @@ parser grammar assembler_operand_rules;
 asm_op returns [operand_ptr op]
 	: id lpar asm_op_comma_c rpar
 	{
-		$op = std::make_unique<complex_assembler_operand>(
+		$op = make_arena_unique<complex_assembler_operand>(collector.arena(),
 			*$id.name,std::move($asm_op_comma_c.asm_ops),
 			provider.get_range($id.ctx->getStart(),$rpar.ctx->getStop())
 			);
@@ -34,14 +34,14 @@ asm_op returns [operand_ptr op]
 		language_triplet.push_back(std::make_unique<complex_assembler_operand::string_value_t>(std::move($id1.value), first_range));
 		language_triplet.push_back(std::make_unique<complex_assembler_operand::string_value_t>(std::move($id2.value), second_range));
 		language_triplet.push_back(std::make_unique<complex_assembler_operand::string_value_t>(std::move($id3.value), third_range));
-		$op = std::make_unique<complex_assembler_operand>(
+		$op = make_arena_unique<complex_assembler_operand>(collector.arena(),
 			"",std::move(language_triplet),
 			provider.get_range($lpar.ctx->getStart(),$rpar.ctx->getStop())
 		);
 	}
 	| lpar base=mach_expr comma end=mach_expr rpar
 	{
-		$op = std::make_unique<using_instr_assembler_operand>(
+		$op = make_arena_unique<using_instr_assembler_operand>(collector.arena(),
 			std::move($base.m_e), 
 			std::move($end.m_e),
 			provider.get_range($lpar.ctx->getStart(),$rpar.ctx->getStop())
@@ -51,11 +51,11 @@ asm_op returns [operand_ptr op]
 	{
 		std::string upper_case = $mach_expr.ctx->getText();
 		context::to_upper(upper_case);
-		$op = std::make_unique<expr_assembler_operand>(std::move($mach_expr.m_e),upper_case,provider.get_range($mach_expr.ctx));
+		$op = make_arena_unique<expr_assembler_operand>(collector.arena(), std::move($mach_expr.m_e),upper_case,provider.get_range($mach_expr.ctx));
 	}
 	| string
 	{
-		$op = std::make_unique<string_assembler_operand>(std::move($string.value),provider.get_range($string.ctx));
+		$op = make_arena_unique<string_assembler_operand>(collector.arena(), std::move($string.value),provider.get_range($string.ctx));
 	};
 
 asm_op_inner returns [std::unique_ptr<complex_assembler_operand::component_value_t> op]
@@ -24,14 +24,14 @@ expr returns [ca_expr_ptr ca_expr]
 	{
 		auto r = provider.get_range($begin.ctx->getStart(), $next.ctx->getStop());
 		if ($plus.ctx)
-			$ca_expr = std::make_unique<ca_basic_binary_operator<ca_add>>(std::move($ca_expr), std::move($next.ca_expr), r);
+			$ca_expr = make_arena_unique<ca_basic_binary_operator<ca_add>>(collector.arena(), std::move($ca_expr), std::move($next.ca_expr), r);
 		else
-			$ca_expr = std::make_unique<ca_basic_binary_operator<ca_sub>>(std::move($ca_expr), std::move($next.ca_expr), r);
+			$ca_expr = make_arena_unique<ca_basic_binary_operator<ca_sub>>(collector.arena(), std::move($ca_expr), std::move($next.ca_expr), r);
 		$plus.ctx = nullptr;
 	}
 	)*;
 	finally
-	{if (!$ca_expr) $ca_expr = std::make_unique<ca_constant>(0, provider.get_range(_localctx));}
+	{if (!$ca_expr) $ca_expr = make_arena_unique<ca_constant>(collector.arena(), 0, provider.get_range(_localctx));}
 
 expr_s returns [ca_expr_ptr ca_expr]
 	: begin=term_c								
@@ -42,14 +42,14 @@ expr_s returns [ca_expr_ptr ca_expr]
 	{
 		auto r = provider.get_range($begin.ctx->getStart(), $next.ctx->getStop());
 		if ($slash.ctx)
-			$ca_expr = std::make_unique<ca_basic_binary_operator<ca_div>>(std::move($ca_expr), std::move($next.ca_expr), r);
+			$ca_expr = make_arena_unique<ca_basic_binary_operator<ca_div>>(collector.arena(), std::move($ca_expr), std::move($next.ca_expr), r);
 		else
-			$ca_expr = std::make_unique<ca_basic_binary_operator<ca_mul>>(std::move($ca_expr), std::move($next.ca_expr), r);
+			$ca_expr = make_arena_unique<ca_basic_binary_operator<ca_mul>>(collector.arena(), std::move($ca_expr), std::move($next.ca_expr), r);
 		$slash.ctx = nullptr;
 	}
 	)*;
 	finally
-	{if (!$ca_expr) $ca_expr = std::make_unique<ca_constant>(0, provider.get_range(_localctx));}
+	{if (!$ca_expr) $ca_expr = make_arena_unique<ca_constant>(collector.arena(), 0, provider.get_range(_localctx));}
 
 term_c returns [ca_expr_ptr ca_expr]
 	: term
@@ -59,15 +59,15 @@ term_c returns [ca_expr_ptr ca_expr]
 	| plus tmp=term_c
 	{
 		auto r = provider.get_range($plus.ctx->getStart(), $tmp.ctx->getStop());
-		$ca_expr = std::make_unique<ca_plus_operator>(std::move($tmp.ca_expr), r);
+		$ca_expr = make_arena_unique<ca_plus_operator>(collector.arena(), std::move($tmp.ca_expr), r);
 	}
 	| minus tmp=term_c
 	{
 		auto r = provider.get_range($minus.ctx->getStart(), $tmp.ctx->getStop());
-		$ca_expr = std::make_unique<ca_minus_operator>(std::move($tmp.ca_expr), r);
+		$ca_expr = make_arena_unique<ca_minus_operator>(collector.arena(), std::move($tmp.ca_expr), r);
 	};
 	finally
-	{if (!$ca_expr) $ca_expr = std::make_unique<ca_constant>(0, provider.get_range(_localctx));}
+	{if (!$ca_expr) $ca_expr = make_arena_unique<ca_constant>(collector.arena(), 0, provider.get_range(_localctx));}
 
 term returns [ca_expr_ptr ca_expr]
 	: expr_list
@@ -77,7 +77,7 @@ term returns [ca_expr_ptr ca_expr]
 	| var_symbol
 	{
 		auto r = provider.get_range($var_symbol.ctx);
-		$ca_expr = std::make_unique<ca_var_sym>(std::move($var_symbol.vs), r);
+		$ca_expr = make_arena_unique<ca_var_sym>(collector.arena(), std::move($var_symbol.vs), r);
 	}
 	| ca_string
 	{ 
@@ -89,20 +89,20 @@ term returns [ca_expr_ptr ca_expr]
 	{
 		auto r = provider.get_range($data_attribute.ctx);
 		if (std::holds_alternative<id_index>($data_attribute.value))
-			$ca_expr = std::make_unique<ca_symbol_attribute>(std::get<id_index>($data_attribute.value), $data_attribute.attribute, r, $data_attribute.value_range);
+			$ca_expr = make_arena_unique<ca_symbol_attribute>(collector.arena(), std::get<id_index>($data_attribute.value), $data_attribute.attribute, r, $data_attribute.value_range);
 		else if (std::holds_alternative<vs_ptr>($data_attribute.value))
-			$ca_expr = std::make_unique<ca_symbol_attribute>(std::move(std::get<vs_ptr>($data_attribute.value)), $data_attribute.attribute, r, $data_attribute.value_range);
+			$ca_expr = make_arena_unique<ca_symbol_attribute>(collector.arena(), std::move(std::get<vs_ptr>($data_attribute.value)), $data_attribute.attribute, r, $data_attribute.value_range);
 	}
 	| {is_self_def()}? self_def_term
 	{
 		auto r = provider.get_range($self_def_term.ctx);
-		$ca_expr = std::make_unique<ca_constant>($self_def_term.value, r);
+		$ca_expr = make_arena_unique<ca_constant>(collector.arena(), $self_def_term.value, r);
 	}
 	| num
 	{
 		collector.add_hl_symbol(token_info(provider.get_range( $num.ctx),hl_scopes::number));
 		auto r = provider.get_range($num.ctx);
-		$ca_expr = std::make_unique<ca_constant>($num.value, r);
+		$ca_expr = make_arena_unique<ca_constant>(collector.arena(), $num.value, r);
 	}
 	| ca_dupl_factor id_no_dot subscript_ne
 	{
@@ -113,25 +113,25 @@ term returns [ca_expr_ptr ca_expr]
 		auto [param_size, param_kind] = ca_common_expr_policy::get_function_param_info(func, ca_common_expr_policy::get_function_type(func));
 		resolve_expression($subscript_ne.value, param_kind);
 
-		$ca_expr = std::make_unique<ca_function>($id_no_dot.name, func, std::move($subscript_ne.value), std::move($ca_dupl_factor.value), r);
+		$ca_expr = make_arena_unique<ca_function>(collector.arena(), $id_no_dot.name, func, std::move($subscript_ne.value), std::move($ca_dupl_factor.value), r);
 	}
 	| id_no_dot
 	{
 		collector.add_hl_symbol(token_info(provider.get_range( $id_no_dot.ctx),hl_scopes::operand));
 		auto r = provider.get_range($id_no_dot.ctx);
-		$ca_expr = std::make_unique<ca_symbol>($id_no_dot.name, r);
+		$ca_expr = make_arena_unique<ca_symbol>(collector.arena(), $id_no_dot.name, r);
 	};
 	finally
-	{if (!$ca_expr) $ca_expr = std::make_unique<ca_constant>(0, provider.get_range(_localctx));}
+	{if (!$ca_expr) $ca_expr = make_arena_unique<ca_constant>(collector.arena(), 0, provider.get_range(_localctx));}
 
 expr_list returns [ca_expr_ptr ca_expr]
 	: lpar SPACE* expr_space_c SPACE* rpar
 	{
 		auto r = provider.get_range($lpar.ctx->getStart(), $rpar.ctx->getStop());
-		$ca_expr = std::make_unique<ca_expr_list>(std::move($expr_space_c.ca_exprs), r);
+		$ca_expr = make_arena_unique<ca_expr_list>(collector.arena(), std::move($expr_space_c.ca_exprs), r);
 	};
 	finally
-	{if (!$ca_expr) $ca_expr = std::make_unique<ca_constant>(0, provider.get_range(_localctx));}
+	{if (!$ca_expr) $ca_expr = make_arena_unique<ca_constant>(collector.arena(), 0, provider.get_range(_localctx));}
 	
 expr_space_c returns [std::vector<ca_expr_ptr> ca_exprs]
 	: expr
@@ -281,7 +281,7 @@ var_def_substr returns [std::vector<ca_expr_ptr> value]
 	: lpar num rpar 
 	{
 		auto r = provider.get_range($num.ctx);
-		$value.emplace_back(std::make_unique<ca_constant>($num.value, r));
+		$value.emplace_back(make_arena_unique<ca_constant>(collector.arena(), $num.value, r));
 	}
 	|;
 
@@ -315,10 +315,10 @@ ca_string_b returns [ca_expr_ptr ca_expr]
 	: ca_dupl_factor (apostrophe|attr) string_ch_v_c (apostrophe|attr) substring
 	{
 		auto r = provider.get_range($ca_dupl_factor.ctx->getStart(), $substring.ctx->getStop());
-		$ca_expr = std::make_unique<expressions::ca_string>(std::move($string_ch_v_c.chain), std::move($ca_dupl_factor.value), std::move($substring.value), r);
+		$ca_expr = make_arena_unique<expressions::ca_string>(collector.arena(), std::move($string_ch_v_c.chain), std::move($ca_dupl_factor.value), std::move($substring.value), r);
 	};
 	finally
-	{if (!$ca_expr) $ca_expr = std::make_unique<ca_constant>(0, provider.get_range(_localctx));}
+	{if (!$ca_expr) $ca_expr = make_arena_unique<ca_constant>(collector.arena(), 0, provider.get_range(_localctx));}
 
 ca_string returns [ca_expr_ptr ca_expr]
 	: ca_string_b
@@ -328,10 +328,10 @@ ca_string returns [ca_expr_ptr ca_expr]
 	| tmp=ca_string dot ca_string_b
 	{
 		auto r = provider.get_range($tmp.ctx->getStart(), $ca_string_b.ctx->getStop());
-		$ca_expr = std::make_unique<ca_basic_binary_operator<ca_conc>>(std::move($tmp.ca_expr), std::move($ca_string_b.ca_expr), r);
+		$ca_expr = make_arena_unique<ca_basic_binary_operator<ca_conc>>(collector.arena(), std::move($tmp.ca_expr), std::move($ca_string_b.ca_expr), r);
 	};
 	finally
-	{if (!$ca_expr) $ca_expr = std::make_unique<ca_constant>(0, provider.get_range(_localctx));}
+	{if (!$ca_expr) $ca_expr = make_arena_unique<ca_constant>(collector.arena(), 0, provider.get_range(_localctx));}
 
 string_ch_v returns [concat_point_ptr point]
 	: l_sp_ch_v								{$point = std::move($l_sp_ch_v.point);}
@@ -23,19 +23,19 @@ ca_op returns [operand_ptr op]
 
 		resolve_expression($expr_list.ca_expr);
 		auto r = provider.get_range($expr_list.ctx->getStart(),$seq_symbol.ctx->getStop());
-		$op = std::make_unique<branch_ca_operand>(std::move($seq_symbol.ss), std::move($expr_list.ca_expr), r);
+		$op = make_arena_unique<branch_ca_operand>(collector.arena(), std::move($seq_symbol.ss), std::move($expr_list.ca_expr), r);
 	}
 	| seq_symbol
 	{
 		collector.add_hl_symbol(token_info(provider.get_range($seq_symbol.ctx),hl_scopes::seq_symbol));
-		$op = std::make_unique<seq_ca_operand>(std::move($seq_symbol.ss),provider.get_range($seq_symbol.ctx));
+		$op = make_arena_unique<seq_ca_operand>(collector.arena(), std::move($seq_symbol.ss),provider.get_range($seq_symbol.ctx));
 	}
 	| {!is_var_def()}? expr
 	{
 		resolve_expression($expr.ca_expr);
-		$op = std::make_unique<expr_ca_operand>(std::move($expr.ca_expr), provider.get_range($expr.ctx));
+		$op = make_arena_unique<expr_ca_operand>(collector.arena(), std::move($expr.ca_expr), provider.get_range($expr.ctx));
 	}
 	| { is_var_def()}? var_def
 	{
-		$op = std::make_unique<var_ca_operand>(std::move($var_def.vs), provider.get_range($var_def.ctx));
+		$op = make_arena_unique<var_ca_operand>(collector.arena(), std::move($var_def.vs), provider.get_range($var_def.ctx));
 	};
\ No newline at end of file
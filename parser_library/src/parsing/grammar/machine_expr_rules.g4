@@ -23,9 +23,9 @@ mach_expr returns [mach_expr_ptr m_e]
 	((plus|minus) next=mach_expr_s
 	{
 		if ($plus.ctx)
-			$m_e = std::make_unique<mach_expr_binary<add>>(std::move($m_e), std::move($next.m_e), provider.get_range( $begin.ctx->getStart(), $next.ctx->getStop()));
+			$m_e = make_arena_unique<mach_expr_binary<add>>(collector.arena(), std::move($m_e), std::move($next.m_e), provider.get_range( $begin.ctx->getStart(), $next.ctx->getStop()));
 		else
-			$m_e = std::make_unique<mach_expr_binary<sub>>(std::move($m_e), std::move($next.m_e), provider.get_range( $begin.ctx->getStart(), $next.ctx->getStop()));
+			$m_e = make_arena_unique<mach_expr_binary<sub>>(collector.arena(), std::move($m_e), std::move($next.m_e), provider.get_range( $begin.ctx->getStart(), $next.ctx->getStop()));
 		$plus.ctx = nullptr;
 	}
 	)*;
@@ -38,9 +38,9 @@ mach_expr_s returns [mach_expr_ptr m_e]
 	((slash|asterisk) next=mach_term_c
 	{
 		if ($slash.ctx)
-			$m_e = std::make_unique<mach_expr_binary<div>>(std::move($m_e), std::move($next.m_e), provider.get_range( $begin.ctx->getStart(), $next.ctx->getStop()));
+			$m_e = make_arena_unique<mach_expr_binary<div>>(collector.arena(), std::move($m_e), std::move($next.m_e), provider.get_range( $begin.ctx->getStart(), $next.ctx->getStop()));
 		else
-			$m_e = std::make_unique<mach_expr_binary<mul>>(std::move($m_e), std::move($next.m_e), provider.get_range( $begin.ctx->getStart(), $next.ctx->getStop()));
+			$m_e = make_arena_unique<mach_expr_binary<mul>>(collector.arena(), std::move($m_e), std::move($next.m_e), provider.get_range( $begin.ctx->getStart(), $next.ctx->getStop()));
 		$slash.ctx = nullptr;
 	}
 	)*;
@@ -52,48 +52,48 @@ mach_term_c returns [mach_expr_ptr m_e]
 	}
 	| plus mach_term_c
 	{
-		$m_e = std::make_unique<mach_expr_unary<add>>(std::move($mach_term_c.m_e), provider.get_range( $plus.ctx->getStart(), $mach_term_c.ctx->getStop()));
+		$m_e = make_arena_unique<mach_expr_unary<add>>(collector.arena(), std::move($mach_term_c.m_e), provider.get_range( $plus.ctx->getStart(), $mach_term_c.ctx->getStop()));
 	}
 	| minus mach_term_c
 	{
-		$m_e = std::make_unique<mach_expr_unary<sub>>(std::move($mach_term_c.m_e), provider.get_range( $minus.ctx->getStart(), $mach_term_c.ctx->getStop()));
+		$m_e = make_arena_unique<mach_expr_unary<sub>>(collector.arena(), std::move($mach_term_c.m_e), provider.get_range( $minus.ctx->getStart(), $mach_term_c.ctx->getStop()));
 	};
 
 mach_term returns [mach_expr_ptr m_e]
 	: lpar mach_expr rpar
 	{
-		$m_e = std::make_unique<mach_expr_unary<par>>(std::move($mach_expr.m_e), provider.get_range( $lpar.ctx->getStart(), $rpar.ctx->getStop()));
+		$m_e = make_arena_unique<mach_expr_unary<par>>(collector.arena(), std::move($mach_expr.m_e), provider.get_range( $lpar.ctx->getStart(), $rpar.ctx->getStop()));
 	}
 	| mach_location_counter
 	{
-		$m_e = std::make_unique<mach_expr_location_counter>( provider.get_range( $mach_location_counter.ctx));
+		$m_e = make_arena_unique<mach_expr_location_counter>(collector.arena(),  provider.get_range( $mach_location_counter.ctx));
 	}
 	| {is_data_attr()}? mach_data_attribute
 	{
 		auto rng = provider.get_range( $mach_data_attribute.ctx);
 		auto attr = get_attribute(std::move($mach_data_attribute.attribute),rng);
 		if(attr == data_attr_kind::UNKNOWN || $mach_data_attribute.data == nullptr)
-			$m_e = std::make_unique<mach_expr_default>(rng);
+			$m_e = make_arena_unique<mach_expr_default>(collector.arena(), rng);
 		else
-			$m_e = std::make_unique<mach_expr_data_attr>($mach_data_attribute.data, attr, rng, $mach_data_attribute.symbol_rng);
+			$m_e = make_arena_unique<mach_expr_data_attr>(collector.arena(), $mach_data_attribute.data, attr, rng, $mach_data_attribute.symbol_rng);
 	}
 	| id
 	{
 		collector.add_hl_symbol(token_info(provider.get_range( $id.ctx),hl_scopes::ordinary_symbol));
-		$m_e = std::make_unique<mach_expr_symbol>($id.name, provider.get_range( $id.ctx));
+		$m_e = make_arena_unique<mach_expr_symbol>(collector.arena(), $id.name, provider.get_range( $id.ctx));
 	}
 	| num
 	{
 		collector.add_hl_symbol(token_info(provider.get_range( $num.ctx),hl_scopes::number));
-		$m_e =  std::make_unique<mach_expr_constant>($num.value, provider.get_range( $num.ctx));
+		$m_e =  make_arena_unique<mach_expr_constant>(collector.arena(), $num.value, provider.get_range( $num.ctx));
 	}
 	| self_def_term
 	{
-		$m_e = std::make_unique<mach_expr_constant>($self_def_term.value, provider.get_range( $self_def_term.ctx));
+		$m_e = make_arena_unique<mach_expr_constant>(collector.arena(), $self_def_term.value, provider.get_range( $self_def_term.ctx));
 	}
 	| literal
 	{
-		$m_e = std::make_unique<mach_expr_constant>(0, provider.get_range($literal.ctx));
+		$m_e = make_arena_unique<mach_expr_constant>(collector.arena(), 0, provider.get_range($literal.ctx));
 	};
 
 
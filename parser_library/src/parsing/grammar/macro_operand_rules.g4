@@ -19,16 +19,16 @@ parser grammar macro_operand_rules;
 mac_op returns [operand_ptr op]
 	: mac_preproc
 	{
-		$op = std::make_unique<macro_operand_string>($mac_preproc.ctx->getText(),provider.get_range($mac_preproc.ctx));
+		$op = make_arena_unique<macro_operand_string>(collector.arena(), $mac_preproc.ctx->getText(),provider.get_range($mac_preproc.ctx));
 	};
 
 mac_op_o returns [operand_ptr op] 
 	: mac_entry?
 	{
 		if($mac_entry.ctx)
-			$op = std::make_unique<macro_operand_chain>(std::move($mac_entry.chain),provider.get_range($mac_entry.ctx));
+			$op = make_arena_unique<macro_operand_chain>(collector.arena(), std::move($mac_entry.chain),provider.get_range($mac_entry.ctx));
 		else
-			$op = std::make_unique<semantics::empty_operand>(provider.original_range);
+			$op = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.original_range);
 	};
 
 macro_ops returns [operand_list list] 
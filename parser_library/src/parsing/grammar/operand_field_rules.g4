@@ -17,7 +17,7 @@ parser grammar operand_field_rules;
 
 operand returns [operand_ptr op]
 	: operand_not_empty					{$op = std::move($operand_not_empty.op);}
-	|									{$op = std::make_unique<semantics::empty_operand>(provider.get_empty_range( _localctx->getStart()));};
+	|									{$op = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.get_empty_range( _localctx->getStart()));};
 
 
 operand_not_empty returns [operand_ptr op]
@@ -31,7 +31,7 @@ operand_not_empty returns [operand_ptr op]
 	}
 	| {DAT()}? data_def
 	{
-		$op = std::make_unique<data_def_operand>(std::move($data_def.value),provider.get_range($data_def.ctx));
+		$op = make_arena_unique<data_def_operand>(collector.arena(), std::move($data_def.value),provider.get_range($data_def.ctx));
 	};
 
 //////////////////////////////////////// mach
@@ -48,9 +48,9 @@ op_rem_body_mach
 		operand_ptr op;
 		std::vector<operand_ptr> operands;
 		if($model_op.chain_opt)
-			op = std::make_unique<model_operand>(std::move(*$model_op.chain_opt),provider.get_range( $model_op.ctx)); 
+			op = make_arena_unique<model_operand>(collector.arena(), std::move(*$model_op.chain_opt),provider.get_range( $model_op.ctx)); 
 		else
-			op = std::make_unique<semantics::empty_operand>(provider.get_range( $model_op.ctx)); 
+			op = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.get_range( $model_op.ctx)); 
 		operands.push_back(std::move(op));
 		auto remarks = $remark_o.value ? remark_list{*$remark_o.value} : remark_list{};
 		auto line_range = provider.get_range($model_op.ctx->getStart(),$remark_o.ctx->getStop());
@@ -70,7 +70,7 @@ op_list_mach returns [std::vector<operand_ptr> operands]
 
 operand_mach returns [operand_ptr op]
 	: mach_op							{$op = std::move($mach_op.op);}
-	|									{$op = std::make_unique<semantics::empty_operand>(provider.get_empty_range( _localctx->getStart()));};
+	|									{$op = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.get_empty_range( _localctx->getStart()));};
 
 //////////////////////////////////////// dat
 
@@ -86,9 +86,9 @@ op_rem_body_dat
 		operand_ptr op;
 		std::vector<operand_ptr> operands;
 		if($model_op.chain_opt)
-			op = std::make_unique<model_operand>(std::move(*$model_op.chain_opt),provider.get_range( $model_op.ctx)); 
+			op = make_arena_unique<model_operand>(collector.arena(), std::move(*$model_op.chain_opt),provider.get_range( $model_op.ctx)); 
 		else
-			op = std::make_unique<semantics::empty_operand>(provider.get_range( $model_op.ctx)); 
+			op = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.get_range( $model_op.ctx)); 
 		operands.push_back(std::move(op));
 		auto remarks = $remark_o.value ? remark_list{*$remark_o.value} : remark_list{};
 		auto line_range = provider.get_range($model_op.ctx->getStart(),$remark_o.ctx->getStop());
@@ -108,7 +108,7 @@ op_list_dat returns [std::vector<operand_ptr> operands]
 
 operand_dat returns [operand_ptr op]
 	: dat_op							{$op = std::move($dat_op.op);}
-	|									{$op = std::make_unique<semantics::empty_operand>(provider.get_empty_range( _localctx->getStart()));};
+	|									{$op = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.get_empty_range( _localctx->getStart()));};
 
 //////////////////////////////////////// asm
 
@@ -124,9 +124,9 @@ op_rem_body_asm
 		operand_ptr op;
 		std::vector<operand_ptr> operands;
 		if($model_op.chain_opt)
-			op = std::make_unique<model_operand>(std::move(*$model_op.chain_opt),provider.get_range( $model_op.ctx)); 
+			op = make_arena_unique<model_operand>(collector.arena(), std::move(*$model_op.chain_opt),provider.get_range( $model_op.ctx)); 
 		else
-			op = std::make_unique<semantics::empty_operand>(provider.get_range( $model_op.ctx)); 
+			op = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.get_range( $model_op.ctx)); 
 		operands.push_back(std::move(op));
 		auto remarks = $remark_o.value ? remark_list{*$remark_o.value} : remark_list{};
 		auto line_range = provider.get_range($model_op.ctx->getStart(),$remark_o.ctx->getStop());
@@ -146,7 +146,7 @@ op_list_asm returns [std::vector<operand_ptr> operands]
 
 operand_asm returns [operand_ptr op]
 	: asm_op							{$op = std::move($asm_op.op);}
-	|									{$op = std::make_unique<semantics::empty_operand>(provider.get_empty_range( _localctx->getStart()));};
+	|									{$op = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.get_empty_range( _localctx->getStart()));};
 
 
 //////////////////////////////////////// ca
@@ -186,14 +186,14 @@ cont_ca returns [op_rem line]
 cont_body_ca returns [op_rem line]
 	: remark_o																					
 	{ 
-		auto tmp = std::make_unique<semantics::empty_operand>(provider.get_empty_range( $remark_o.ctx->getStart()));
+		auto tmp = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.get_empty_range( $remark_o.ctx->getStart()));
 		$line.operands.push_back(std::move(tmp));
 		$line.remarks = $remark_o.value ? remark_list{*$remark_o.value} : remark_list{};
 	}
 	| r1=remark_o CONTINUATION {disable_continuation();} /*empty op*/ r2=remark_o			
 	{
 		if($r1.value) $line.remarks.push_back(*$r1.value); 
-		auto tmp = std::make_unique<semantics::empty_operand>(range(provider.get_range( $r2.ctx).start));
+		auto tmp = make_arena_unique<semantics::empty_operand>(collector.arena(), range(provider.get_range( $r2.ctx).start));
 		$line.operands.push_back(std::move(tmp));
 		if($r2.value) $line.remarks.push_back(*$r2.value); 
 	}
@@ -214,7 +214,7 @@ alt_op_list_comma_ca returns [std::vector<operand_ptr> operands]
 
 alt_operand_ca returns [operand_ptr op]
 	: ca_op					{$op = std::move($ca_op.op);}
-	|						{$op = std::make_unique<semantics::empty_operand>(provider.get_empty_range( _localctx->getStart()));};
+	|						{$op = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.get_empty_range( _localctx->getStart()));};
 
 //////////////////////////////////////// mac
 
@@ -252,14 +252,14 @@ cont_mac returns [op_rem line]
 cont_body_mac returns [op_rem line]
 	: remark_o																					
 	{ 
-		auto tmp = std::make_unique<semantics::empty_operand>(provider.get_empty_range( $remark_o.ctx->getStart()));
+		auto tmp = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.get_empty_range( $remark_o.ctx->getStart()));
 		$line.operands.push_back(std::move(tmp));
 		$line.remarks = $remark_o.value ? remark_list{*$remark_o.value} : remark_list{};
 	}
 	| r1=remark_o CONTINUATION {disable_continuation();} /*empty op*/ r2=remark_o			
 	{
 		if($r1.value) $line.remarks.push_back(*$r1.value); 
-		auto tmp = std::make_unique<semantics::empty_operand>(range(provider.get_range( $r2.ctx).start));
+		auto tmp = make_arena_unique<semantics::empty_operand>(collector.arena(), range(provider.get_range( $r2.ctx).start));
 		$line.operands.push_back(std::move(tmp));
 		if($r2.value) $line.remarks.push_back(*$r2.value); 
 	}
@@ -280,7 +280,7 @@ alt_op_list_comma_mac returns [std::vector<operand_ptr> operands]
 
 alt_operand_mac returns [operand_ptr op]
 	: mac_op					{$op = std::move($mac_op.op);}
-	|							{$op = std::make_unique<semantics::empty_operand>(provider.get_empty_range( _localctx->getStart()));};
+	|							{$op = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.get_empty_range( _localctx->getStart()));};
 
 /////////////
 
@@ -316,9 +316,9 @@ op_rem_body_mach_r returns [op_rem line]
 	{
 		operand_ptr op;
 		if($model_op.chain_opt)
-			op = std::make_unique<model_operand>(std::move(*$model_op.chain_opt),provider.get_range( $model_op.ctx)); 
+			op = make_arena_unique<model_operand>(collector.arena(), std::move(*$model_op.chain_opt),provider.get_range( $model_op.ctx)); 
 		else
-			op = std::make_unique<semantics::empty_operand>(provider.get_range( $model_op.ctx)); 
+			op = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.get_range( $model_op.ctx)); 
 		$line.operands.push_back(std::move(op));
 		$line.remarks = $remark_o.value ? remark_list{*$remark_o.value} : remark_list{};
 	} EOLLN EOF
@@ -336,9 +336,9 @@ op_rem_body_dat_r returns [op_rem line]
 	{
 		operand_ptr op;
 		if($model_op.chain_opt)
-			op = std::make_unique<model_operand>(std::move(*$model_op.chain_opt),provider.get_range( $model_op.ctx)); 
+			op = make_arena_unique<model_operand>(collector.arena(), std::move(*$model_op.chain_opt),provider.get_range( $model_op.ctx)); 
 		else
-			op = std::make_unique<semantics::empty_operand>(provider.get_range( $model_op.ctx)); 
+			op = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.get_range( $model_op.ctx)); 
 		$line.operands.push_back(std::move(op));
 		$line.remarks = $remark_o.value ? remark_list{*$remark_o.value} : remark_list{};
 	} EOLLN EOF
@@ -356,9 +356,9 @@ op_rem_body_asm_r returns [op_rem line]
 	{
 		operand_ptr op;
 		if($model_op.chain_opt)
-			op = std::make_unique<model_operand>(std::move(*$model_op.chain_opt),provider.get_range( $model_op.ctx)); 
+			op = make_arena_unique<model_operand>(collector.arena(), std::move(*$model_op.chain_opt),provider.get_range( $model_op.ctx)); 
 		else
-			op = std::make_unique<semantics::empty_operand>(provider.get_range( $model_op.ctx)); 
+			op = make_arena_unique<semantics::empty_operand>(collector.arena(), provider.get_range( $model_op.ctx)); 
 		$line.operands.push_back(std::move(op));
 		$line.remarks = $remark_o.value ? remark_list{*$remark_o.value} : remark_list{};
 	} EOLLN EOF
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "mach_operand_parser.h"
+
+#include <cctype>
+
+#include "expressions/conditional_assembly/terms/ca_constant.h"
+#include "expressions/mach_expr_term.h"
+#include "expressions/mach_operator.h"
+#include "lexing/lexer.h"
+#include "semantics/operand_impls.h"
+
+namespace hlasm_plugin::parser_library::parsing {
+
+namespace {
+// default source format of the lexer that reparses operand fields
+constexpr size_t begin_column = 0;
+constexpr size_t end_column = 71;
+constexpr size_t continue_column = 15;
+
+bool identifier_divider(char c)
+{
+    switch (c)
+    {
+        case '*':
+        case '.':
+        case '-':
+        case '+':
+        case '=':
+        case '<':
+        case '>':
+        case ',':
+        case '(':
+        case ')':
+        case '\'':
+        case '/':
+        case '&':
+        case '|':
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool is_digit(char c) { return c >= '0' && c <= '9'; }
+} // namespace
+
+mach_operand_parser::mach_operand_parser(
+    context::id_storage& ids, semantics::range_provider& provider, context::statement_arena* arena)
+    : ids_(ids)
+    , provider_(provider)
+    , arena_(arena)
+{}
+
+std::optional<mach_operand_field> mach_operand_parser::parse(std::string_view text, position start)
+{
+    next_ = 0;
+    hl_symbols_.clear();
+
+    if (!lex(text, start) || current().kind != token_kind::SPACE)
+        return std::nullopt;
+    while (current().kind == token_kind::SPACE)
+        ++next_;
+    if (current().kind == token_kind::EOLLN)
+        return std::nullopt;
+
+    const size_t first = next_;
+    mach_operand_field result;
+    while (true)
+    {
+        const auto& t = current();
+        if (t.is(',') || t.kind == token_kind::SPACE || t.kind == token_kind::EOLLN)
+            result.operands.push_back(context::make_arena_unique<semantics::empty_operand>(
+                arena_, provider_.adjust_range(range(t.start))));
+        else if (auto op = mach_op())
+            result.operands.push_back(std::move(op));
+        else
+            return std::nullopt;
+
+        if (!current().is(','))
+            break;
+        add_hl_symbol(next_++, semantics::hl_scopes::operator_symbol);
+    }
+
+    // everything after the space up to the end of the line is the remark
+    const size_t eolln = tokens_.size() - 1;
+    if (current().kind == token_kind::SPACE)
+        result.remarks.push_back(get_range(next_ + 1, eolln - 1));
+    else if (current().kind != token_kind::EOLLN)
+        return std::nullopt;
+
+    result.field_range = get_range(first, eolln - 1);
+    result.hl_symbols = std::move(hl_symbols_);
+    return result;
+}
+
+bool mach_operand_parser::lex(std::string_view text, position start)
+{
+    tokens_.clear();
+
+    // positions are counted in characters
+    for (unsigned char c : text)
+        if (c >= 0x80)
+            return false;
+
+    size_t i = 0;
+    size_t line = (size_t)start.line;
+    size_t column = (size_t)start.column;
+    auto consume = [&]() {
+        if (text[i++] == '\n')
+        {
+            ++line;
+            column = 0;
+        }
+        else
+            ++column;
+    };
+
+    while (true)
+    {
+        const size_t begin = i;
+        const position token_start(line, column);
+        auto add_token = [&](token_kind kind) {
+            tokens_.push_back({ kind, text.substr(begin, i - begin), token_start, position(line, column) });
+        };
+
+        if (i == text.size())
+        {
+            add_token(token_kind::EOLLN);
+            return true;
+        }
+
+        const char c = text[i];
+        if (column == end_column && !std::isspace((unsigned char)c))
+        {
+            // continuation, the rest of the line and the beginning of the next one are ignored
+            while (i < text.size() && text[i] != '\n')
+                consume();
+            if (i == text.size())
+                return false;
+            consume();
+            while (column < continue_column && i < text.size() && text[i] != '\n')
+                consume();
+            if (column < continue_column)
+                return false;
+            continue;
+        }
+        if (column >= end_column)
+            return false;
+
+        if (c == ' ')
+        {
+            while (i < text.size() && text[i] == ' ' && column < end_column)
+                consume();
+            add_token(token_kind::SPACE);
+        }
+        else if (c == '\r' || c == '\n' || c == '&')
+            return false;
+        else if (identifier_divider(c))
+        {
+            // comments start at the begin column
+            if (column == begin_column && (c == '*' || c == '.'))
+                return false;
+            consume();
+            add_token(token_kind::CHAR);
+        }
+        else
+        {
+            bool ord = !is_digit(c);
+            bool num = true;
+            while (i < text.size() && text[i] != ' ' && text[i] != '\r' && text[i] != '\n'
+                && !identifier_divider(text[i]) && column < end_column)
+            {
+                ord &= lexing::lexer::ord_char((unsigned char)text[i]);
+                num &= is_digit(text[i]);
+                consume();
+            }
+
+            if (ord && i - begin <= 63)
+                add_token(token_kind::ORDSYMBOL);
+            else if (num)
+                add_token(token_kind::NUM);
+            else
+                add_token(token_kind::IDENTIFIER);
+        }
+    }
+}
+
+range mach_operand_parser::get_range(size_t first, size_t last)
+{
+    return provider_.adjust_range(range(tokens_[first].start, tokens_[last].end));
+}
+
+void mach_operand_parser::add_hl_symbol(size_t index, semantics::hl_scopes scope)
+{
+    hl_symbols_.emplace_back(get_range(index, index), scope);
+}
+
+semantics::operand_ptr mach_operand_parser::mach_op()
+{
+    const size_t first = next_;
+    auto disp = mach_expr();
+    if (!disp)
+        return nullptr;
+
+    if (!current().is('('))
+        return context::make_arena_unique<semantics::expr_machine_operand>(
+            arena_, std::move(disp), get_range(first, next_ - 1));
+
+    add_hl_symbol(next_++, semantics::hl_scopes::operator_symbol);
+
+    expressions::mach_expr_ptr index;
+    expressions::mach_expr_ptr base;
+    auto state = checking::operand_state::ONE_OP;
+    if (current().is(','))
+    {
+        add_hl_symbol(next_++, semantics::hl_scopes::operator_symbol);
+        state = checking::operand_state::FIRST_OMITTED;
+        if (base = mach_expr(); !base)
+            return nullptr;
+    }
+    else
+    {
+        if (index = mach_expr(); !index)
+            return nullptr;
+
+        if (!current().is(','))
+            base = std::move(index);
+        else
+        {
+            add_hl_symbol(next_++, semantics::hl_scopes::operator_symbol);
+            if (current().is(')'))
+                state = checking::operand_state::SECOND_OMITTED;
+            else if (base = mach_expr(); base)
+                state = checking::operand_state::PRESENT;
+            else
+                return nullptr;
+        }
+    }
+
+    if (!current().is(')'))
+        return nullptr;
+    add_hl_symbol(next_++, semantics::hl_scopes::operator_symbol);
+
+    return context::make_arena_unique<semantics::address_machine_operand>(
+        arena_, std::move(disp), std::move(index), std::move(base), get_range(first, next_ - 1), state);
+}
+
+expressions::mach_expr_ptr mach_operand_parser::mach_expr()
+{
+    const size_t first = next_;
+    auto expr = mach_expr_s();
+    while (expr && (current().is('+') || current().is('-')))
+    {
+        const bool plus = current().is('+');
+        add_hl_symbol(next_++, semantics::hl_scopes::operator_symbol);
+
+        auto next = mach_expr_s();
+        if (!next)
+            return nullptr;
+        if (plus)
+            expr = context::make_arena_unique<expressions::mach_expr_binary<expressions::add>>(
+                arena_, std::move(expr), std::move(next), get_range(first, next_ - 1));
+        else
+            expr = context::make_arena_unique<expressions::mach_expr_binary<expressions::sub>>(
+                arena_, std::move(expr), std::move(next), get_range(first, next_ - 1));
+    }
+    return expr;
+}
+
+expressions::mach_expr_ptr mach_operand_parser::mach_expr_s()
+{
+    const size_t first = next_;
+    auto expr = mach_term_c();
+    while (expr && (current().is('/') || current().is('*')))
+    {
+        const bool slash = current().is('/');
+        add_hl_symbol(next_++, semantics::hl_scopes::operator_symbol);
+
+        auto next = mach_term_c();
+        if (!next)
+            return nullptr;
+        if (slash)
+            expr = context::make_arena_unique<expressions::mach_expr_binary<expressions::div>>(
+                arena_, std::move(expr), std::move(next), get_range(first, next_ - 1));
+        else
+            expr = context::make_arena_unique<expressions::mach_expr_binary<expressions::mul>>(
+                arena_, std::move(expr), std::move(next), get_range(first, next_ - 1));
+    }
+    return expr;
+}
+
+expressions::mach_expr_ptr mach_operand_parser::mach_term_c()
+{
+    if (!current().is('+') && !current().is('-'))
+        return mach_term();
+
+    const size_t first = next_;
+    const bool plus = current().is('+');
+    add_hl_symbol(next_++, semantics::hl_scopes::operator_symbol);
+
+    auto child = mach_term_c();
+    if (!child)
+        return nullptr;
+    if (plus)
+        return context::make_arena_unique<expressions::mach_expr_unary<expressions::add>>(
+            arena_, std::move(child), get_range(first, next_ - 1));
+    else
+        return context::make_arena_unique<expressions::mach_expr_unary<expressions::sub>>(
+            arena_, std::move(child), get_range(first, next_ - 1));
+}
+
+expressions::mach_expr_ptr mach_operand_parser::mach_term()
+{
+    const size_t first = next_;
+    const auto& t = current();
+
+    if (t.is('('))
+    {
+        add_hl_symbol(next_++, semantics::hl_scopes::operator_symbol);
+        auto expr = mach_expr();
+        if (!expr || !current().is(')'))
+            return nullptr;
+        add_hl_symbol(next_++, semantics::hl_scopes::operator_symbol);
+        return context::make_arena_unique<expressions::mach_expr_unary<expressions::par>>(
+            arena_, std::move(expr), get_range(first, next_ - 1));
+    }
+    else if (t.is('*'))
+    {
+        add_hl_symbol(next_++, semantics::hl_scopes::operand);
+        return context::make_arena_unique<expressions::mach_expr_location_counter>(arena_, get_range(first, first));
+    }
+    else if (t.kind == token_kind::ORDSYMBOL)
+    {
+        add_hl_symbol(next_++, semantics::hl_scopes::ordinary_symbol);
+        return context::make_arena_unique<expressions::mach_expr_symbol>(
+            arena_, ids_.add(std::string(t.text)), get_range(first, first));
+    }
+    else if (t.kind == token_kind::NUM)
+    {
+        auto value = expressions::ca_constant::try_self_defining_term(std::string(t.text));
+        if (!value)
+            return nullptr;
+        add_hl_symbol(next_++, semantics::hl_scopes::number);
+        return context::make_arena_unique<expressions::mach_expr_constant>(arena_, *value, get_range(first, first));
+    }
+    return nullptr;
+}
+
+} // namespace hlasm_plugin::parser_library::parsing
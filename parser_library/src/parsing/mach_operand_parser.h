@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#ifndef HLASMPLUGIN_PARSERLIBRARY_MACH_OPERAND_PARSER_H
+#define HLASMPLUGIN_PARSERLIBRARY_MACH_OPERAND_PARSER_H
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "context/id_storage.h"
+#include "context/statement_arena.h"
+#include "expressions/mach_expression.h"
+#include "semantics/highlighting_info.h"
+#include "semantics/operand.h"
+#include "semantics/range_provider.h"
+
+namespace hlasm_plugin::parser_library::parsing {
+
+// operand field of a machine instruction as produced by the op_rem_body_mach rule
+struct mach_operand_field
+{
+    semantics::operand_list operands;
+    semantics::remark_list remarks;
+    range field_range;
+    std::vector<token_info> hl_symbols;
+};
+
+// recursive descent parser of the common machine instruction operand fields
+// handles symbols, decimal numbers, the location counter, arithmetic operators and the D(X,B) address forms,
+// separated by commas and followed by a remark, possibly spanning continued lines
+// it lexes the text the same way as the default lexer used for reparsing the operand field and builds the same
+// operands, ranges and highlighting as the grammar; anything else is left to the grammar
+class mach_operand_parser
+{
+public:
+    // the operands and expressions are created in the arena, nullptr stands for the general heap
+    mach_operand_parser(context::id_storage& ids, semantics::range_provider& provider, context::statement_arena* arena);
+
+    // parses the operand field text starting at the position, returns nullopt when the grammar has to be used
+    std::optional<mach_operand_field> parse(std::string_view text, position start);
+
+private:
+    enum class token_kind
+    {
+        SPACE,
+        ORDSYMBOL,
+        NUM,
+        // any other word
+        IDENTIFIER,
+        // single character token
+        CHAR,
+        EOLLN,
+    };
+
+    struct token
+    {
+        token_kind kind;
+        std::string_view text;
+        position start;
+        position end;
+
+        bool is(char c) const { return kind == token_kind::CHAR && text.front() == c; }
+    };
+
+    context::id_storage& ids_;
+    semantics::range_provider& provider_;
+    context::statement_arena* arena_;
+    std::vector<token> tokens_;
+    size_t next_ = 0;
+    std::vector<token_info> hl_symbols_;
+
+    bool lex(std::string_view text, position start);
+
+    const token& current() const { return tokens_[next_]; }
+    range get_range(size_t first, size_t last);
+    void add_hl_symbol(size_t index, semantics::hl_scopes scope);
+
+    semantics::operand_ptr mach_op();
+    expressions::mach_expr_ptr mach_expr();
+    expressions::mach_expr_ptr mach_expr_s();
+    expressions::mach_expr_ptr mach_term_c();
+    expressions::mach_expr_ptr mach_term();
+};
+
+} // namespace hlasm_plugin::parser_library::parsing
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "operand_field_cache.h"
+
+#include "semantics/operand.h"
+
+namespace hlasm_plugin::parser_library::parsing {
+
+size_t operand_field_cache::key_hash::operator()(const key& k) const
+{
+    size_t h = std::hash<std::string_view>()(k.field);
+    auto combine = [&h](size_t v) { h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2); };
+
+    combine((size_t)k.field_range.start.line);
+    combine((size_t)k.field_range.start.column);
+    combine((size_t)k.field_range.end.line);
+    combine((size_t)k.field_range.end.column);
+    combine((size_t)k.status.first.form);
+    combine(std::hash<context::id_index>()(k.status.second.value));
+    return h;
+}
+
+operand_field_cache::operand_field_cache(size_t capacity)
+    : capacity_(capacity)
+{}
+
+std::optional<operand_field_cache::parse_result> operand_field_cache::find(
+    std::string_view field, const range& field_range, const processing::processing_status& status)
+{
+    auto it = index_.find(key { field, field_range, status });
+    if (it == index_.end())
+        return std::nullopt;
+
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return clone(it->second->fields);
+}
+
+void operand_field_cache::insert(std::string field,
+    const range& field_range,
+    const processing::processing_status& status,
+    const parse_result& fields)
+{
+    if (capacity_ == 0 || index_.count(key { field, field_range, status }))
+        return;
+
+    auto copy = clone(fields);
+    if (!copy)
+        return;
+
+    if (entries_.size() == capacity_)
+    {
+        const auto& last = entries_.back();
+        index_.erase(key { last.field, last.field_range, last.status });
+        entries_.pop_back();
+    }
+
+    entries_.push_front(entry { std::move(field), field_range, status, std::move(*copy) });
+    const auto& e = entries_.front();
+    index_.emplace(key { e.field, e.field_range, e.status }, entries_.begin());
+}
+
+size_t operand_field_cache::size() const { return entries_.size(); }
+
+std::optional<operand_field_cache::parse_result> operand_field_cache::clone(const parse_result& fields)
+{
+    const auto& [operands, remarks] = fields;
+
+    semantics::operand_list ops;
+    ops.reserve(operands.value.size());
+    for (const auto& op : operands.value)
+    {
+        auto copy = op->clone();
+        if (!copy)
+            return std::nullopt;
+        ops.push_back(std::move(copy));
+    }
+
+    return parse_result(semantics::operands_si(operands.field_range, std::move(ops)), remarks);
+}
+
+} // namespace hlasm_plugin::parser_library::parsing
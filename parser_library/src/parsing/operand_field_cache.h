@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#ifndef HLASMPLUGIN_PARSERLIBRARY_OPERAND_FIELD_CACHE_H
+#define HLASMPLUGIN_PARSERLIBRARY_OPERAND_FIELD_CACHE_H
+
+#include <list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "processing/statement_fields_parser.h"
+
+namespace hlasm_plugin::parser_library::parsing {
+
+// bounded cache of operand fields parsed after variable substitution
+// a macro expanded many times produces the same substituted text of its model statements over and over again
+// after substitution all the ranges of the parsed field are the range of the model statement operand field,
+// so the entries are keyed by that range and the copies handed out need no adjustment
+class operand_field_cache
+{
+public:
+    using parse_result = processing::statement_fields_parser::parse_result;
+
+    explicit operand_field_cache(size_t capacity = 1024);
+
+    // returns a copy of the fields parsed from the text, if present
+    std::optional<parse_result> find(
+        std::string_view field, const range& field_range, const processing::processing_status& status);
+
+    // stores a copy of the parsed fields, nothing is stored if some operand cannot be copied
+    void insert(std::string field,
+        const range& field_range,
+        const processing::processing_status& status,
+        const parse_result& fields);
+
+    size_t size() const;
+
+private:
+    struct key
+    {
+        std::string_view field;
+        range field_range;
+        processing::processing_status status;
+
+        bool operator==(const key& oth) const
+        {
+            return field == oth.field && field_range == oth.field_range && status == oth.status;
+        }
+    };
+    struct key_hash
+    {
+        size_t operator()(const key& k) const;
+    };
+    struct entry
+    {
+        // the key refers to this text
+        std::string field;
+        range field_range;
+        processing::processing_status status;
+        parse_result fields;
+    };
+
+    size_t capacity_;
+    // most recently used entries first
+    std::list<entry> entries_;
+    std::unordered_map<key, std::list<entry>::iterator, key_hash> index_;
+
+    static std::optional<parse_result> clone(const parse_result& fields);
+};
+
+} // namespace hlasm_plugin::parser_library::parsing
+
+#endif
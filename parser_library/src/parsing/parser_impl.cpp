@@ -14,14 +14,17 @@
 
 #include "parser_impl.h"
 
+#include <algorithm>
 #include <cctype>
 
 #include "error_strategy.h"
 #include "expressions/conditional_assembly/terms/ca_constant.h"
 #include "hlasmparser.h"
 #include "lexing/token_stream.h"
+#include "mach_operand_parser.h"
 #include "parser_error_listener_ctx.h"
 #include "processing/context_manager.h"
+#include "semantics/operand_impls.h"
 
 namespace hlasm_plugin::parser_library::parsing {
 
@@ -67,6 +70,7 @@ std::string parser_impl::aread()
     if (input_lexer->eof_generated())
         finished_flag = true;
     input_tokens_invalidated = true;
+    checkpoints_active_ = false;
 
     if (!line.empty())
         line.resize(80, ' ');
@@ -86,6 +90,7 @@ void parser_impl::ainsert(const std::string& record, processing::ainsert_destina
     }
     // TODO: this needs to be really reworked...
     input_tokens_invalidated = true;
+    checkpoints_active_ = false;
 }
 
 context::source_position parser_impl::statement_start() const
@@ -111,60 +116,126 @@ std::unique_ptr<parser_holder> create_parser_holder()
     return h;
 }
 
+template<typename Rule>
+auto parser_impl::parse_rest(const std::string& text,
+    position file_offset,
+    bool unlimited_line,
+    const semantics::range_provider& range_prov,
+    const processing::processing_status& status,
+    const std::shared_ptr<context::statement_arena>& arena,
+    parser_error_listener_ctx& listener,
+    Rule rule)
+{
+    if (!rest_parser_)
+        rest_parser_ = create_parser_holder();
+
+    const parser_holder& h = *rest_parser_;
+
+    auto prepare = [&](bool sll) {
+        h.input->reset(text);
+
+        h.lex->reset();
+        h.lex->set_file_offset(file_offset);
+        h.lex->set_unlimited_line(unlimited_line);
+
+        // a failed attempt may leave them enabled
+        h.stream->disable_continuation();
+        h.stream->disable_hidden();
+        h.stream->reset();
+
+        h.parser->initialize(hlasm_ctx, range_prov, status);
+        h.parser->removeErrorListeners();
+        if (sll)
+            h.parser->setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
+        else
+        {
+            h.parser->setErrorHandler(std::make_shared<error_strategy>());
+            h.parser->addErrorListener(&listener);
+        }
+        h.parser->getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(
+            sll ? antlr4::atn::PredictionMode::SLL : antlr4::atn::PredictionMode::LL);
+        h.parser->reset();
+
+        h.parser->collector.prepare_for_next_statement();
+        h.parser->collector.set_arena(arena);
+    };
+
+    if (two_stage_prediction_)
+    {
+        // SLL prediction is sufficient for almost all valid fields, syntax errors and the rare fields that need
+        // the full context are parsed again
+        const size_t diags_before = h.parser->diags().size();
+        prepare(true);
+        try
+        {
+            return rule(*h.parser);
+        }
+        catch (const antlr4::ParseCancellationException&)
+        {
+            auto& diags = h.parser->diags();
+            diags.erase(diags.begin() + diags_before, diags.end());
+            hlasm_ctx->metrics.ll_fallback_statements++;
+        }
+    }
+
+    prepare(false);
+    return rule(*h.parser);
+}
+
 std::pair<semantics::operands_si, semantics::remarks_si> parser_impl::parse_operand_field(std::string field,
     bool after_substitution,
     semantics::range_provider field_range,
     processing::processing_status status)
 {
+    if (after_substitution)
+    {
+        if (auto cached = operand_field_cache_.find(field, field_range.original_range, status))
+        {
+            if (status.first.form == processing::processing_form::MAC)
+                proc_status = status;
+            return std::move(*cached);
+        }
+    }
+
     if (!rest_parser_)
         rest_parser_ = create_parser_holder();
 
     hlasm_ctx->metrics.reparsed_statements++;
     const parser_holder& h = *rest_parser_;
+    const size_t diags_before = diags().size() + h.parser->diags().size();
 
     std::optional<std::string> sub;
     if (after_substitution)
         sub = field;
     parser_error_listener_ctx listener(*hlasm_ctx, std::move(sub));
 
-    h.input->reset(field);
-
-    h.lex->reset();
-    h.lex->set_file_offset(field_range.original_range.start);
-    h.lex->set_unlimited_line(after_substitution);
-
-    h.stream->reset();
-
-    h.parser->initialize(hlasm_ctx, field_range, status);
-    h.parser->setErrorHandler(std::make_shared<error_strategy>());
-    h.parser->removeErrorListeners();
-    h.parser->addErrorListener(&listener);
-    h.parser->reset();
-
-    h.parser->collector.prepare_for_next_statement();
+    auto parse = [&](auto rule) {
+        return parse_rest(
+            field, field_range.original_range.start, after_substitution, field_range, status, nullptr, listener, rule);
+    };
 
     semantics::op_rem line;
     auto& [format, opcode] = status;
     if (format.occurence == processing::operand_occurence::ABSENT
         || format.form == processing::processing_form::UNKNOWN)
-        h.parser->op_rem_body_noop();
+        parse([](hlasmparser& p) { return p.op_rem_body_noop(); });
     else
     {
         switch (format.form)
         {
             case processing::processing_form::MAC:
-                line = std::move(h.parser->op_rem_body_mac_r()->line);
+                line = parse([](hlasmparser& p) { return std::move(p.op_rem_body_mac_r()->line); });
                 proc_status = status;
-                parse_macro_operands(line);
+                parse_macro_operands(line, nullptr);
                 break;
             case processing::processing_form::ASM:
-                line = std::move(h.parser->op_rem_body_asm_r()->line);
+                line = parse([](hlasmparser& p) { return std::move(p.op_rem_body_asm_r()->line); });
                 break;
             case processing::processing_form::MACH:
-                line = std::move(h.parser->op_rem_body_mach_r()->line);
+                line = parse([](hlasmparser& p) { return std::move(p.op_rem_body_mach_r()->line); });
                 break;
             case processing::processing_form::DAT:
-                line = std::move(h.parser->op_rem_body_dat_r()->line);
+                line = parse([](hlasmparser& p) { return std::move(p.op_rem_body_dat_r()->line); });
                 break;
             default:
                 break;
@@ -193,8 +264,38 @@ std::pair<semantics::operands_si, semantics::remarks_si> parser_impl::parse_oper
         ? range(op_range.end)
         : semantics::range_provider::union_range(line.remarks.front(), line.remarks.back());
 
-    return std::make_pair(semantics::operands_si(op_range, std::move(line.operands)),
+    auto result = std::make_pair(semantics::operands_si(op_range, std::move(line.operands)),
         semantics::remarks_si(rem_range, std::move(line.remarks)));
+
+    // fields with diagnostics are not cached, the diagnostics would not be reported again
+    if (after_substitution && diags().size() + h.parser->diags().size() == diags_before)
+        operand_field_cache_.insert(std::move(field), field_range.original_range, status, result);
+
+    return result;
+}
+
+std::pair<processing::statement_fields_parser::parse_result, std::vector<diagnostic_s>> parser_impl::
+    parse_stored_operand_field(
+        std::string field, semantics::range_provider field_range, processing::processing_status status)
+{
+    // the diagnostics of the parser used for the operands are moved here, the new ones are taken out again
+    collect_diags();
+    const size_t diags_before = diags().size();
+
+    auto result = parse_operand_field(std::move(field), false, std::move(field_range), std::move(status));
+
+    collect_diags();
+    std::vector<diagnostic_s> operand_diags(
+        std::make_move_iterator(diags().begin() + diags_before), std::make_move_iterator(diags().end()));
+    diags().erase(diags().begin() + diags_before, diags().end());
+
+    return { std::move(result), std::move(operand_diags) };
+}
+
+void parser_impl::add_stored_diagnostics(const std::vector<diagnostic_s>& diags)
+{
+    for (const auto& d : diags)
+        add_diagnostic(d);
 }
 
 void parser_impl::collect_diags() const
@@ -266,7 +367,8 @@ context::id_index parser_impl::parse_identifier(std::string value, range id_rang
     return hlasm_ctx->ids().add(std::move(value));
 }
 
-void parser_impl::parse_macro_operands(semantics::op_rem& line)
+void parser_impl::parse_macro_operands(
+    semantics::op_rem& line, const std::shared_ptr<context::statement_arena>& arena)
 {
     if (line.operands.size())
     {
@@ -291,7 +393,7 @@ void parser_impl::parse_macro_operands(semantics::op_rem& line)
         auto r = semantics::range_provider::union_range(
             line.operands.begin()->get()->operand_range, line.operands.back()->operand_range);
 
-        line.operands = parse_macro_operands(std::move(to_parse), r, std::move(ranges));
+        line.operands = parse_macro_operands(std::move(to_parse), r, std::move(ranges), arena);
     }
 }
 
@@ -331,8 +433,26 @@ void parser_impl::resolve_expression(expressions::ca_expr_ptr& expr) const
     }
 }
 
+std::shared_ptr<context::statement_arena> parser_impl::statement_memory() const
+{
+    // macro and copy member definitions are shared with other analyses, lookahead statements are released right away,
+    // the open code statements kept by the checkpoints keep the arena alive
+    if (!processor || processor->kind != processing::processing_kind::ORDINARY)
+        return nullptr;
+    return hlasm_ctx->statement_memory();
+}
+
 bool parser_impl::process_instruction()
 {
+    if (known_status_)
+    {
+        // attribute lookahead has already been checked
+        hlasm_ctx->set_source_position(collector.current_instruction().field_range.start);
+        proc_status = known_status_;
+        known_status_.reset();
+        return false;
+    }
+
     if (processor->kind == processing::processing_kind::ORDINARY
         && try_trigger_attribute_lookahead(collector.current_instruction(), { ctx, *lib_provider_ }, *state_listener_))
         return true;
@@ -356,7 +476,10 @@ bool parser_impl::process_statement()
     else
         hlasm_ctx->metrics.non_continued_statements++;
 
-    src_proc->process_hl_symbols(collector.extract_hl_symbols());
+    auto hl_symbols = collector.extract_hl_symbols();
+    if (checkpoints_active_)
+        statement_hl_symbols_ = hl_symbols;
+    src_proc->process_hl_symbols(std::move(hl_symbols));
     current_statement = stmt;
 
     return false;
@@ -372,9 +495,16 @@ context::shared_stmt_ptr parser_impl::get_next(const statement_processor& proc)
         reset();
     }
     processor = &proc;
+    // the operands and expressions created by the grammar are allocated together with the statement
+    collector.set_arena(statement_memory());
 
     if (proc.kind == processing::processing_kind::LOOKAHEAD)
+    {
+        skip_lookahead_statements(static_cast<const processing::lookahead_processor&>(proc));
         process_lookahead();
+    }
+    else if (checkpoints_active_)
+        process_ordinary_with_checkpoints();
     else
         process_ordinary();
 
@@ -384,10 +514,31 @@ context::shared_stmt_ptr parser_impl::get_next(const statement_processor& proc)
     current_statement = nullptr;
     collector.prepare_for_next_statement();
     proc_status.reset();
+    known_status_.reset();
 
     return ret_stmt;
 }
 
+void parser_impl::use_checkpoints(statement_checkpoints checkpoints)
+{
+    checkpoints_.emplace(checkpoints.ids());
+    previous_checkpoints_ = std::move(checkpoints);
+    checkpoints_active_ = true;
+}
+
+statement_checkpoints parser_impl::take_checkpoints()
+{
+    auto result = std::move(checkpoints_).value_or(statement_checkpoints());
+    checkpoints_.reset();
+    previous_checkpoints_ = statement_checkpoints();
+    checkpoints_active_ = false;
+    return result;
+}
+
+void parser_impl::set_two_stage_prediction(bool enabled) { two_stage_prediction_ = enabled; }
+
+void parser_impl::set_mach_operand_parser(bool enabled) { mach_operand_parser_ = enabled; }
+
 bool parser_impl::finished() const { return finished_flag; }
 
 void parser_impl::set_source_indices(const antlr4::Token* start, const antlr4::Token* stop)
@@ -471,36 +622,23 @@ void parser_impl::initialize(
     proc_status = proc_stat;
 }
 
-semantics::operand_list parser_impl::parse_macro_operands(
-    std::string operands, range field_range, std::vector<range> operand_ranges)
+semantics::operand_list parser_impl::parse_macro_operands(std::string operands,
+    range field_range,
+    std::vector<range> operand_ranges,
+    const std::shared_ptr<context::statement_arena>& arena)
 {
-    if (!rest_parser_)
-        rest_parser_ = create_parser_holder();
-
-    const parser_holder& h = *rest_parser_;
-
     semantics::range_provider tmp_provider(field_range, operand_ranges, semantics::adjusting_state::MACRO_REPARSE);
 
     parser_error_listener_ctx listener(*hlasm_ctx, std::nullopt, tmp_provider);
 
-    h.input->reset(operands);
-
-    h.lex->reset();
-    h.lex->set_file_offset(field_range.start);
-    h.lex->set_unlimited_line(true);
-
-    h.stream->reset();
-
-    h.parser->initialize(hlasm_ctx, tmp_provider, *proc_status);
-    h.parser->setErrorHandler(std::make_shared<error_strategy>());
-    h.parser->removeErrorListeners();
-    h.parser->addErrorListener(&listener);
-
-    h.parser->reset();
-
-    h.parser->collector.prepare_for_next_statement();
-
-    auto list = std::move(h.parser->macro_ops()->list);
+    auto list = parse_rest(operands,
+        field_range.start,
+        true,
+        tmp_provider,
+        *proc_status,
+        arena,
+        listener,
+        [](hlasmparser& p) { return std::move(p.macro_ops()->list); });
 
     collect_diags_from_child(listener);
 
@@ -525,6 +663,152 @@ void parser_impl::process_ordinary()
     }
 }
 
+namespace {
+const semantics::instruction_si& statement_instruction(const context::hlasm_statement& stmt)
+{
+    if (stmt.kind == context::statement_kind::RESOLVED)
+        return stmt.access_resolved()->instruction_ref();
+    else
+        return stmt.access_deferred()->instruction_ref();
+}
+
+// diagnostics left in operands by the parser are moved out during processing, so such statement cannot be reused
+bool has_operand_diagnostics(const context::hlasm_statement& stmt)
+{
+    if (stmt.kind != context::statement_kind::RESOLVED)
+        return false;
+
+    for (const auto& op : stmt.access_resolved()->operands_ref().value)
+    {
+        auto evaluable = dynamic_cast<const semantics::evaluable_operand*>(op.get());
+        if (!evaluable)
+            continue;
+        evaluable->collect_diags();
+        if (!evaluable->diags().empty())
+            return true;
+    }
+    return false;
+}
+} // namespace
+
+void parser_impl::process_ordinary_with_checkpoints()
+{
+    auto first_token = _input->LT(1);
+    // DBCS changes the meaning of the text without changing the text itself
+    if (first_token->getType() == antlr4::Token::EOF || input_lexer->double_byte_enabled())
+    {
+        process_ordinary();
+        return;
+    }
+
+    // the statement is recognized by its text, so it is reused even after changes in the lines before it
+    const size_t begin_index = first_token->getStartIndex();
+    const size_t begin_line = first_token->getLine();
+    const auto text = std::string_view(input_lexer->file_text()).substr(begin_index);
+    const auto format = input_lexer->get_source_format();
+    // statements revisited by AGO and AIF were already recorded by this analysis
+    auto checkpoints = checkpoints_->find(text, format);
+    if (checkpoints.empty())
+        checkpoints = previous_checkpoints_.find(text, format);
+    if (!checkpoints.empty() && process_checkpoint(begin_index, begin_line, checkpoints))
+        return;
+
+    auto diag_count = diags().size();
+    auto rest_diag_count = rest_parser_ ? rest_parser_->parser->diags().size() : 0;
+    auto syntax_errors = getNumberOfSyntaxErrors();
+    auto continued_statements = hlasm_ctx->metrics.continued_statements;
+    statement_hl_symbols_.clear();
+
+    process_ordinary();
+
+    if (!current_statement || finished_flag || !checkpoints_active_)
+        return;
+    if (diag_count != diags().size() || syntax_errors != getNumberOfSyntaxErrors()
+        || (rest_parser_ && rest_diag_count != rest_parser_->parser->diags().size()))
+        return;
+    if (has_operand_diagnostics(*current_statement))
+        return;
+
+    const auto& source = hlasm_ctx->current_source();
+    checkpoints_->add(statement_checkpoint { std::string(text.substr(0, source.end_index - begin_index)),
+        format,
+        begin_line,
+        source.end_line,
+        *proc_status,
+        current_statement,
+        std::move(statement_hl_symbols_),
+        continued_statements != hlasm_ctx->metrics.continued_statements });
+}
+
+bool parser_impl::process_checkpoint(
+    size_t begin_index, size_t begin_line, const std::vector<const statement_checkpoint*>& found)
+{
+    // the statements recorded on another line are provided with their ranges moved to this one
+    std::vector<statement_checkpoint> checkpoints;
+    checkpoints.reserve(found.size());
+    for (const auto* cp : found)
+        if (auto moved = cp->move_to(begin_line))
+            checkpoints.push_back(std::move(*moved));
+    if (checkpoints.empty())
+        return false;
+
+    // all the checkpoints were parsed from the same text
+    const auto& front = checkpoints.front();
+    const auto& instruction = statement_instruction(*front.statement);
+    const size_t end_index = begin_index + front.text.size();
+
+    hlasm_ctx->set_source_indices(begin_index, end_index, front.end_line);
+
+    if (processor->kind == processing::processing_kind::ORDINARY
+        && try_trigger_attribute_lookahead(instruction, { ctx, *lib_provider_ }, *state_listener_))
+    {
+        skip_statement(end_index);
+        return true;
+    }
+
+    hlasm_ctx->set_source_position(instruction.field_range.start);
+    auto status = processor->get_processing_status(instruction);
+
+    auto checkpoint = std::find_if(
+        checkpoints.begin(), checkpoints.end(), [&status](const auto& cp) { return cp.status == status; });
+    if (checkpoint == checkpoints.end())
+    {
+        // the statement has to be parsed for the new status
+        known_status_ = std::move(status);
+        return false;
+    }
+
+    skip_statement(end_index);
+
+    if (processor->kind == processing::processing_kind::ORDINARY
+        && try_trigger_attribute_lookahead(*checkpoint->statement, { ctx, *lib_provider_ }, *state_listener_))
+        return true;
+
+    if (checkpoint->continued)
+        hlasm_ctx->metrics.continued_statements++;
+    else
+        hlasm_ctx->metrics.non_continued_statements++;
+    hlasm_ctx->metrics.reused_statements++;
+
+    src_proc->process_hl_symbols(checkpoint->hl_symbols);
+    current_statement = checkpoint->statement;
+    checkpoints_->add(std::move(*checkpoint));
+
+    return true;
+}
+
+void parser_impl::skip_statement(size_t end_index)
+{
+    while (_input->LA(1) != antlr4::Token::EOF)
+    {
+        auto token = _input->LT(1);
+        bool last = token->getType() == lexing::lexer::EOLLN && token->getStopIndex() + 1 >= end_index;
+        _input->consume();
+        if (last)
+            break;
+    }
+}
+
 void parser_impl::process_lookahead()
 {
     auto look_lab_instr = dynamic_cast<hlasmparser&>(*this).look_lab_instr();
@@ -538,66 +822,93 @@ void parser_impl::process_lookahead()
     }
 }
 
-void parser_impl::parse_operands(const std::string& text, range text_range)
+void parser_impl::skip_lookahead_statements(const processing::lookahead_processor& proc)
 {
-    if (!rest_parser_)
-        rest_parser_ = create_parser_holder();
-
-    parser_holder& h = *rest_parser_;
+    // the skipped statements would be missing in the highlighting,
+    // DBCS and AINSERT records change the statements in a way the pre-scan does not see
+    if (src_proc->collects_hl_info() || input_lexer->double_byte_enabled() || input_lexer->ainsert_pending())
+        return;
 
-    parser_error_listener_ctx listener(*hlasm_ctx, std::nullopt);
+    const auto format = input_lexer->get_source_format();
+    if (!statement_index_ || statement_index_->format() != format)
+        statement_index_.emplace(input_lexer->file_text(), format, hlasm_ctx->ids());
 
-    h.input->reset(text);
+    // the input has to continue right after the last parsed statement
+    const auto& source = hlasm_ctx->current_source();
+    const auto& statements = statement_index_->statements();
+    const size_t first = statement_index_->find(source.end_index);
+    if (first == statements.size() || statements[first].line != source.end_line + 1)
+        return;
 
-    h.lex->reset();
-    h.lex->set_file_offset(text_range.start);
-    h.lex->set_unlimited_line(false);
+    // the last statement is always parsed, so that the end of the input is reached in the usual way
+    size_t next = first;
+    while (next + 1 < statements.size()
+        && !proc.statement_relevant(statements[next].has_label, statements[next].instruction))
+        ++next;
 
-    h.stream->reset();
+    if (next != first)
+        rewind_input(context::source_position(statements[next].line, statements[next].offset));
+}
 
-    h.parser->initialize(hlasm_ctx, provider, *proc_status);
-    h.parser->setErrorHandler(std::make_shared<error_strategy>());
-    h.parser->removeErrorListeners();
-    h.parser->addErrorListener(&listener);
+void parser_impl::parse_operands(const std::string& text, range text_range)
+{
+    const auto arena = statement_memory();
+    auto& [format, opcode] = *proc_status;
+    if (mach_operand_parser_ && format.form == processing::processing_form::MACH
+        && format.occurence == processing::operand_occurence::PRESENT)
+    {
+        // the common machine operands do not need the grammar
+        if (auto field = mach_operand_parser(hlasm_ctx->ids(), provider, arena.get()).parse(text, text_range.start))
+        {
+            for (auto& symbol : field->hl_symbols)
+                collector.add_hl_symbol(std::move(symbol));
+            collector.set_operand_remark_field(
+                std::move(field->operands), std::move(field->remarks), field->field_range);
+            process_statement();
+            return;
+        }
+    }
 
-    h.parser->reset();
+    parser_error_listener_ctx listener(*hlasm_ctx, std::nullopt);
 
-    h.parser->collector.prepare_for_next_statement();
+    auto parse = [&](auto rule) {
+        return parse_rest(text, text_range.start, false, provider, *proc_status, arena, listener, rule);
+    };
 
-    auto& [format, opcode] = *proc_status;
     if (format.occurence == processing::operand_occurence::ABSENT
         || format.form == processing::processing_form::UNKNOWN)
-        h.parser->op_rem_body_noop();
+        parse([](hlasmparser& p) { return p.op_rem_body_noop(); });
     else
     {
         switch (format.form)
         {
             case processing::processing_form::IGNORED:
-                h.parser->op_rem_body_ignored();
+                parse([](hlasmparser& p) { return p.op_rem_body_ignored(); });
                 break;
             case processing::processing_form::DEFERRED:
-                h.parser->op_rem_body_deferred();
+                parse([](hlasmparser& p) { return p.op_rem_body_deferred(); });
                 break;
             case processing::processing_form::CA:
-                h.parser->op_rem_body_ca();
+                parse([](hlasmparser& p) { return p.op_rem_body_ca(); });
                 break;
             case processing::processing_form::MAC: {
-                auto rule = h.parser->op_rem_body_mac();
-                auto line = std::move(rule->line);
-                auto line_range = rule->line_range;
-                parse_macro_operands(line);
-                h.parser->collector.set_operand_remark_field(
+                auto [line, line_range] = parse([](hlasmparser& p) {
+                    auto rule = p.op_rem_body_mac();
+                    return std::make_pair(std::move(rule->line), rule->line_range);
+                });
+                parse_macro_operands(line, arena);
+                rest_parser_->parser->collector.set_operand_remark_field(
                     std::move(line.operands), std::move(line.remarks), line_range);
             }
             break;
             case processing::processing_form::ASM:
-                h.parser->op_rem_body_asm();
+                parse([](hlasmparser& p) { return p.op_rem_body_asm(); });
                 break;
             case processing::processing_form::MACH:
-                h.parser->op_rem_body_mach();
+                parse([](hlasmparser& p) { return p.op_rem_body_mach(); });
                 break;
             case processing::processing_form::DAT:
-                h.parser->op_rem_body_dat();
+                parse([](hlasmparser& p) { return p.op_rem_body_dat(); });
                 break;
             default:
                 break;
@@ -606,7 +917,7 @@ void parser_impl::parse_operands(const std::string& text, range text_range)
 
     if (format.form != processing::processing_form::IGNORED)
     {
-        collector.append_operand_field(std::move(h.parser->collector));
+        collector.append_operand_field(std::move(rest_parser_->parser->collector));
         process_statement();
     }
 
@@ -615,9 +926,6 @@ void parser_impl::parse_operands(const std::string& text, range text_range)
 
 void parser_impl::parse_lookahead_operands(const std::string& text, range text_range)
 {
-    if (!rest_parser_)
-        rest_parser_ = create_parser_holder();
-
     if (proc_status->first.form == processing::processing_form::IGNORED)
     {
         process_statement();
@@ -639,29 +947,18 @@ void parser_impl::parse_lookahead_operands(const std::string& text, range text_r
         }
     }
 
-    const parser_holder& h = *rest_parser_;
-
     parser_error_listener_ctx listener(*hlasm_ctx, std::nullopt);
 
-    h.input->reset(text);
-
-    h.lex->reset();
-    h.lex->set_file_offset(text_range.start);
-    h.lex->set_unlimited_line(true);
-
-    h.stream->reset();
-
-    h.parser->initialize(hlasm_ctx, provider, *proc_status);
-    h.parser->setErrorHandler(std::make_shared<error_strategy>());
-    h.parser->removeErrorListeners();
-    h.parser->addErrorListener(&listener);
-
-    h.parser->reset();
-
-    h.parser->collector.prepare_for_next_statement();
-
-    h.parser->lookahead_operands_and_remarks();
+    parse_rest(text,
+        text_range.start,
+        true,
+        provider,
+        *proc_status,
+        nullptr,
+        listener,
+        [](hlasmparser& p) { return p.lookahead_operands_and_remarks(); });
 
+    const parser_holder& h = *rest_parser_;
     h.parser->collector.clear_hl_symbols();
     collector.append_operand_field(std::move(h.parser->collector));
 
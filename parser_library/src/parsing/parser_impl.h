@@ -20,11 +20,14 @@
 #include "context/hlasm_context.h"
 #include "diagnosable.h"
 #include "lexing/lexer.h"
+#include "operand_field_cache.h"
 #include "processing/opencode_provider.h"
+#include "processing/statement_processors/lookahead_processor.h"
 #include "processing/statement_fields_parser.h"
 #include "processing/statement_providers/statement_provider.h"
 #include "semantics/collector.h"
 #include "semantics/source_info_processor.h"
+#include "statement_checkpoints.h"
 
 namespace hlasm_plugin::parser_library::lexing {
 class input_source;
@@ -38,6 +41,7 @@ using self_def_t = std::int32_t;
 
 struct parser_holder;
 class hlasmparser;
+class parser_error_listener_ctx;
 
 // class providing methods helpful for parsing and methods modifying parsing process
 class parser_impl : public antlr4::Parser,
@@ -65,9 +69,21 @@ public:
         bool after_substitution,
         semantics::range_provider field_range,
         processing::processing_status status) override;
+    std::pair<processing::statement_fields_parser::parse_result, std::vector<diagnostic_s>> parse_stored_operand_field(
+        std::string field, semantics::range_provider field_range, processing::processing_status status) override;
+    void add_stored_diagnostics(const std::vector<diagnostic_s>& diags) override;
 
     context::shared_stmt_ptr get_next(const processing::statement_processor& processor) override;
 
+    // records parsed open code statements into the checkpoints and provides the recorded ones instead of parsing
+    void use_checkpoints(statement_checkpoints checkpoints);
+    statement_checkpoints take_checkpoints();
+
+    // operand fields are first parsed with the SLL prediction and reparsed with the full LL prediction only on failure
+    void set_two_stage_prediction(bool enabled);
+    // the common machine operand fields are parsed without the grammar
+    void set_mach_operand_parser(bool enabled);
+
     void collect_diags() const override;
     std::vector<antlr4::ParserRuleContext*> tree;
 
@@ -82,7 +98,7 @@ protected:
     self_def_t parse_self_def_term(const std::string& option, const std::string& value, range term_range);
     context::data_attr_kind get_attribute(std::string attr_data, range data_range);
     context::id_index parse_identifier(std::string value, range id_range);
-    void parse_macro_operands(semantics::op_rem& line);
+    void parse_macro_operands(semantics::op_rem& line, const std::shared_ptr<context::statement_arena>& arena);
 
     void resolve_expression(expressions::ca_expr_ptr& expr, context::SET_t_enum type) const;
     void resolve_expression(std::vector<expressions::ca_expr_ptr>& expr, context::SET_t_enum type) const;
@@ -117,16 +133,37 @@ protected:
 
 private:
     std::unique_ptr<parser_holder> rest_parser_;
+    // operand fields of model statements parsed after substitution
+    operand_field_cache operand_field_cache_;
     workspaces::parse_lib_provider* lib_provider_ = nullptr;
     processing::processing_state_listener* state_listener_ = nullptr;
     lexing::lexer* input_lexer = nullptr;
+    bool two_stage_prediction_ = true;
+    bool mach_operand_parser_ = true;
 
     void initialize(context::hlasm_context* hlasm_ctx,
         semantics::range_provider range_prov,
         processing::processing_status proc_stat);
 
-    semantics::operand_list parse_macro_operands(
-        std::string operands, range field_range, std::vector<range> operand_ranges);
+    semantics::operand_list parse_macro_operands(std::string operands,
+        range field_range,
+        std::vector<range> operand_ranges,
+        const std::shared_ptr<context::statement_arena>& arena);
+
+    // runs the rule of the rest parser on the text, the syntax errors are reported to the listener,
+    // the operands and expressions are created in the arena
+    template<typename Rule>
+    auto parse_rest(const std::string& text,
+        position file_offset,
+        bool unlimited_line,
+        const semantics::range_provider& range_prov,
+        const processing::processing_status& status,
+        const std::shared_ptr<context::statement_arena>& arena,
+        parser_error_listener_ctx& listener,
+        Rule rule);
+
+    // memory for the statement being parsed, nullptr for the general heap
+    std::shared_ptr<context::statement_arena> statement_memory() const;
 
     // process methods return true if attribute lookahead needed
     bool process_instruction();
@@ -134,6 +171,16 @@ private:
 
     void process_ordinary();
     void process_lookahead();
+    // moves the input past the statements that cannot affect the lookahead
+    void skip_lookahead_statements(const processing::lookahead_processor& proc);
+
+    // parses the statement while recording it into the checkpoints, unless it can be provided from them
+    void process_ordinary_with_checkpoints();
+    // returns true if the statement was provided from one of the checkpoints
+    bool process_checkpoint(
+        size_t begin_index, size_t begin_line, const std::vector<const statement_checkpoint*>& found);
+    // consumes tokens of the statement ending at the offset
+    void skip_statement(size_t end_index);
 
     void parse_operands(const std::string& text, range text_range);
     void parse_lookahead_operands(const std::string& text, range text_range);
@@ -141,6 +188,19 @@ private:
     antlr4::misc::IntervalSet getExpectedTokens() override;
 
     bool input_tokens_invalidated = false;
+
+    // checkpoints of the previous analysis are only looked up, the current ones are recorded anew,
+    // so statements that disappeared from the text do not accumulate
+    // the current ones are looked up first, they provide the statements revisited by AGO and AIF
+    statement_checkpoints previous_checkpoints_;
+    std::optional<statement_checkpoints> checkpoints_;
+    // checkpoints cannot be used once the input is modified by AREAD or AINSERT
+    bool checkpoints_active_ = false;
+    // processing status determined before the statement was parsed
+    std::optional<processing::processing_status> known_status_;
+    std::vector<token_info> statement_hl_symbols_;
+    // statements of the source file pre-scanned for the lookahead
+    std::optional<lexing::statement_index> statement_index_;
 };
 
 // structure containing parser components
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "statement_checkpoints.h"
+
+#include <algorithm>
+
+#include "processing/statement.h"
+#include "semantics/concatenation.h"
+
+namespace hlasm_plugin::parser_library::parsing {
+
+namespace {
+std::optional<semantics::label_si> move_label(const semantics::label_si& label, position_t line_shift)
+{
+    using semantics::label_si_type;
+
+    auto field_range = shift_lines(label.field_range, line_shift);
+    switch (label.type)
+    {
+        case label_si_type::ORD:
+            return semantics::label_si(field_range, std::get<std::string>(label.value));
+        case label_si_type::MAC:
+            return semantics::label_si(
+                field_range, std::get<std::string>(label.value), semantics::label_si::mac_flag());
+        case label_si_type::SEQ: {
+            auto symbol = std::get<semantics::seq_sym>(label.value);
+            symbol.symbol_range = shift_lines(symbol.symbol_range, line_shift);
+            return semantics::label_si(field_range, symbol);
+        }
+        case label_si_type::CONC:
+            if (auto chain = semantics::concatenation_point::clone_chain(
+                    std::get<semantics::concat_chain>(label.value), line_shift))
+                return semantics::label_si(field_range, std::move(*chain));
+            return std::nullopt;
+        case label_si_type::EMPTY:
+            return semantics::label_si(field_range);
+        default:
+            return std::nullopt;
+    }
+}
+
+std::optional<semantics::instruction_si> move_instruction(
+    const semantics::instruction_si& instruction, position_t line_shift)
+{
+    using semantics::instruction_si_type;
+
+    auto field_range = shift_lines(instruction.field_range, line_shift);
+    switch (instruction.type)
+    {
+        case instruction_si_type::ORD:
+            return semantics::instruction_si(field_range, std::get<context::id_index>(instruction.value));
+        case instruction_si_type::CONC:
+            if (auto chain = semantics::concatenation_point::clone_chain(
+                    std::get<semantics::concat_chain>(instruction.value), line_shift))
+                return semantics::instruction_si(field_range, std::move(*chain));
+            return std::nullopt;
+        default:
+            return semantics::instruction_si(field_range);
+    }
+}
+
+semantics::remarks_si move_remarks(const semantics::remarks_si& remarks, position_t line_shift)
+{
+    std::vector<range> value;
+    value.reserve(remarks.value.size());
+    for (const auto& r : remarks.value)
+        value.push_back(shift_lines(r, line_shift));
+    return semantics::remarks_si(shift_lines(remarks.field_range, line_shift), std::move(value));
+}
+
+context::shared_stmt_ptr move_resolved(
+    const processing::resolved_statement& stmt, const processing::processing_status& status, position_t line_shift)
+{
+    auto label = move_label(stmt.label_ref(), line_shift);
+    auto instruction = move_instruction(stmt.instruction_ref(), line_shift);
+    if (!label || !instruction)
+        return nullptr;
+
+    const auto& operands = stmt.operands_ref();
+    semantics::operand_list ops;
+    ops.reserve(operands.value.size());
+    for (const auto& op : operands.value)
+    {
+        auto copy = op->clone(line_shift);
+        if (!copy)
+            return nullptr;
+        ops.push_back(std::move(copy));
+    }
+
+    auto stmt_si = std::make_shared<semantics::statement_si>(shift_lines(stmt.stmt_range_ref(), line_shift),
+        std::move(*label),
+        std::move(*instruction),
+        semantics::operands_si(shift_lines(operands.field_range, line_shift), std::move(ops)),
+        move_remarks(stmt.remarks_ref(), line_shift));
+    return std::make_shared<processing::resolved_statement_impl>(std::move(stmt_si), status);
+}
+
+context::shared_stmt_ptr move_deferred(const semantics::deferred_statement& stmt, position_t line_shift)
+{
+    const auto& deferred = stmt.deferred_ref();
+    if (!deferred.vars.empty())
+        return nullptr;
+
+    auto label = move_label(stmt.label_ref(), line_shift);
+    auto instruction = move_instruction(stmt.instruction_ref(), line_shift);
+    if (!label || !instruction)
+        return nullptr;
+
+    return std::make_shared<semantics::statement_si_deferred>(shift_lines(stmt.stmt_range_ref(), line_shift),
+        std::move(*label),
+        std::move(*instruction),
+        semantics::deferred_operands_si(shift_lines(deferred.field_range, line_shift), deferred.value, {}));
+}
+} // namespace
+
+bool statement_checkpoint::matches(std::string_view input, const lexing::source_format& input_format) const
+{
+    if (format != input_format || input.substr(0, text.size()) != text)
+        return false;
+    // the statement ended with its line, otherwise it was the end of the input
+    return (!text.empty() && (text.back() == '\n' || text.back() == '\r')) || input.size() == text.size();
+}
+
+std::optional<statement_checkpoint> statement_checkpoint::move_to(size_t new_line) const
+{
+    if (new_line == line)
+        return *this;
+
+    // the line numbers wrap around, so the same shift moves the ranges up as well as down
+    const position_t line_shift = (position_t)new_line - (position_t)line;
+
+    context::shared_stmt_ptr moved;
+    if (statement->kind == context::statement_kind::RESOLVED)
+        moved = move_resolved(*statement->access_resolved(), status, line_shift);
+    else if (statement->kind == context::statement_kind::DEFERRED)
+        moved = move_deferred(*statement->access_deferred(), line_shift);
+    if (!moved)
+        return std::nullopt;
+
+    std::vector<token_info> symbols;
+    symbols.reserve(hl_symbols.size());
+    for (const auto& symbol : hl_symbols)
+        symbols.emplace_back(shift_lines(symbol.token_range, line_shift), symbol.scope);
+
+    return statement_checkpoint {
+        text, format, new_line, end_line - line + new_line, status, std::move(moved), std::move(symbols), continued
+    };
+}
+
+statement_checkpoints::statement_checkpoints(std::shared_ptr<context::id_storage> ids)
+    : ids_(std::move(ids))
+{}
+
+const std::shared_ptr<context::id_storage>& statement_checkpoints::ids() const { return ids_; }
+
+size_t statement_checkpoints::first_line_hash(std::string_view text)
+{
+    return std::hash<std::string_view>()(text.substr(0, text.find_first_of("\r\n")));
+}
+
+void statement_checkpoints::add(statement_checkpoint checkpoint)
+{
+    auto& v = checkpoints_[first_line_hash(checkpoint.text)];
+    if (std::any_of(v.begin(), v.end(), [&checkpoint](const auto& cp) {
+            return cp.status == checkpoint.status && cp.format == checkpoint.format && cp.text == checkpoint.text;
+        }))
+        return;
+    v.push_back(std::move(checkpoint));
+}
+
+std::vector<const statement_checkpoint*> statement_checkpoints::find(
+    std::string_view input, const lexing::source_format& format) const
+{
+    std::vector<const statement_checkpoint*> result;
+    if (auto it = checkpoints_.find(first_line_hash(input)); it != checkpoints_.end())
+    {
+        for (const auto& cp : it->second)
+            if (cp.matches(input, format))
+                result.push_back(&cp);
+    }
+    return result;
+}
+
+size_t statement_checkpoints::size() const
+{
+    size_t result = 0;
+    for (const auto& [_, v] : checkpoints_)
+        result += v.size();
+    return result;
+}
+
+} // namespace hlasm_plugin::parser_library::parsing
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#ifndef HLASMPLUGIN_PARSERLIBRARY_STATEMENT_CHECKPOINTS_H
+#define HLASMPLUGIN_PARSERLIBRARY_STATEMENT_CHECKPOINTS_H
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "context/hlasm_statement.h"
+#include "context/id_storage.h"
+#include "lexing/logical_lines.h"
+#include "processing/op_code.h"
+#include "semantics/highlighting_info.h"
+
+namespace hlasm_plugin::parser_library::parsing {
+
+// open code statement parsed at a statement boundary
+// holds everything the parser produced for it, so it can be provided again without parsing
+struct statement_checkpoint
+{
+    // text of the statement from its first token up to the beginning of the next statement
+    std::string text;
+    // columns the text was split into fields with (ICTL)
+    lexing::source_format format;
+    // lines of the statement beginning and end
+    size_t line;
+    size_t end_line;
+    // status the operands were parsed with
+    processing::processing_status status;
+    // keeps the statement arena of the analysis that parsed it alive
+    context::shared_stmt_ptr statement;
+    std::vector<token_info> hl_symbols;
+    bool continued;
+
+    // the input starts with the text of the statement and the lexer splits it the same way
+    bool matches(std::string_view input, const lexing::source_format& input_format) const;
+
+    // returns the checkpoint of the same statement starting on another line, with all the ranges moved there
+    // nothing is returned when the statement contains parts that cannot be copied (variable symbols, CA operands)
+    std::optional<statement_checkpoint> move_to(size_t new_line) const;
+};
+
+// checkpoints of the open code statements indexed by the first line of their text
+// they outlive the analysis, so the next analysis of the same file can skip parsing the statements
+// whose text did not change, even when lines were added or removed in front of them,
+// and within the analysis they provide the statements revisited by AGO and AIF
+// only the parsing is skipped, the statements are still processed from the beginning of the file,
+// because the analysis context cannot be copied at a statement boundary
+class statement_checkpoints
+{
+public:
+    statement_checkpoints() = default;
+    explicit statement_checkpoints(std::shared_ptr<context::id_storage> ids);
+
+    // identifiers the recorded statements refer to
+    const std::shared_ptr<context::id_storage>& ids() const;
+
+    // a checkpoint equal to an already recorded one is not added again, even if it starts on another line
+    void add(statement_checkpoint checkpoint);
+    // returns the checkpoints of the statements the input starts with, wherever they were recorded
+    std::vector<const statement_checkpoint*> find(std::string_view input, const lexing::source_format& format) const;
+
+    size_t size() const;
+
+private:
+    std::shared_ptr<context::id_storage> ids_;
+    // keyed by the hash of the text up to the first line break, the collisions are sorted out by matches
+    std::unordered_map<size_t, std::vector<statement_checkpoint>> checkpoints_;
+
+    static size_t first_line_hash(std::string_view text);
+};
+
+} // namespace hlasm_plugin::parser_library::parsing
+
+#endif
@@ -16,6 +16,7 @@
 
 #include <functional>
 #include <memory>
+#include <stack>
 
 #include "processing/context_manager.h"
 #include "semantics/operand_impls.h"
@@ -35,6 +35,8 @@ struct op_code
         , type(type)
     {}
 
+    bool operator==(const op_code& oth) const { return value == oth.value && type == oth.type; }
+
     context::id_index value;
     context::instruction_type type;
 };
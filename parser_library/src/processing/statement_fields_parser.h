@@ -16,6 +16,7 @@
 #define PROCESSING_STATEMENT_FIELDS_PARSER_H
 
 #include "context/hlasm_context.h"
+#include "diagnostic.h"
 #include "processing/op_code.h"
 #include "semantics/range_provider.h"
 #include "semantics/statement_fields.h"
@@ -36,6 +37,14 @@ public:
         semantics::range_provider field_range,
         processing::processing_status status) = 0;
 
+    // Parses the operand field of a statement stored in a macro or copy member definition.
+    // The definitions may be shared by several analyses, so the diagnostics are returned
+    // instead of being reported, every analysis reports them with add_stored_diagnostics.
+    virtual std::pair<parse_result, std::vector<diagnostic_s>> parse_stored_operand_field(
+        std::string field, semantics::range_provider field_range, processing::processing_status status) = 0;
+
+    virtual void add_stored_diagnostics(const std::vector<diagnostic_s>& diags) = 0;
+
     virtual ~statement_fields_parser() = default;
 };
 
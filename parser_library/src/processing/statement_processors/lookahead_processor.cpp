@@ -88,6 +88,15 @@ bool lookahead_processor::finished() { return finished_flag_; }
 
 void lookahead_processor::collect_diags() const {}
 
+bool lookahead_processor::statement_relevant(bool has_label, context::id_index instruction) const
+{
+    if (has_label || !instruction)
+        return true;
+
+    auto opcode = hlasm_ctx.get_operation_code(instruction).opcode;
+    return opcode == macro_id || opcode == mend_id || opcode == copy_id;
+}
+
 lookahead_processor::lookahead_processor(analyzing_context ctx,
     branching_provider& branch_provider,
     processing_state_listener& listener,
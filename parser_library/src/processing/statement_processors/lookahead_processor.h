@@ -56,6 +56,10 @@ public:
 
     void collect_diags() const override;
 
+    // returns false for statements that cannot affect the lookahead, so they do not need to be provided at all
+    // the instruction is nullptr when it is not an ordinary symbol
+    bool statement_relevant(bool has_label, context::id_index instruction) const;
+
 private:
     void process_MACRO();
     void process_MEND();
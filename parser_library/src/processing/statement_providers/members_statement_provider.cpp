@@ -14,6 +14,8 @@
 
 #include "members_statement_provider.h"
 
+#include "processing/statement_processors/lookahead_processor.h"
+
 namespace hlasm_plugin::parser_library::processing {
 
 members_statement_provider::members_statement_provider(const statement_provider_kind kind,
@@ -35,6 +37,11 @@ context::shared_stmt_ptr members_statement_provider::get_next(const statement_pr
 
     auto cache = get_next();
 
+    // the stored statements that cannot affect the lookahead are skipped without resolving their operands
+    if (processor.kind == processing_kind::LOOKAHEAD)
+        while (cache && !lookahead_relevant(static_cast<const lookahead_processor&>(processor), *cache))
+            cache = get_next();
+
     if (!cache)
         return nullptr;
 
@@ -80,10 +87,23 @@ const semantics::instruction_si& members_statement_provider::retrieve_instructio
     }
 }
 
+bool members_statement_provider::lookahead_relevant(
+    const lookahead_processor& processor, const context::statement_cache& cache) const
+{
+    const auto& base = *cache.get_base();
+    const auto& label = base.kind == context::statement_kind::RESOLVED ? base.access_resolved()->label_ref()
+                                                                       : base.access_deferred()->label_ref();
+    const auto& instruction = retrieve_instruction(cache);
+
+    return processor.statement_relevant(label.type != semantics::label_si_type::EMPTY,
+        instruction.type == semantics::instruction_si_type::CONC ? nullptr
+                                                                 : std::get<context::id_index>(instruction.value));
+}
+
 void members_statement_provider::fill_cache(
     context::statement_cache& cache, const semantics::deferred_statement& def_stmt, const processing_status& status)
 {
-    context::statement_cache::cached_statement_t ptr;
+    std::shared_ptr<semantics::statement_si_defer_done> ptr;
     auto def_impl = std::dynamic_pointer_cast<const semantics::statement_si_deferred>(cache.get_base());
 
     if (status.first.occurence == operand_occurence::ABSENT || status.first.form == processing_form::UNKNOWN
@@ -96,14 +116,15 @@ void members_statement_provider::fill_cache(
     }
     else
     {
-        auto [op, rem] = parser.parse_operand_field(def_stmt.deferred_ref().value,
-            false,
+        auto [fields, diags] = parser.parse_stored_operand_field(def_stmt.deferred_ref().value,
             semantics::range_provider(def_stmt.deferred_ref().field_range, semantics::adjusting_state::NONE),
             status);
 
-        ptr = std::make_shared<semantics::statement_si_defer_done>(def_impl, std::move(op), std::move(rem));
+        ptr = std::make_shared<semantics::statement_si_defer_done>(
+            def_impl, std::move(fields.first), std::move(fields.second));
+        ptr->operand_diags = std::move(diags);
     }
-    cache.insert(status.first.form, ptr);
+    cache.insert(status.first.form, std::move(ptr));
 }
 
 context::shared_stmt_ptr members_statement_provider::preprocess_deferred(
@@ -119,7 +140,14 @@ context::shared_stmt_ptr members_statement_provider::preprocess_deferred(
     if (!cache.contains(status.first.form))
         fill_cache(cache, def_stmt, status);
 
-    return std::make_shared<resolved_statement_impl>(cache.get(status.first.form), status);
+    auto stmt = cache.get(status.first.form);
+
+    // the statement may have been parsed by another analysis sharing the definition
+    const auto* done = dynamic_cast<const semantics::statement_si_defer_done*>(stmt.get());
+    if (done && !done->operand_diags.empty() && reported_statements_.emplace(&cache, status.first.form).second)
+        parser.add_stored_diagnostics(done->operand_diags);
+
+    return std::make_shared<resolved_statement_impl>(std::move(stmt), status);
 }
 
 } // namespace hlasm_plugin::parser_library::processing
@@ -15,6 +15,9 @@
 #ifndef PROCESSING_MEMBERS_STATEMENT_PROVIDER_H
 #define PROCESSING_MEMBERS_STATEMENT_PROVIDER_H
 
+#include <set>
+#include <utility>
+
 #include "context/hlasm_context.h"
 #include "expressions/evaluation_context.h"
 #include "processing/processing_state_listener.h"
@@ -23,6 +26,8 @@
 
 namespace hlasm_plugin::parser_library::processing {
 
+class lookahead_processor;
+
 // common class for copy and macro statement providers (provider of copy and macro members)
 class members_statement_provider : public statement_provider
 {
@@ -45,12 +50,16 @@ protected:
 
 private:
     const semantics::instruction_si& retrieve_instruction(const context::statement_cache& cache) const;
+    bool lookahead_relevant(const lookahead_processor& processor, const context::statement_cache& cache) const;
 
     void fill_cache(context::statement_cache& cache,
         const semantics::deferred_statement& def_stmt,
         const processing_status& status);
 
     context::shared_stmt_ptr preprocess_deferred(const statement_processor& processor, context::statement_cache& cache);
+
+    // stored statements whose operand diagnostics were already reported in this analysis
+    std::set<std::pair<const context::statement_cache*, processing_form>> reported_statements_;
 };
 
 } // namespace hlasm_plugin::parser_library::processing
@@ -176,6 +176,8 @@ void collector::append_operand_field(collector&& c)
         hl_symbols_.push_back(std::move(symbol));
 }
 
+void collector::set_arena(std::shared_ptr<context::statement_arena> arena) { arena_ = std::move(arena); }
+
 const instruction_si& collector::peek_instruction() { return *instr_; }
 
 context::shared_stmt_ptr collector::extract_statement(processing::processing_status status, range& statement_range)
@@ -195,7 +197,7 @@ context::shared_stmt_ptr collector::extract_statement(processing::processing_sta
     {
         if (!def_)
             def_.emplace(instr_->field_range, "", std::vector<vs_ptr>());
-        return std::make_shared<statement_si_deferred>(
+        return context::make_arena_shared<statement_si_deferred>(arena_,
             range_provider::union_range(lbl_->field_range, def_->field_range),
             std::move(*lbl_),
             std::move(*instr_),
@@ -210,13 +212,14 @@ context::shared_stmt_ptr collector::extract_statement(processing::processing_sta
         for (size_t i = 0; i < op_->value.size(); i++)
         {
             if (!op_->value[i])
-                op_->value[i] = std::make_unique<empty_operand>(instr_.value().field_range);
+                op_->value[i] = context::make_arena_unique<empty_operand>(arena_.get(), instr_.value().field_range);
         }
 
         statement_range = range_provider::union_range(lbl_->field_range, op_->field_range);
-        auto stmt_si = std::make_shared<statement_si>(
-            statement_range, std::move(*lbl_), std::move(*instr_), std::move(*op_), std::move(*rem_));
-        return std::make_shared<processing::resolved_statement_impl>(std::move(stmt_si), std::move(status));
+        auto stmt_si = context::make_arena_shared<statement_si>(
+            arena_, statement_range, std::move(*lbl_), std::move(*instr_), std::move(*op_), std::move(*rem_));
+        return context::make_arena_shared<processing::resolved_statement_impl>(
+            arena_, std::move(stmt_si), std::move(status));
     }
 }
 
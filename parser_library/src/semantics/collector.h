@@ -19,6 +19,7 @@
 
 #include "antlr4-runtime.h"
 
+#include "context/statement_arena.h"
 #include "processing/op_code.h"
 #include "source_info_processor.h"
 #include "statement.h"
@@ -57,6 +58,10 @@ public:
 
     void append_operand_field(collector&& c);
 
+    // arena of the statement being collected and of its operands and expressions, nullptr stands for the heap
+    context::statement_arena* arena() const { return arena_.get(); }
+    void set_arena(std::shared_ptr<context::statement_arena> arena);
+
     const instruction_si& peek_instruction();
     context::shared_stmt_ptr extract_statement(processing::processing_status status, range& statement_range);
     std::vector<token_info> extract_hl_symbols();
@@ -69,6 +74,7 @@ private:
     std::optional<remarks_si> rem_;
     std::optional<deferred_operands_si> def_;
     std::vector<token_info> hl_symbols_;
+    std::shared_ptr<context::statement_arena> arena_;
     bool lsp_symbols_extracted_;
     bool hl_symbols_extracted_;
 
@@ -172,6 +172,20 @@ var_sym_conc* concatenation_point::contains_var_sym(
     return nullptr;
 }
 
+std::optional<concat_chain> concatenation_point::clone_chain(const concat_chain& chain, position_t line_shift)
+{
+    concat_chain ret;
+    ret.reserve(chain.size());
+    for (const auto& point : chain)
+    {
+        auto copy = point->clone(line_shift);
+        if (!copy)
+            return std::nullopt;
+        ret.push_back(std::move(copy));
+    }
+    return ret;
+}
+
 std::set<context::id_index> concatenation_point::get_undefined_attributed_symbols(
     const concat_chain& chain, const expressions::evaluation_context& eval_ctx)
 {
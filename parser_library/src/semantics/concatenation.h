@@ -16,12 +16,14 @@
 #define SEMANTICS_CONCATENATION_H
 
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
 
 #include "context/common_types.h"
 #include "context/id_storage.h"
+#include "range.h"
 
 // this file is a composition of structures that create concat_chain
 // concat_chain is used to represent model statement fields
@@ -64,6 +66,9 @@ struct concatenation_point
 
     static var_sym_conc* contains_var_sym(concat_chain::const_iterator begin, concat_chain::const_iterator end);
 
+    // returns a deep copy of the chain moved by the number of lines, chains with variable symbols are not copied
+    static std::optional<concat_chain> clone_chain(const concat_chain& chain, position_t line_shift = 0);
+
     static std::set<context::id_index> get_undefined_attributed_symbols(
         const concat_chain& chain, const expressions::evaluation_context& eval_ctx);
 
@@ -84,6 +89,9 @@ struct concatenation_point
 
     virtual std::string evaluate(const expressions::evaluation_context& eval_ctx) const = 0;
 
+    // returns a deep copy of the point moved by the number of lines or nullptr when it contains a variable symbol
+    virtual concat_point_ptr clone(position_t line_shift = 0) const = 0;
+
     virtual ~concatenation_point() = default;
 };
 
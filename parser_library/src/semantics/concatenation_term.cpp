@@ -26,6 +26,11 @@ char_str_conc::char_str_conc(std::string value, const range& conc_range)
 
 std::string char_str_conc::evaluate(const expressions::evaluation_context&) const { return value; }
 
+concat_point_ptr char_str_conc::clone(position_t line_shift) const
+{
+    return std::make_unique<char_str_conc>(value, shift_lines(conc_range, line_shift));
+}
+
 var_sym_conc::var_sym_conc(vs_ptr symbol)
     : concatenation_point(concat_type::VAR)
     , symbol(std::move(symbol))
@@ -38,6 +43,8 @@ std::string var_sym_conc::evaluate(const expressions::evaluation_context& eval_c
     return evaluate(std::move(value));
 }
 
+concat_point_ptr var_sym_conc::clone(position_t) const { return nullptr; }
+
 std::string var_sym_conc::evaluate(context::SET_t varsym_value)
 {
     switch (varsym_value.type)
@@ -59,12 +66,16 @@ dot_conc::dot_conc()
 
 std::string dot_conc::evaluate(const expressions::evaluation_context&) const { return "."; }
 
+concat_point_ptr dot_conc::clone(position_t) const { return std::make_unique<dot_conc>(); }
+
 equals_conc::equals_conc()
     : concatenation_point(concat_type::EQU)
 {}
 
 std::string equals_conc::evaluate(const expressions::evaluation_context&) const { return "="; }
 
+concat_point_ptr equals_conc::clone(position_t) const { return std::make_unique<equals_conc>(); }
+
 sublist_conc::sublist_conc(std::vector<concat_chain> list)
     : concatenation_point(concat_type::SUB)
     , list(std::move(list))
@@ -84,4 +95,18 @@ std::string sublist_conc::evaluate(const expressions::evaluation_context& eval_c
     return ret;
 }
 
+concat_point_ptr sublist_conc::clone(position_t line_shift) const
+{
+    std::vector<concat_chain> result;
+    result.reserve(list.size());
+    for (const auto& chain : list)
+    {
+        auto copy = clone_chain(chain, line_shift);
+        if (!copy)
+            return nullptr;
+        result.push_back(std::move(*copy));
+    }
+    return std::make_unique<sublist_conc>(std::move(result));
+}
+
 } // namespace hlasm_plugin::parser_library::semantics
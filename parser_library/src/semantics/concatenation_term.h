@@ -32,6 +32,8 @@ struct char_str_conc : concatenation_point
     range conc_range;
 
     std::string evaluate(const expressions::evaluation_context& eval_ctx) const override;
+
+    concat_point_ptr clone(position_t line_shift) const override;
 };
 
 // concatenation point representing variable symbol
@@ -43,6 +45,8 @@ struct var_sym_conc : concatenation_point
 
     std::string evaluate(const expressions::evaluation_context& eval_ctx) const override;
 
+    concat_point_ptr clone(position_t line_shift) const override;
+
     static std::string evaluate(context::SET_t varsym_value);
 };
 
@@ -52,6 +56,8 @@ struct dot_conc : concatenation_point
     dot_conc();
 
     std::string evaluate(const expressions::evaluation_context& eval_ctx) const override;
+
+    concat_point_ptr clone(position_t line_shift) const override;
 };
 
 // concatenation point representing equals sign
@@ -60,6 +66,8 @@ struct equals_conc : concatenation_point
     equals_conc();
 
     std::string evaluate(const expressions::evaluation_context& eval_ctx) const override;
+
+    concat_point_ptr clone(position_t line_shift) const override;
 };
 
 // concatenation point representing macro operand sublist
@@ -70,6 +78,8 @@ struct sublist_conc : concatenation_point
     std::vector<concat_chain> list;
 
     std::string evaluate(const expressions::evaluation_context& eval_ctx) const override;
+
+    concat_point_ptr clone(position_t line_shift) const override;
 };
 
 } // namespace hlasm_plugin::parser_library::semantics
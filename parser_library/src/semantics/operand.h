@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "context/id_storage.h"
+#include "context/statement_arena.h"
 #include "range.h"
 
 // the file contains structures representing operands in the operand field of statement
@@ -71,6 +72,9 @@ struct operand
 
     virtual void apply(operand_visitor& visitor) const = 0;
 
+    // returns a deep copy of the operand moved by the number of lines or nullptr when the operand cannot be copied
+    virtual std::unique_ptr<operand> clone(position_t line_shift = 0) const;
+
     model_operand* access_model();
     ca_operand* access_ca();
     macro_operand* access_mac();
@@ -81,6 +85,18 @@ struct operand
     const operand_type type;
     const range operand_range;
 
+    // operands parsed in open code are created in the statement arena of the analysis with make_arena_unique
+    static void* operator new(size_t size) { return context::statement_arena::allocate_object(size, nullptr); }
+    static void* operator new(size_t size, context::statement_arena* arena)
+    {
+        return context::statement_arena::allocate_object(size, arena);
+    }
+    static void operator delete(void* p) noexcept { context::statement_arena::release_object(p); }
+    static void operator delete(void* p, context::statement_arena*) noexcept
+    {
+        context::statement_arena::release_object(p);
+    }
+
     virtual ~operand() = default;
 };
 
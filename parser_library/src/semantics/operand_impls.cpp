@@ -20,6 +20,13 @@
 
 namespace hlasm_plugin::parser_library::semantics {
 
+namespace {
+expressions::mach_expr_ptr clone_expr(const expressions::mach_expr_ptr& expr, position_t line_shift)
+{
+    return expr ? expr->clone(line_shift) : nullptr;
+}
+} // namespace
+
 
 //***************** operand *********************
 
@@ -46,6 +53,8 @@ machine_operand* operand::access_mach() { return dynamic_cast<machine_operand*>(
 
 assembler_operand* operand::access_asm() { return dynamic_cast<assembler_operand*>(this); }
 
+operand_ptr operand::clone(position_t) const { return nullptr; }
+
 //***************** empty, model, evaluable operand *********************
 
 empty_operand::empty_operand(range operand_range)
@@ -54,6 +63,11 @@ empty_operand::empty_operand(range operand_range)
 
 void empty_operand::apply(operand_visitor& visitor) const { visitor.visit(*this); }
 
+operand_ptr empty_operand::clone(position_t line_shift) const
+{
+    return std::make_unique<empty_operand>(shift_lines(operand_range, line_shift));
+}
+
 model_operand::model_operand(concat_chain chain, range operand_range)
     : operand(operand_type::MODEL, std::move(operand_range))
     , chain(std::move(chain))
@@ -139,6 +153,14 @@ void expr_machine_operand::collect_diags() const { collect_diags_from_child(*exp
 
 void expr_machine_operand::apply(operand_visitor& visitor) const { visitor.visit(*this); }
 
+operand_ptr expr_machine_operand::clone(position_t line_shift) const
+{
+    auto ret = std::make_unique<expr_machine_operand>(
+        clone_expr(expression, line_shift), shift_lines(operand_range, line_shift));
+    ret->diags() = shift_lines(diags(), line_shift);
+    return ret;
+}
+
 //***************** address_machine_operand *********************
 
 address_machine_operand::address_machine_operand(expressions::mach_expr_ptr displacement,
@@ -234,6 +256,17 @@ void address_machine_operand::collect_diags() const
 
 void address_machine_operand::apply(operand_visitor& visitor) const { visitor.visit(*this); }
 
+operand_ptr address_machine_operand::clone(position_t line_shift) const
+{
+    auto ret = std::make_unique<address_machine_operand>(clone_expr(displacement, line_shift),
+        clone_expr(first_par, line_shift),
+        clone_expr(second_par, line_shift),
+        shift_lines(operand_range, line_shift),
+        state);
+    ret->diags() = shift_lines(diags(), line_shift);
+    return ret;
+}
+
 assembler_operand::assembler_operand(const asm_kind kind)
     : kind(kind)
 {}
@@ -316,6 +349,14 @@ void expr_assembler_operand::collect_diags() const { collect_diags_from_child(*e
 
 void expr_assembler_operand::apply(operand_visitor& visitor) const { visitor.visit(*this); }
 
+operand_ptr expr_assembler_operand::clone(position_t line_shift) const
+{
+    auto ret = std::make_unique<expr_assembler_operand>(
+        clone_expr(expression, line_shift), value_, shift_lines(operand_range, line_shift));
+    ret->diags() = shift_lines(diags(), line_shift);
+    return ret;
+}
+
 //***************** end_instr_machine_operand *********************
 
 using_instr_assembler_operand::using_instr_assembler_operand(
@@ -354,6 +395,14 @@ void using_instr_assembler_operand::collect_diags() const
 
 void using_instr_assembler_operand::apply(operand_visitor& visitor) const { visitor.visit(*this); }
 
+operand_ptr using_instr_assembler_operand::clone(position_t line_shift) const
+{
+    auto ret = std::make_unique<using_instr_assembler_operand>(
+        clone_expr(base, line_shift), clone_expr(end, line_shift), shift_lines(operand_range, line_shift));
+    ret->diags() = shift_lines(diags(), line_shift);
+    return ret;
+}
+
 //***************** complex_assempler_operand *********************
 complex_assembler_operand::complex_assembler_operand(
     std::string identifier, std::vector<std::unique_ptr<component_value_t>> values, range operand_range)
@@ -378,6 +427,17 @@ void complex_assembler_operand::collect_diags() const
 
 void complex_assembler_operand::apply(operand_visitor& visitor) const { visitor.visit(*this); }
 
+operand_ptr complex_assembler_operand::clone(position_t line_shift) const
+{
+    std::vector<std::unique_ptr<component_value_t>> values;
+    for (auto& val : value.values)
+        values.push_back(val->clone(line_shift));
+    auto ret = std::make_unique<complex_assembler_operand>(
+        value.identifier, std::move(values), shift_lines(operand_range, line_shift));
+    ret->diags() = shift_lines(diags(), line_shift);
+    return ret;
+}
+
 //***************** ca_operand *********************
 ca_operand::ca_operand(const ca_kind kind, range operand_range)
     : operand(operand_type::CA, std::move(operand_range))
@@ -500,6 +560,14 @@ macro_operand_chain::macro_operand_chain(concat_chain chain, range operand_range
 
 void macro_operand_chain::apply(operand_visitor& visitor) const { visitor.visit(*this); }
 
+operand_ptr macro_operand_chain::clone(position_t line_shift) const
+{
+    auto copy = concatenation_point::clone_chain(chain, line_shift);
+    if (!copy)
+        return nullptr;
+    return std::make_unique<macro_operand_chain>(std::move(*copy), shift_lines(operand_range, line_shift));
+}
+
 
 
 data_def_operand::data_def_operand(expressions::data_definition val, range operand_range)
@@ -563,6 +631,13 @@ void data_def_operand::collect_diags() const { collect_diags_from_child(*value);
 
 void data_def_operand::apply(operand_visitor& visitor) const { visitor.visit(*this); }
 
+operand_ptr data_def_operand::clone(position_t line_shift) const
+{
+    auto ret = std::make_unique<data_def_operand>(value->clone(line_shift), shift_lines(operand_range, line_shift));
+    ret->diags() = shift_lines(diags(), line_shift);
+    return ret;
+}
+
 string_assembler_operand::string_assembler_operand(std::string value, range operand_range)
     : evaluable_operand(operand_type::ASM, std::move(operand_range))
     , assembler_operand(asm_kind::STRING)
@@ -585,6 +660,13 @@ void string_assembler_operand::collect_diags() const
 
 void string_assembler_operand::apply(operand_visitor& visitor) const { visitor.visit(*this); }
 
+operand_ptr string_assembler_operand::clone(position_t line_shift) const
+{
+    auto ret = std::make_unique<string_assembler_operand>(value, shift_lines(operand_range, line_shift));
+    ret->diags() = shift_lines(diags(), line_shift);
+    return ret;
+}
+
 macro_operand_string::macro_operand_string(std::string value, const range operand_range)
     : macro_operand(mac_kind::STRING, operand_range)
     , value(std::move(value))
@@ -592,6 +674,11 @@ macro_operand_string::macro_operand_string(std::string value, const range operan
 
 void macro_operand_string::apply(operand_visitor& visitor) const { visitor.visit(*this); }
 
+operand_ptr macro_operand_string::clone(position_t line_shift) const
+{
+    return std::make_unique<macro_operand_string>(value, shift_lines(operand_range, line_shift));
+}
+
 macro_operand_chain* macro_operand::access_chain()
 {
     return kind == mac_kind::CHAIN ? static_cast<macro_operand_chain*>(this) : nullptr;
@@ -34,6 +34,8 @@ struct empty_operand final : operand
     empty_operand(const range operand_range);
 
     void apply(operand_visitor& visitor) const override;
+
+    operand_ptr clone(position_t line_shift) const override;
 };
 
 
@@ -117,6 +119,8 @@ struct expr_machine_operand final : machine_operand, simple_expr_operand
     void collect_diags() const override;
 
     void apply(operand_visitor& visitor) const override;
+
+    operand_ptr clone(position_t line_shift) const override;
 };
 
 
@@ -145,6 +149,8 @@ struct address_machine_operand final : machine_operand
     void collect_diags() const override;
 
     void apply(operand_visitor& visitor) const override;
+
+    operand_ptr clone(position_t line_shift) const override;
 };
 
 
@@ -195,6 +201,8 @@ public:
 
     void apply(operand_visitor& visitor) const override;
 
+    operand_ptr clone(position_t line_shift) const override;
+
 private:
     std::unique_ptr<checking::operand> get_operand_value_inner(
         expressions::mach_evaluate_info info, bool can_have_ordsym) const;
@@ -220,6 +228,8 @@ struct using_instr_assembler_operand final : assembler_operand
     void collect_diags() const override;
 
     void apply(operand_visitor& visitor) const override;
+
+    operand_ptr clone(position_t line_shift) const override;
 };
 
 
@@ -237,6 +247,7 @@ struct complex_assembler_operand final : assembler_operand
         {}
 
         virtual std::unique_ptr<checking::asm_operand> create_operand() const = 0;
+        virtual std::unique_ptr<component_value_t> clone(position_t line_shift = 0) const = 0;
         virtual ~component_value_t() = default;
 
         range op_range;
@@ -252,6 +263,10 @@ struct complex_assembler_operand final : assembler_operand
         {
             return std::make_unique<checking::one_operand>(value, op_range);
         }
+        std::unique_ptr<component_value_t> clone(position_t line_shift) const override
+        {
+            return std::make_unique<int_value_t>(value, shift_lines(op_range, line_shift));
+        }
         int value;
     };
     struct string_value_t final : component_value_t
@@ -265,6 +280,10 @@ struct complex_assembler_operand final : assembler_operand
         {
             return std::make_unique<checking::one_operand>(value, op_range);
         }
+        std::unique_ptr<component_value_t> clone(position_t line_shift) const override
+        {
+            return std::make_unique<string_value_t>(value, shift_lines(op_range, line_shift));
+        }
         std::string value;
     };
     struct composite_value_t final : component_value_t
@@ -281,6 +300,13 @@ struct complex_assembler_operand final : assembler_operand
                 ret.push_back(val->create_operand());
             return std::make_unique<checking::complex_operand>(identifier, std::move(ret));
         }
+        std::unique_ptr<component_value_t> clone(position_t line_shift) const override
+        {
+            std::vector<std::unique_ptr<component_value_t>> ret;
+            for (auto& val : values)
+                ret.push_back(val->clone(line_shift));
+            return std::make_unique<composite_value_t>(identifier, std::move(ret), shift_lines(op_range, line_shift));
+        }
 
         std::string identifier;
         std::vector<std::unique_ptr<component_value_t>> values;
@@ -300,6 +326,8 @@ struct complex_assembler_operand final : assembler_operand
     void collect_diags() const override;
 
     void apply(operand_visitor& visitor) const override;
+
+    operand_ptr clone(position_t line_shift) const override;
 };
 
 
@@ -320,6 +348,8 @@ struct string_assembler_operand : assembler_operand
     void collect_diags() const override;
 
     void apply(operand_visitor& visitor) const override;
+
+    operand_ptr clone(position_t line_shift) const override;
 };
 
 // data definition operand
@@ -342,6 +372,8 @@ struct data_def_operand final : evaluable_operand
     void collect_diags() const override;
 
     void apply(operand_visitor& visitor) const override;
+
+    operand_ptr clone(position_t line_shift) const override;
 };
 
 
@@ -462,6 +494,8 @@ struct macro_operand_chain final : macro_operand
     concat_chain chain;
 
     void apply(operand_visitor& visitor) const override;
+
+    operand_ptr clone(position_t line_shift) const override;
 };
 
 // macro instruction operand
@@ -472,6 +506,8 @@ struct macro_operand_string final : macro_operand
     std::string value;
 
     void apply(operand_visitor& visitor) const override;
+
+    operand_ptr clone(position_t line_shift) const override;
 };
 
 } // namespace hlasm_plugin::parser_library::semantics
@@ -14,9 +14,27 @@
 
 #include "range_provider.h"
 
+#include <cassert>
+
+#include "lexing/token.h"
+
 using namespace hlasm_plugin::parser_library;
 using namespace hlasm_plugin::parser_library::semantics;
 
+namespace {
+// returns the length of the token in characters, all the tokens in the parse tree come from the lexer
+size_t token_length(const antlr4::Token* token)
+{
+    auto start = token->getStartIndex();
+    auto stop = token->getStopIndex();
+    // the tokens conjured by the error recovery have no indices
+    if (start > stop || stop == (size_t)-1)
+        return stop - start + 1;
+    assert(dynamic_cast<const lexing::token*>(token));
+    return static_cast<const lexing::token*>(token)->get_char_length();
+}
+} // namespace
+
 range range_provider::union_range(const range& lhs, const range& rhs)
 {
     position ret[2];
@@ -44,7 +62,7 @@ range range_provider::get_range(const antlr4::Token* start, const antlr4::Token*
     if (stop)
     {
         ret.end.line = stop->getLine();
-        ret.end.column = stop->getCharPositionInLine() + stop->getStopIndex() - stop->getStartIndex() + 1;
+        ret.end.column = stop->getCharPositionInLine() + token_length(stop);
     }
     else // empty rule
     {
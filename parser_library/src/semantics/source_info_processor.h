@@ -38,6 +38,8 @@ public:
 
     const lines_info& semantic_tokens() const;
 
+    bool collects_hl_info() const { return collect_hl_info_; }
+
     // finishes collected data
     void finish();
 
@@ -16,6 +16,7 @@
 #define SEMANTICS_STATEMENT_H
 
 #include "context/hlasm_statement.h"
+#include "diagnostic.h"
 #include "statement_fields.h"
 
 // this file contains inherited structures from hlasm_statement that are used during the parsing
@@ -115,6 +116,8 @@ struct statement_si_defer_done : public complete_statement
 
     operands_si operands;
     remarks_si remarks;
+    // diagnostics produced by parsing the operands, reported by every analysis that uses the statement
+    std::vector<diagnostic_s> operand_diags;
 
     const label_si& label_ref() const override { return deferred_stmt->label_ref(); }
     const instruction_si& instruction_ref() const override { return deferred_stmt->instruction_ref(); }
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "dependency_index.h"
+
+namespace hlasm_plugin::parser_library::workspaces {
+
+const std::string* dependency_index::intern(const std::string& file_name) { return &*names_.insert(file_name).first; }
+
+const std::string* dependency_index::find(const std::string& file_name) const
+{
+    auto it = names_.find(file_name);
+    return it == names_.end() ? nullptr : &*it;
+}
+
+void dependency_index::release(const std::string* name)
+{
+    if (!dependencies_.count(name) && !dependants_.count(name))
+        names_.erase(names_.find(*name));
+}
+
+std::vector<std::string> dependency_index::to_vector(const name_set& names)
+{
+    std::vector<std::string> result;
+    result.reserve(names.size());
+    for (const auto* name : names)
+        result.push_back(*name);
+    return result;
+}
+
+void dependency_index::update(const std::string& dependant, const std::set<std::string>& dependencies)
+{
+    if (dependencies.empty() && !is_dependant(dependant))
+        return;
+
+    const auto* dependant_name = intern(dependant);
+    auto& current = dependencies_[dependant_name];
+
+    name_set updated;
+    for (const auto& dependency : dependencies)
+    {
+        const auto* dependency_name = intern(dependency);
+        updated.insert(dependency_name);
+        dependants_[dependency_name].insert(dependant_name);
+    }
+    std::swap(current, updated);
+
+    // the previous dependencies are released after the new ones are interned
+    for (const auto* dependency : updated)
+    {
+        if (dependencies.count(*dependency))
+            continue;
+        auto it = dependants_.find(dependency);
+        it->second.erase(dependant_name);
+        if (it->second.empty())
+        {
+            dependants_.erase(it);
+            release(dependency);
+        }
+    }
+}
+
+void dependency_index::remove(const std::string& dependant)
+{
+    auto dependant_name = find(dependant);
+    if (!dependant_name)
+        return;
+
+    auto it = dependencies_.find(dependant_name);
+    if (it == dependencies_.end())
+        return;
+
+    const auto removed = std::move(it->second);
+    dependencies_.erase(it);
+
+    for (const auto* dependency : removed)
+    {
+        auto dep_it = dependants_.find(dependency);
+        dep_it->second.erase(dependant_name);
+        if (dep_it->second.empty())
+        {
+            dependants_.erase(dep_it);
+            if (dependency != dependant_name)
+                release(dependency);
+        }
+    }
+    release(dependant_name);
+}
+
+bool dependency_index::is_dependant(const std::string& file_name) const
+{
+    auto name = find(file_name);
+    return name && dependencies_.count(name);
+}
+
+bool dependency_index::is_dependency(const std::string& file_name) const
+{
+    auto name = find(file_name);
+    return name && dependants_.count(name);
+}
+
+bool dependency_index::has_other_dependant(const std::string& dependency, const std::string& dependant) const
+{
+    auto name = find(dependency);
+    if (!name)
+        return false;
+    auto it = dependants_.find(name);
+    if (it == dependants_.end())
+        return false;
+    return it->second.size() > 1 || *(*it->second.begin()) != dependant;
+}
+
+std::vector<std::string> dependency_index::dependants_of(const std::string& file_name) const
+{
+    auto name = find(file_name);
+    if (!name)
+        return {};
+    auto it = dependants_.find(name);
+    if (it == dependants_.end())
+        return {};
+    return to_vector(it->second);
+}
+
+std::vector<std::string> dependency_index::dependants() const
+{
+    name_set all;
+    for (const auto& [dependant, _] : dependencies_)
+        all.insert(dependant);
+    return to_vector(all);
+}
+
+} // namespace hlasm_plugin::parser_library::workspaces
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#ifndef HLASMPLUGIN_PARSERLIBRARY_DEPENDENCY_INDEX_H
+#define HLASMPLUGIN_PARSERLIBRARY_DEPENDENCY_INDEX_H
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace hlasm_plugin::parser_library::workspaces {
+
+// Bidirectional index between the files that depend on others (open codes) and their dependencies
+// (macros and copy members), so that both directions can be queried without visiting all dependants.
+// File names are interned while an entry refers to them, the entries only keep pointers.
+class dependency_index
+{
+    struct name_less
+    {
+        bool operator()(const std::string* l, const std::string* r) const { return *l < *r; }
+    };
+    using name_set = std::set<const std::string*, name_less>;
+
+    std::unordered_set<std::string> names_;
+    std::unordered_map<const std::string*, name_set> dependencies_;
+    std::unordered_map<const std::string*, name_set> dependants_;
+
+    const std::string* intern(const std::string& file_name);
+    const std::string* find(const std::string& file_name) const;
+    // forgets the interned name, once it is neither a dependant nor a dependency
+    void release(const std::string* name);
+
+    static std::vector<std::string> to_vector(const name_set& names);
+
+public:
+    // Replaces the dependencies of the dependant.
+    // A file without dependencies becomes a dependant only after it has some.
+    void update(const std::string& dependant, const std::set<std::string>& dependencies);
+    // Removes the dependant with all its dependencies.
+    void remove(const std::string& dependant);
+
+    bool is_dependant(const std::string& file_name) const;
+    bool is_dependency(const std::string& file_name) const;
+    // Returns true, if there is a dependant other than the specified one that depends on the dependency.
+    bool has_other_dependant(const std::string& dependency, const std::string& dependant) const;
+
+    // Returns dependants of the file sorted by their names.
+    std::vector<std::string> dependants_of(const std::string& file_name) const;
+    // Returns all dependants sorted by their names.
+    std::vector<std::string> dependants() const;
+
+    // Returns the number of the file names the index keeps.
+    size_t names_count() const { return names_.size(); }
+};
+
+} // namespace hlasm_plugin::parser_library::workspaces
+
+#endif
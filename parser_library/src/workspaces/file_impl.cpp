@@ -15,16 +15,39 @@
 
 #include "file_impl.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <codecvt>
+#include <cstdint>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <locale>
 #include <string>
+#include <utility>
 
 
 namespace hlasm_plugin::parser_library::workspaces {
 
+namespace {
+// The text is scanned a word at a time, the blocks without interesting bytes are skipped as a whole.
+constexpr uint64_t repeat_byte(unsigned char c) { return 0x0101010101010101ULL * c; }
+
+uint64_t load_word(const char* p)
+{
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+// returns non-zero value if any byte of the word is equal to c
+constexpr uint64_t has_byte(uint64_t word, unsigned char c)
+{
+    const uint64_t x = word ^ repeat_byte(c);
+    return (x - repeat_byte(0x01)) & ~x & repeat_byte(0x80);
+}
+} // namespace
+
 file_impl::file_impl(file_uri uri)
     : file_name_(std::move(uri))
     , text_()
@@ -38,7 +61,8 @@ const std::string& file_impl::get_text()
 {
     if (!up_to_date_)
         load_text();
-    return text_;
+    // the document keeps the text until it is requested again after a change
+    return *text_.text();
 }
 
 void file_impl::load_text()
@@ -47,13 +71,17 @@ void file_impl::load_text()
 
     if (fin)
     {
+        std::string text;
         fin.seekg(0, std::ios::end);
-        text_.resize((size_t)fin.tellg());
+        text.resize((size_t)fin.tellg());
         fin.seekg(0, std::ios::beg);
-        fin.read(&text_[0], text_.size());
+        fin.read(&text[0], text.size());
         fin.close();
 
-        text_ = replace_non_utf8_chars(text_);
+        // the text is copied only when there is something to replace
+        if (find_non_utf8_char(text) != text.size())
+            text = replace_non_utf8_chars(text);
+        text_ = text_document(std::move(text));
 
         up_to_date_ = true;
         bad_ = false;
@@ -61,7 +89,7 @@ void file_impl::load_text()
     }
     else
     {
-        text_ = "";
+        text_ = text_document();
         up_to_date_ = false;
         bad_ = true;
         // add_diagnostic(diagnostic_s{file_name_, {}, diagnostic_severity::error,
@@ -76,6 +104,20 @@ size_t find_newlines(const std::string& text, std::vector<size_t>& lines)
     bool was_r = false;
     for (size_t i = 0; i < text.size(); ++i)
     {
+        // skip the blocks without any line terminators
+        if (!was_r)
+        {
+            while (i + sizeof(uint64_t) <= text.size())
+            {
+                const auto word = load_word(text.data() + i);
+                if (has_byte(word, '\n') || has_byte(word, '\r'))
+                    break;
+                i += sizeof(uint64_t);
+            }
+            if (i == text.size())
+                break;
+        }
+
         char ch = text[i];
         if (was_r)
         {
@@ -109,13 +151,9 @@ size_t find_newlines(const std::string& text, std::vector<size_t>& lines)
 
 void file_impl::did_open(std::string new_text, version_t version)
 {
-    text_ = std::move(new_text);
+    text_ = text_document(std::move(new_text));
     version_ = version;
 
-    lines_ind_.clear();
-    lines_ind_.push_back(0);
-
-    find_newlines(text_, lines_ind_);
     up_to_date_ = true;
     bad_ = false;
     editing_ = true;
@@ -124,73 +162,23 @@ void file_impl::did_open(std::string new_text, version_t version)
 bool file_impl::get_lsp_editing() { return editing_; }
 
 
-// applies a change to the text and updates line begginings
+// applies a change to the text
 void file_impl::did_change(range range, std::string new_text)
 {
-    size_t range_end_line = (size_t)range.end.line;
-    size_t range_start_line = (size_t)range.start.line;
-
-    size_t begin = index_from_position(text_, lines_ind_, range.start);
-    size_t end = index_from_position(text_, lines_ind_, range.end);
-
-    text_.replace(begin, end - begin, new_text);
-
-    std::vector<size_t> new_lines;
-
-    find_newlines(new_text, new_lines);
-
-
-    size_t old_lines_count = range_end_line - range_start_line;
-    size_t new_lines_count = new_lines.size();
-
-    size_t char_diff = new_text.size() - (end - begin);
-
-    // add or remove lines depending on the difference
-    if (new_lines_count > old_lines_count)
-    {
-        size_t diff = new_lines_count - old_lines_count;
-        lines_ind_.insert(lines_ind_.end(), diff, 0);
-
-        for (size_t i = lines_ind_.size() - 1; i > range_end_line + diff; --i)
-        {
-            lines_ind_[i] = lines_ind_[i - diff] + char_diff;
-        }
-    }
-    else
-    {
-        size_t diff = old_lines_count - new_lines_count;
-
-        for (size_t i = range_start_line + 1 + new_lines_count; i < lines_ind_.size() - diff; ++i)
-        {
-            lines_ind_[i] = lines_ind_[i + diff] + char_diff;
-        }
-
-        for (size_t i = 0; i < diff; ++i)
-            lines_ind_.pop_back();
-    }
-
-
-    for (size_t i = range_start_line + 1; i <= range_start_line + new_lines_count; ++i)
-    {
-        lines_ind_[i] = new_lines[i - (size_t)range_start_line - 1] + begin;
-    }
-
+    text_.replace(range, new_text);
 
     ++version_;
 }
 
 void file_impl::did_change(std::string new_text)
 {
-    text_ = std::move(new_text);
-    lines_ind_.clear();
-    lines_ind_.push_back(0);
-    find_newlines(text_, lines_ind_);
+    text_ = text_document(std::move(new_text));
     ++version_;
 }
 
 void file_impl::did_close() { editing_ = false; }
 
-const std::string& file_impl::get_text_ref() { return text_; }
+const std::string& file_impl::get_text_ref() { return *text_.text(); }
 
 version_t file_impl::get_version() { return version_; }
 
@@ -232,13 +220,15 @@ bool utf8_four_byte_begin(char ch)
 
 size_t file_impl::index_from_position(const std::string& text, const std::vector<size_t>& line_indices, position loc)
 {
-    size_t end = (size_t)loc.column;
     if (loc.line >= line_indices.size())
         return text.size();
-    size_t i = line_indices[loc.line];
-    size_t utf16_counter = 0;
+    size_t utf16_count = (size_t)loc.column;
+    return advance_utf16(text, line_indices[loc.line], utf16_count);
+}
 
-    while (utf16_counter < end && i < text.size())
+size_t file_impl::advance_utf16(std::string_view text, size_t i, size_t& utf16_count)
+{
+    while (utf16_count > 0 && i < text.size())
     {
         if (!utf8_one_byte_begin(text[i]))
         {
@@ -263,67 +253,81 @@ size_t file_impl::index_from_position(const std::string& text, const std::vector
                 throw std::runtime_error("The text of the file is not in utf-8."); // WRONG UTF-8 input
 
             i += width;
-            utf16_counter += utf16_width;
+            utf16_count -= std::min<size_t>(utf16_width, utf16_count);
         }
         else
         {
             ++i;
-            ++utf16_counter;
+            --utf16_count;
         }
     }
     return i;
 }
 
-std::string file_impl::replace_non_utf8_chars(const std::string& text)
+namespace {
+size_t utf8_char_length(std::string_view text, size_t i)
+{
+    size_t ch_len = 0;
+    if (utf8_one_byte_begin(text[i]))
+        return 1;
+    else if (utf8_two_byte_begin(text[i]))
+        ch_len = 2;
+    else if (utf8_three_byte_begin(text[i]))
+        ch_len = 3;
+    else if (utf8_four_byte_begin(text[i]))
+        ch_len = 4;
+    else
+        return 0;
+
+    // check whether all subsequent bytes of one character begin with 10
+    for (size_t j = 1; j < ch_len; ++j)
+    {
+        if (i + j >= text.size() || !utf8_continue_byte(text[i + j]))
+            return 0;
+    }
+    return ch_len;
+}
+} // namespace
+
+size_t file_impl::find_non_utf8_char(std::string_view text)
 {
-    std::string ret;
-    ret.reserve(text.size());
     size_t i = 0;
     while (i < text.size())
     {
-        bool OK = true;
-        size_t ch_len = 0;
-        if (utf8_one_byte_begin(text[i]))
-            ch_len = 1;
-        else if (utf8_two_byte_begin(text[i]))
-            ch_len = 2;
-        else if (utf8_three_byte_begin(text[i]))
-            ch_len = 3;
-        else if (utf8_four_byte_begin(text[i]))
-            ch_len = 4;
-        else
-            OK = false;
+        // skip the blocks of ascii characters
+        while (i + sizeof(uint64_t) <= text.size() && !(load_word(text.data() + i) & repeat_byte(0x80)))
+            i += sizeof(uint64_t);
+        if (i == text.size())
+            break;
+
+        const auto ch_len = utf8_char_length(text, i);
+        if (!ch_len)
+            return i;
+        i += ch_len;
+    }
+    return text.size();
+}
 
-        // check whether all subsequent bytes of one character begin with 10
-        if (OK)
-        {
-            for (size_t j = 1; j < ch_len; ++j)
-            {
-                if (i + j >= text.size() || !utf8_continue_byte(text[i + j]))
-                {
-                    OK = false; // we consider the first byte of character wrong
-                    break;
-                }
-            }
-        }
+std::string file_impl::replace_non_utf8_chars(const std::string& text)
+{
+    std::string ret;
+    ret.reserve(text.size());
 
-        if (OK)
-        {
-            // copy the character to output
-            for (size_t j = 0; j < ch_len; ++j)
-            {
-                ret.push_back(text[i + j]);
-            }
-            i += ch_len;
-        }
-        else
-        {
-            // UTF8 replacement for unknown character
-            ret.push_back((uint8_t)0xEF);
-            ret.push_back((uint8_t)0xBF);
-            ret.push_back((uint8_t)0xBD);
-            ++i;
-        }
+    // the valid prefix is copied at once
+    size_t i = find_non_utf8_char(text);
+    ret.append(text, 0, i);
+
+    while (i < text.size())
+    {
+        // UTF8 replacement for unknown character
+        ret.push_back((uint8_t)0xEF);
+        ret.push_back((uint8_t)0xBF);
+        ret.push_back((uint8_t)0xBD);
+        ++i;
+
+        const size_t next = i + find_non_utf8_char(std::string_view(text).substr(i));
+        ret.append(text, i, next - i);
+        i = next;
     }
     return ret;
 }
@@ -18,6 +18,9 @@
 #include "diagnosable_impl.h"
 #include "file.h"
 #include "processor.h"
+#include "text_document.h"
+
+#include <string_view>
 
 namespace hlasm_plugin::parser_library::workspaces {
 
@@ -50,11 +53,16 @@ public:
     void did_close() override;
 
     static std::string replace_non_utf8_chars(const std::string& text);
+    // Returns the index of the first byte that does not start a valid utf-8 character, or text.size()
+    static size_t find_non_utf8_char(std::string_view text);
     static std::vector<size_t> create_line_indices(const std::string& text);
 
     // Returns the location in text that corresponds to utf-16 based location
     // The position may point beyond the last character -> returns text.size()
     static size_t index_from_position(const std::string& text, const std::vector<size_t>& line_indices, position pos);
+    // Advances over at most utf16_count utf-16 code units of the text starting at index i and returns the reached
+    // index. The utf16_count is decreased by the number of code units passed.
+    static size_t advance_utf16(std::string_view text, size_t i, size_t& utf16_count);
 
     virtual ~file_impl() = default;
 
@@ -63,9 +71,7 @@ protected:
 
 private:
     file_uri file_name_;
-    std::string text_;
-    // Array of "pointers" to text_ where lines start.
-    std::vector<size_t> lines_ind_;
+    text_document text_;
 
     bool up_to_date_ = false;
     bool editing_ = false;
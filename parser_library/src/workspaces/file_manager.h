@@ -60,6 +60,7 @@ public:
     virtual list_directory_result list_directory_files(const std::string& path) = 0;
 
     virtual bool file_exists(const std::string& file_name) = 0;
+    virtual bool dir_exists(const std::string& dir_name) = 0;
     virtual bool lib_file_exists(const std::string& lib_path, const std::string& file_name) = 0;
 
     virtual void did_open_file(const std::string& document_uri, version_t version, std::string text) = 0;
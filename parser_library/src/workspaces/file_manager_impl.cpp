@@ -197,6 +197,12 @@ bool file_manager_impl::file_exists(const std::string& file_name)
     // TODO use error code??
 }
 
+bool file_manager_impl::dir_exists(const std::string& dir_name)
+{
+    std::error_code ec;
+    return std::filesystem::is_directory(dir_name, ec);
+}
+
 bool file_manager_impl::lib_file_exists(const std::string& lib_path, const std::string& file_name)
 {
     return std::filesystem::exists(utils::path::join(lib_path, file_name));
@@ -58,6 +58,7 @@ public:
     void did_close_file(const std::string& document_uri) override;
 
     bool file_exists(const std::string& file_name) override;
+    bool dir_exists(const std::string& dir_name) override;
     bool lib_file_exists(const std::string& lib_path, const std::string& file_name) override;
 
     virtual ~file_manager_impl() = default;
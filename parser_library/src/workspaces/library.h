@@ -29,6 +29,8 @@ class library : public virtual diagnosable
 public:
     virtual std::shared_ptr<processor> find_file(const std::string& file) = 0;
     virtual void refresh() = 0;
+    // Updates the library after the file or directory at the path was created, changed or deleted.
+    virtual void file_changed(const std::string& path) = 0;
     virtual ~library() = default;
 };
 
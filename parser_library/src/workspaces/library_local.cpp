@@ -86,6 +86,64 @@ void library_local::refresh()
     load_files();
 }
 
+void library_local::file_changed(const std::string& path)
+{
+    // not loaded yet, the current state is read on the first use
+    if (!files_loaded_)
+        return;
+
+    std::filesystem::path lib_dir = utils::path::lexically_normal(lib_path_);
+    if (!lib_dir.has_filename())
+        lib_dir = lib_dir.parent_path();
+    std::filesystem::path changed = utils::path::lexically_normal(path);
+    if (!changed.has_filename())
+        changed = changed.parent_path();
+
+    // the library directory itself or one of its parents was created or deleted
+    if (std::mismatch(changed.begin(), changed.end(), lib_dir.begin(), lib_dir.end()).first == changed.end())
+    {
+        refresh();
+        return;
+    }
+
+    if (!utils::path::equal(changed.parent_path(), lib_dir))
+        return;
+
+    // the outcome of duplicate member names depends on the order of the whole directory listing
+    if (std::any_of(diags().begin(), diags().end(), [](const auto& d) { return d.code != "L0003"; }))
+    {
+        refresh();
+        return;
+    }
+
+    // only regular files are members of the library
+    if (file_manager_.dir_exists(changed.string()))
+        return;
+
+    bool extension_removed = false;
+    const auto filename = utils::path::filename(changed).string();
+    auto name = member_name(filename, extension_removed);
+    if (name.empty())
+        return;
+
+    auto found = files_.find(name);
+    bool same_file = found != files_.end() && utils::path::filename(found->second).string() == filename;
+
+    if (!file_manager_.file_exists(changed.string()))
+    {
+        if (same_file)
+            files_.erase(found);
+    }
+    else if (found == files_.end())
+    {
+        files_.try_emplace(std::move(name), changed.string());
+        if (extension_removed && extensions_from_deprecated_source && diags().empty())
+            add_diagnostic(diagnostic_s::warning_L0003(lib_path_));
+    }
+    else if (!same_file)
+        refresh();
+}
+
 const std::string& library_local::get_lib_path() const { return lib_path_; }
 
 std::shared_ptr<processor> library_local::find_file(const std::string& file_name)
@@ -94,11 +152,32 @@ std::shared_ptr<processor> library_local::find_file(const std::string& file_name
         load_files();
 
     if (auto found = files_.find(file_name); found != files_.end())
-        return file_manager_.add_processor_file(utils::path::join(lib_path_, found->second).string());
+        return file_manager_.add_processor_file(found->second);
     else
         return nullptr;
 }
 
+std::string library_local::member_name(std::string_view filename, bool& extension_removed) const
+{
+    if (extensions_.empty())
+        return context::to_upper_copy(std::string(filename));
+
+    for (const auto& extension : extensions_)
+    {
+        if (filename.size() <= extension.size())
+            continue;
+
+        if (filename.substr(filename.size() - extension.size()) != extension)
+            continue;
+        filename.remove_suffix(extension.size());
+
+        if (extension.size())
+            extension_removed = true;
+        return context::to_upper_copy(std::string(filename));
+    }
+    return {};
+}
+
 void library_local::load_files()
 {
     auto [files_list, rc] = file_manager_.list_directory_files(lib_path_);
@@ -124,32 +203,19 @@ void library_local::load_files()
     bool extension_removed = false;
     for (const auto& file : files_list)
     {
+        auto name = member_name(file.first, extension_removed);
+        if (name.empty())
+            continue;
+
         if (extensions_.empty())
         {
-            files_[context::to_upper_copy(file.first)] = file.second;
+            files_[name] = file.second;
             continue;
         }
 
-        for (const auto& extension : extensions_)
-        {
-            std::string_view filename(file.first);
-
-            if (filename.size() <= extension.size())
-                continue;
-
-            if (filename.substr(filename.size() - extension.size()) != extension)
-                continue;
-            filename.remove_suffix(extension.size());
-
-            const auto [_, inserted] = files_.try_emplace(context::to_upper_copy(std::string(filename)), file.second);
-            // TODO: the stored value is a full path, yet we try to interpret it as a relative one later on
-            if (!inserted)
-                add_diagnostic(diagnostic_s::warning_L0004(lib_path_, context::to_upper_copy(std::string(filename))));
-
-            if (extension.size())
-                extension_removed = true;
-            break;
-        }
+        const auto [_, inserted] = files_.try_emplace(name, file.second);
+        if (!inserted)
+            add_diagnostic(diagnostic_s::warning_L0004(lib_path_, name));
     }
     if (extension_removed && extensions_from_deprecated_source)
         add_diagnostic(diagnostic_s::warning_L0003(lib_path_));
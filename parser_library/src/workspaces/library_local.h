@@ -16,6 +16,7 @@
 #define HLASMPLUGIN_PARSERLIBRARY_LOCAL_LIBRARY_H
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -56,6 +57,8 @@ public:
 
     void refresh() override;
 
+    void file_changed(const std::string& path) override;
+
     bool is_once_only() const override { return false; }
 
 private:
@@ -70,6 +73,8 @@ private:
     bool extensions_from_deprecated_source = false;
 
     void load_files();
+    // Returns the name of the member stored in the file or an empty string, if the file is not a member.
+    std::string member_name(std::string_view filename, bool& extension_removed) const;
 };
 #pragma warning(pop)
 
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "library_prefetch.h"
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <system_error>
+
+namespace hlasm_plugin::parser_library::workspaces {
+
+namespace {
+thread_local bool prefetching = false;
+} // namespace
+
+library_prefetch::library_prefetch(size_t threads)
+    : max_threads_(threads ? threads : std::max(2U, std::thread::hardware_concurrency()) - 1)
+{}
+
+library_prefetch::~library_prefetch()
+{
+    wait_all();
+    {
+        std::lock_guard guard(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    for (auto& t : threads_)
+        t.join();
+}
+
+void library_prefetch::start(std::vector<std::pair<std::string, task>> tasks)
+{
+    if (tasks.empty())
+        return;
+
+    std::vector<queued_task> queued;
+    queued.reserve(tasks.size());
+
+    std::lock_guard guard(mutex_);
+    if (waiting_for_all_)
+        return;
+
+    for (auto& [member, t] : tasks)
+    {
+        auto& q = queued.emplace_back(queued_task { std::move(member), std::move(t), std::promise<void>() });
+        members_.insert_or_assign(q.member, q.done.get_future().share());
+    }
+    enqueue(std::move(queued));
+}
+
+void library_prefetch::start(task t)
+{
+    std::vector<queued_task> queued;
+    queued.emplace_back(queued_task { std::string(), std::move(t), std::promise<void>() });
+
+    std::lock_guard guard(mutex_);
+    if (waiting_for_all_)
+        return;
+
+    enqueue(std::move(queued));
+}
+
+void library_prefetch::enqueue(std::vector<queued_task> tasks, bool urgent)
+{
+    if (urgent)
+        std::move(tasks.rbegin(), tasks.rend(), std::front_inserter(queue_));
+    else
+        std::move(tasks.begin(), tasks.end(), std::back_inserter(queue_));
+
+    // the threads are started as they are needed, up to the limit
+    while (idle_threads_ < queue_.size() && threads_.size() < max_threads_)
+    {
+        try
+        {
+            threads_.emplace_back([this]() { run_tasks(); });
+            ++idle_threads_;
+        }
+        catch (const std::system_error&)
+        {
+            break;
+        }
+    }
+
+    if (threads_.empty())
+    {
+        // no background thread is available, the members are parsed when they are needed
+        for (auto& t : queue_)
+            t.done.set_value();
+        queue_.clear();
+        return;
+    }
+
+    changed_.notify_all();
+}
+
+void library_prefetch::run_tasks()
+{
+    prefetching = true;
+
+    std::unique_lock lock(mutex_);
+    while (true)
+    {
+        changed_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+        if (queue_.empty())
+            return;
+
+        auto t = std::move(queue_.front());
+        queue_.pop_front();
+        --idle_threads_;
+        ++running_tasks_;
+        lock.unlock();
+
+        try
+        {
+            t.run();
+        }
+        catch (...)
+        {
+            // the member is parsed again by the analysis
+        }
+        t.done.set_value();
+
+        lock.lock();
+        ++idle_threads_;
+        --running_tasks_;
+        changed_.notify_all();
+    }
+}
+
+void library_prefetch::wait_for(const std::string& member)
+{
+    std::shared_future<void> task;
+    {
+        std::lock_guard guard(mutex_);
+        auto it = members_.find(member);
+        if (it == members_.end())
+            return;
+
+        // the queued task would make the caller wait for all the tasks in front of it
+        auto queued =
+            std::find_if(queue_.begin(), queue_.end(), [&member](const auto& t) { return t.member == member; });
+        if (queued != queue_.end())
+        {
+            queued->done.set_value();
+            queue_.erase(queued);
+            members_.erase(it);
+            changed_.notify_all();
+            return;
+        }
+        if (prefetching)
+            return;
+        task = it->second;
+    }
+    task.wait();
+}
+
+void library_prefetch::wait_all()
+{
+    std::unique_lock lock(mutex_);
+    ++waiting_for_all_;
+    changed_.wait(lock, [this]() { return queue_.empty() && running_tasks_ == 0; });
+    members_.clear();
+    --waiting_for_all_;
+}
+
+void library_prefetch::run_parallel(std::vector<task> tasks, std::atomic<bool>* cancel)
+{
+    struct batch_state
+    {
+        std::vector<task> tasks;
+        std::atomic<size_t> next_task = 0;
+        std::mutex error_mutex;
+        std::exception_ptr first_error;
+    };
+    auto batch = std::make_shared<batch_state>();
+    batch->tasks = std::move(tasks);
+
+    auto worker = [batch, cancel]() {
+        // the batch tasks may wait for the members being prefetched
+        const bool was_prefetching = std::exchange(prefetching, false);
+        for (size_t i = batch->next_task++; i < batch->tasks.size(); i = batch->next_task++)
+        {
+            if (cancel && cancel->load())
+                break;
+            try
+            {
+                batch->tasks[i]();
+            }
+            catch (...)
+            {
+                std::lock_guard guard(batch->error_mutex);
+                if (!batch->first_error)
+                    batch->first_error = std::current_exception();
+            }
+        }
+        prefetching = was_prefetching;
+    };
+
+    std::vector<std::shared_future<void>> helpers;
+    if (batch->tasks.size() > 1)
+    {
+        std::vector<queued_task> queued;
+        for (size_t i = std::min(max_threads_, batch->tasks.size() - 1); i > 0; --i)
+        {
+            auto& q = queued.emplace_back(queued_task { std::string(), worker, std::promise<void>(), batch.get() });
+            helpers.push_back(q.done.get_future().share());
+        }
+
+        std::lock_guard guard(mutex_);
+        if (!waiting_for_all_)
+            enqueue(std::move(queued), true);
+        else
+            helpers.clear();
+    }
+
+    // the calling thread takes part in the work as well
+    worker();
+
+    {
+        // the helpers that have not started yet have nothing left to do
+        std::lock_guard guard(mutex_);
+        for (auto it = queue_.begin(); it != queue_.end();)
+        {
+            if (it->batch != batch.get())
+            {
+                ++it;
+                continue;
+            }
+            it->done.set_value();
+            it = queue_.erase(it);
+        }
+        changed_.notify_all();
+    }
+    for (const auto& h : helpers)
+        h.wait();
+
+    if (batch->first_error)
+        std::rethrow_exception(batch->first_error);
+}
+
+} // namespace hlasm_plugin::parser_library::workspaces
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#ifndef HLASMPLUGIN_PARSERLIBRARY_LIBRARY_PREFETCH_H
+#define HLASMPLUGIN_PARSERLIBRARY_LIBRARY_PREFETCH_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hlasm_plugin::parser_library::workspaces {
+
+// Runs the parsing of library members in the background, ahead of the analysis that is going to need them.
+// Each task is identified by the name of the member it parses, so that the analysis can wait for the running task
+// instead of parsing the same member again. The tasks run on a fixed number of threads owned by the object,
+// which also help with the batches of tasks the caller waits for.
+class library_prefetch
+{
+public:
+    using task = std::function<void()>;
+
+    // When threads is 0, one thread less than the number of hardware threads is used, at least one.
+    explicit library_prefetch(size_t threads = 0);
+    library_prefetch(const library_prefetch&) = delete;
+    library_prefetch& operator=(const library_prefetch&) = delete;
+    ~library_prefetch();
+
+    // Queues the tasks for the background threads and returns immediately.
+    // The tasks are not expected to throw, exceptions are ignored.
+    // No tasks are accepted while wait_all runs, the members are then parsed when they are needed.
+    void start(std::vector<std::pair<std::string, task>> tasks);
+    // Queues a task that does not parse any particular member.
+    void start(task t);
+
+    // Waits until the task of the member finishes, if it is running.
+    // A task that has not started yet is cancelled, the caller parses the member itself without waiting
+    // for the tasks queued before it.
+    // Does not wait when called from one of the tasks, they may need members that are being prefetched as well.
+    void wait_for(const std::string& member);
+
+    // Waits for all the queued tasks, including the ones the tasks queue before it is called.
+    void wait_all();
+
+    // Runs the independent tasks on the calling thread and the idle threads of the object, ahead of the queued
+    // tasks, and waits for all of them to finish. Once cancel is set, no further tasks are started.
+    // The first exception thrown by a task is rethrown.
+    void run_parallel(std::vector<task> tasks, std::atomic<bool>* cancel = nullptr);
+
+private:
+    struct queued_task
+    {
+        std::string member;
+        task run;
+        std::promise<void> done;
+        // the run_parallel call that queued the task
+        const void* batch = nullptr;
+    };
+
+    const size_t max_threads_;
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<queued_task> queue_;
+    std::map<std::string, std::shared_future<void>> members_;
+    size_t idle_threads_ = 0;
+    size_t running_tasks_ = 0;
+    size_t waiting_for_all_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+
+    // adds the tasks to the queue and starts the threads they need, the mutex must be held
+    void enqueue(std::vector<queued_task> tasks, bool urgent = false);
+    void run_tasks();
+};
+
+} // namespace hlasm_plugin::parser_library::workspaces
+
+#endif // !HLASMPLUGIN_PARSERLIBRARY_LIBRARY_PREFETCH_H
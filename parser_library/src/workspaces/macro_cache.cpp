@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "macro_cache.h"
+
+#include <tuple>
+
+namespace hlasm_plugin::parser_library::workspaces {
+
+macro_cache_key macro_cache_key::create_from_context(
+    const std::string& file_name, context::hlasm_context& hlasm_ctx, const library_data& data)
+{
+    return macro_cache_key {
+        file_name,
+        data.proc_kind,
+        data.library_member,
+        hlasm_ctx.get_asm_options(),
+        hlasm_ctx.get_opsyn_state(),
+        &hlasm_ctx.ids(),
+    };
+}
+
+bool macro_cache_key::operator<(const macro_cache_key& other) const
+{
+    return std::tie(file_name, proc_kind, member, asm_options.sysparm, asm_options.profile, opsyn_state, ids)
+        < std::tie(other.file_name,
+            other.proc_kind,
+            other.member,
+            other.asm_options.sysparm,
+            other.asm_options.profile,
+            other.opsyn_state,
+            other.ids);
+}
+
+bool macro_cache::load_from_cache(
+    const macro_cache_key& key, const analyzing_context& ctx, const std::shared_ptr<file>& member_file)
+{
+    auto it = cache_.find(key);
+    if (it == cache_.end())
+        return false;
+
+    const auto& data = it->second;
+    if (data.member_file.lock() != member_file || data.version != member_file->get_version())
+    {
+        // the file has changed since the member was cached
+        cache_.erase(it);
+        return false;
+    }
+
+    if (const auto* macro_i = std::get_if<lsp::macro_info_ptr>(&data.cached_member))
+    {
+        ctx.hlasm_ctx->add_macro((*macro_i)->macro_definition);
+        ctx.lsp_ctx->add_macro(*macro_i, lsp::text_data_ref_t(member_file->get_text()));
+    }
+    else if (const auto* copy = std::get_if<context::copy_member_ptr>(&data.cached_member))
+    {
+        ctx.hlasm_ctx->add_copy_member(*copy);
+        ctx.lsp_ctx->add_copy(*copy, lsp::text_data_ref_t(member_file->get_text()));
+    }
+
+    return true;
+}
+
+bool macro_cache::contains(const macro_cache_key& key, const std::shared_ptr<file>& member_file) const
+{
+    auto it = cache_.find(key);
+    return it != cache_.end() && it->second.member_file.lock() == member_file
+        && it->second.version == member_file->get_version();
+}
+
+void macro_cache::save(macro_cache_key key, const analyzing_context& ctx, const std::shared_ptr<file>& member_file)
+{
+    std::variant<lsp::macro_info_ptr, context::copy_member_ptr> cached_member;
+
+    if (key.proc_kind == processing::processing_kind::MACRO)
+    {
+        const auto& macros = ctx.hlasm_ctx->macros();
+        auto found = macros.find(key.member);
+        if (found == macros.end() || found->second->definition_location.file != key.file_name
+            || !found->second->defined_in_single_file())
+            return;
+
+        auto macro_i = ctx.lsp_ctx->get_macro_info(found->second);
+        if (!macro_i)
+            return;
+
+        cached_member = std::move(macro_i);
+    }
+    else if (key.proc_kind == processing::processing_kind::COPY)
+    {
+        const auto& copy_members = ctx.hlasm_ctx->copy_members();
+        auto found = copy_members.find(key.member);
+        if (found == copy_members.end() || found->second->definition_location.file != key.file_name)
+            return;
+
+        cached_member = found->second;
+    }
+    else
+        return;
+
+    cache_.insert_or_assign(std::move(key),
+        macro_cache_data {
+            member_file,
+            member_file->get_version(),
+            ctx.hlasm_ctx->ids_ptr(),
+            std::move(cached_member),
+        });
+}
+
+void macro_cache::erase(const std::string& file_name)
+{
+    for (auto it = cache_.begin(); it != cache_.end();)
+    {
+        if (it->first.file_name == file_name)
+            it = cache_.erase(it);
+        else
+            ++it;
+    }
+}
+
+void macro_cache::clear() { cache_.clear(); }
+
+} // namespace hlasm_plugin::parser_library::workspaces
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#ifndef HLASMPLUGIN_PARSERLIBRARY_MACRO_CACHE_H
+#define HLASMPLUGIN_PARSERLIBRARY_MACRO_CACHE_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "analyzing_context.h"
+#include "file.h"
+#include "parse_lib_provider.h"
+
+namespace hlasm_plugin::parser_library::workspaces {
+
+// Identifies the circumstances under which a library member was parsed.
+// A cached member may be reused only by a context with the same key.
+struct macro_cache_key
+{
+    std::string file_name;
+    processing::processing_kind proc_kind;
+    context::id_index member;
+    asm_option asm_options;
+    std::vector<std::pair<context::id_index, context::id_index>> opsyn_state;
+    const context::id_storage* ids;
+
+    static macro_cache_key create_from_context(
+        const std::string& file_name, context::hlasm_context& hlasm_ctx, const library_data& data);
+
+    bool operator<(const macro_cache_key& other) const;
+};
+
+struct macro_cache_data
+{
+    // file that the member was parsed from and its version at that time
+    std::weak_ptr<file> member_file;
+    version_t version;
+    // keeps the identifiers referenced by the cached definition alive
+    std::shared_ptr<context::id_storage> ids;
+
+    std::variant<lsp::macro_info_ptr, context::copy_member_ptr> cached_member;
+};
+
+// Stores parsed macro and copy member definitions, so they can be shared by all open codes
+// that use the same library member instead of parsing it again.
+// The cached definitions are treated as read-only.
+// Macros containing COPY statements in their definitions depend on other files,
+// their LSP information spans those files as well, so they are not cached.
+class macro_cache final
+{
+    std::map<macro_cache_key, macro_cache_data> cache_;
+
+public:
+    // Registers the cached member into the context, if there is one that is still up to date.
+    // Returns true, if the member was loaded.
+    bool load_from_cache(
+        const macro_cache_key& key, const analyzing_context& ctx, const std::shared_ptr<file>& member_file);
+
+    // Returns true, if there is an up to date member for the key.
+    bool contains(const macro_cache_key& key, const std::shared_ptr<file>& member_file) const;
+
+    // Saves the member that has just been parsed into the context.
+    void save(macro_cache_key key, const analyzing_context& ctx, const std::shared_ptr<file>& member_file);
+
+    // Removes all members parsed from the file.
+    void erase(const std::string& file_name);
+
+    void clear();
+};
+
+} // namespace hlasm_plugin::parser_library::workspaces
+
+#endif
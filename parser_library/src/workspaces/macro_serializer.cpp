@@ -0,0 +1,1136 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "macro_serializer.h"
+
+#include <cstdint>
+
+#include "expressions/conditional_assembly/ca_operator_binary.h"
+#include "expressions/conditional_assembly/ca_operator_unary.h"
+#include "expressions/conditional_assembly/terms/ca_constant.h"
+#include "expressions/conditional_assembly/terms/ca_expr_list.h"
+#include "expressions/conditional_assembly/terms/ca_function.h"
+#include "expressions/conditional_assembly/terms/ca_string.h"
+#include "expressions/conditional_assembly/terms/ca_symbol.h"
+#include "expressions/conditional_assembly/terms/ca_symbol_attribute.h"
+#include "expressions/conditional_assembly/terms/ca_var_sym.h"
+#include "processing/statement.h"
+#include "semantics/concatenation_term.h"
+#include "semantics/operand_impls.h"
+#include "semantics/statement.h"
+
+namespace hlasm_plugin::parser_library::workspaces {
+
+namespace {
+
+// thrown when the macro contains a construct that the format does not support
+struct unsupported_construct
+{};
+// thrown when the serialized data are malformed
+struct invalid_data
+{};
+
+enum class id_tag : uint8_t
+{
+    null,
+    empty,
+    well_known_empty,
+    value,
+};
+
+enum class expr_tag : uint8_t
+{
+    null,
+    constant,
+    list,
+    function,
+    string,
+    symbol,
+    symbol_attribute,
+    var_sym,
+    plus,
+    minus,
+    par,
+    function_unary,
+    add,
+    sub,
+    mul,
+    div,
+    conc,
+    function_binary,
+};
+
+enum class statement_tag : uint8_t
+{
+    deferred,
+    resolved,
+};
+
+enum class macro_data_tag : uint8_t
+{
+    dummy,
+    single,
+    composite,
+};
+
+enum class opcode_tag : uint8_t
+{
+    null,
+    self,
+    other,
+};
+
+class writer
+{
+    std::string data_;
+
+public:
+    std::string take() { return std::move(data_); }
+
+    void number(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            data_.push_back((char)((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        data_.push_back((char)value);
+    }
+
+    void signed_number(int64_t value) { number(((uint64_t)value << 1) ^ (uint64_t)(value >> 63)); }
+
+    template<typename E>
+    void enumeration(E value)
+    {
+        number((uint64_t)value);
+    }
+
+    void boolean(bool value) { number(value ? 1 : 0); }
+
+    void string(std::string_view value)
+    {
+        number(value.size());
+        data_.append(value);
+    }
+
+    void id(context::id_index value)
+    {
+        if (!value)
+            enumeration(id_tag::null);
+        else if (value == context::id_storage::empty_id)
+            enumeration(id_tag::empty);
+        else if (value->empty())
+            enumeration(id_tag::well_known_empty);
+        else
+        {
+            enumeration(id_tag::value);
+            string(*value);
+        }
+    }
+
+    void pos(const position& value)
+    {
+        number(value.line);
+        number(value.column);
+    }
+
+    void rng(const range& value)
+    {
+        pos(value.start);
+        pos(value.end);
+    }
+
+    void loc(const location& value)
+    {
+        pos(value.pos);
+        string(value.file);
+    }
+};
+
+class reader
+{
+    std::string_view data_;
+    context::id_storage& ids_;
+
+public:
+    reader(std::string_view data, context::id_storage& ids)
+        : data_(data)
+        , ids_(ids)
+    {}
+
+    bool finished() const { return data_.empty(); }
+
+    uint64_t number()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (data_.empty())
+                throw invalid_data();
+            auto byte = (unsigned char)data_.front();
+            data_.remove_prefix(1);
+            value |= (uint64_t)(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+        throw invalid_data();
+    }
+
+    int64_t signed_number()
+    {
+        auto value = number();
+        return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+    }
+
+    // the last enumerator is the largest valid value
+    template<typename E>
+    E enumeration(E last)
+    {
+        auto value = number();
+        if (value > (uint64_t)last)
+            throw invalid_data();
+        return (E)value;
+    }
+
+    bool boolean() { return enumeration<uint8_t>(1) != 0; }
+
+    size_t size()
+    {
+        auto value = number();
+        // every serialized element takes at least one byte
+        if (value > data_.size())
+            throw invalid_data();
+        return (size_t)value;
+    }
+
+    std::string string()
+    {
+        auto length = size();
+        std::string value(data_.substr(0, length));
+        data_.remove_prefix(length);
+        return value;
+    }
+
+    context::id_index id()
+    {
+        switch (enumeration(id_tag::value))
+        {
+            case id_tag::null:
+                return nullptr;
+            case id_tag::empty:
+                return context::id_storage::empty_id;
+            case id_tag::well_known_empty:
+                return ids_.well_known.empty;
+            default:
+                return ids_.add(string(), true);
+        }
+    }
+
+    position pos()
+    {
+        auto line = number();
+        auto column = number();
+        return position(line, column);
+    }
+
+    range rng()
+    {
+        auto start = pos();
+        auto end = pos();
+        return range(start, end);
+    }
+
+    location loc()
+    {
+        auto p = pos();
+        return location(p, string());
+    }
+};
+
+//
+// serialization
+//
+
+void write_expr(writer& w, const expressions::ca_expression* expr);
+void write_chain(writer& w, const semantics::concat_chain& chain);
+
+void write_exprs(writer& w, const std::vector<expressions::ca_expr_ptr>& exprs)
+{
+    w.number(exprs.size());
+    for (const auto& expr : exprs)
+        write_expr(w, expr.get());
+}
+
+void write_var(writer& w, const semantics::variable_symbol& var)
+{
+    w.boolean(var.created);
+    if (var.created)
+        write_chain(w, var.access_created()->created_name);
+    else
+        w.id(var.access_basic()->name);
+    write_exprs(w, var.subscript);
+    w.rng(var.symbol_range);
+}
+
+void write_chain(writer& w, const semantics::concat_chain& chain)
+{
+    w.number(chain.size());
+    for (const auto& point : chain)
+    {
+        if (!point)
+            throw unsupported_construct();
+
+        w.enumeration(point->type);
+        switch (point->type)
+        {
+            case semantics::concat_type::STR: {
+                const auto& str = *static_cast<const semantics::char_str_conc*>(point.get());
+                w.string(str.value);
+                w.rng(str.conc_range);
+                break;
+            }
+            case semantics::concat_type::VAR:
+                write_var(w, *static_cast<const semantics::var_sym_conc*>(point.get())->symbol);
+                break;
+            case semantics::concat_type::SUB: {
+                const auto& list = static_cast<const semantics::sublist_conc*>(point.get())->list;
+                w.number(list.size());
+                for (const auto& sub_chain : list)
+                    write_chain(w, sub_chain);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+template<typename T>
+const T* as(const expressions::ca_expression* expr)
+{
+    return dynamic_cast<const T*>(expr);
+}
+
+void write_expr(writer& w, const expressions::ca_expression* expr)
+{
+    using namespace expressions;
+
+    if (!expr)
+    {
+        w.enumeration(expr_tag::null);
+        return;
+    }
+
+    auto header = [&w, expr](expr_tag tag) {
+        w.enumeration(tag);
+        w.enumeration(expr->expr_kind);
+        w.rng(expr->expr_range);
+        const auto& constant = expr->constant_value();
+        w.boolean(constant.has_value());
+        if (constant)
+            w.signed_number(*constant);
+    };
+
+    if (auto e = as<ca_constant>(expr))
+    {
+        header(expr_tag::constant);
+        w.signed_number(e->value);
+    }
+    else if (auto e = as<ca_expr_list>(expr))
+    {
+        header(expr_tag::list);
+        write_exprs(w, e->expr_list);
+    }
+    else if (auto e = as<ca_function>(expr))
+    {
+        header(expr_tag::function);
+        w.id(e->function_name);
+        w.enumeration(e->function);
+        write_exprs(w, e->parameters);
+        write_expr(w, e->duplication_factor.get());
+    }
+    else if (auto e = as<ca_string>(expr))
+    {
+        header(expr_tag::string);
+        write_chain(w, e->value);
+        write_expr(w, e->duplication_factor.get());
+        write_expr(w, e->substring.start.get());
+        write_expr(w, e->substring.count.get());
+        w.rng(e->substring.substring_range);
+    }
+    else if (auto e = as<ca_symbol>(expr))
+    {
+        header(expr_tag::symbol);
+        w.id(e->symbol);
+    }
+    else if (auto e = as<ca_symbol_attribute>(expr))
+    {
+        header(expr_tag::symbol_attribute);
+        w.enumeration(e->attribute);
+        w.rng(e->symbol_range);
+        if (const auto* var = std::get_if<semantics::vs_ptr>(&e->symbol))
+        {
+            w.boolean(true);
+            write_var(w, **var);
+        }
+        else
+        {
+            w.boolean(false);
+            w.id(std::get<context::id_index>(e->symbol));
+        }
+    }
+    else if (auto e = as<ca_var_sym>(expr))
+    {
+        header(expr_tag::var_sym);
+        write_var(w, *e->symbol);
+    }
+    else if (auto e = as<ca_unary_operator>(expr))
+    {
+        if (as<ca_plus_operator>(expr))
+            header(expr_tag::plus);
+        else if (as<ca_minus_operator>(expr))
+            header(expr_tag::minus);
+        else if (as<ca_par_operator>(expr))
+            header(expr_tag::par);
+        else if (auto f = as<ca_function_unary_operator>(expr))
+        {
+            header(expr_tag::function_unary);
+            w.enumeration(f->function);
+        }
+        else
+            throw unsupported_construct();
+        write_expr(w, e->expr.get());
+    }
+    else if (auto e = as<ca_binary_operator>(expr))
+    {
+        if (as<ca_basic_binary_operator<ca_add>>(expr))
+            header(expr_tag::add);
+        else if (as<ca_basic_binary_operator<ca_sub>>(expr))
+            header(expr_tag::sub);
+        else if (as<ca_basic_binary_operator<ca_mul>>(expr))
+            header(expr_tag::mul);
+        else if (as<ca_basic_binary_operator<ca_div>>(expr))
+            header(expr_tag::div);
+        else if (as<ca_basic_binary_operator<ca_conc>>(expr))
+            header(expr_tag::conc);
+        else if (auto f = as<ca_function_binary_operator>(expr))
+        {
+            header(expr_tag::function_binary);
+            w.enumeration(f->function);
+        }
+        else
+            throw unsupported_construct();
+        write_expr(w, e->left_expr.get());
+        write_expr(w, e->right_expr.get());
+    }
+    else
+        throw unsupported_construct();
+}
+
+void write_label(writer& w, const semantics::label_si& label)
+{
+    w.enumeration(label.type);
+    w.rng(label.field_range);
+    switch (label.type)
+    {
+        case semantics::label_si_type::ORD:
+        case semantics::label_si_type::MAC:
+            w.string(std::get<std::string>(label.value));
+            break;
+        case semantics::label_si_type::SEQ: {
+            const auto& seq = std::get<semantics::seq_sym>(label.value);
+            w.id(seq.name);
+            w.rng(seq.symbol_range);
+            break;
+        }
+        case semantics::label_si_type::VAR:
+            write_var(w, *std::get<semantics::vs_ptr>(label.value));
+            break;
+        case semantics::label_si_type::CONC:
+            write_chain(w, std::get<semantics::concat_chain>(label.value));
+            break;
+        default:
+            break;
+    }
+}
+
+void write_instruction(writer& w, const semantics::instruction_si& instruction)
+{
+    w.enumeration(instruction.type);
+    w.rng(instruction.field_range);
+    if (instruction.type == semantics::instruction_si_type::ORD)
+        w.id(std::get<context::id_index>(instruction.value));
+    else if (instruction.type == semantics::instruction_si_type::CONC)
+        write_chain(w, std::get<semantics::concat_chain>(instruction.value));
+}
+
+void write_operand(writer& w, const semantics::operand& op)
+{
+    w.enumeration(op.type);
+    w.rng(op.operand_range);
+
+    if (op.type == semantics::operand_type::EMPTY)
+        return;
+    if (op.type != semantics::operand_type::CA)
+        throw unsupported_construct();
+
+    const auto& ca_op = static_cast<const semantics::ca_operand&>(op);
+    w.enumeration(ca_op.kind);
+    switch (ca_op.kind)
+    {
+        case semantics::ca_kind::VAR:
+            write_var(w, *ca_op.access_var()->variable_symbol);
+            break;
+        case semantics::ca_kind::EXPR:
+            write_expr(w, ca_op.access_expr()->expression.get());
+            break;
+        case semantics::ca_kind::SEQ:
+            w.id(ca_op.access_seq()->sequence_symbol.name);
+            w.rng(ca_op.access_seq()->sequence_symbol.symbol_range);
+            break;
+        case semantics::ca_kind::BRANCH:
+            w.id(ca_op.access_branch()->sequence_symbol.name);
+            w.rng(ca_op.access_branch()->sequence_symbol.symbol_range);
+            write_expr(w, ca_op.access_branch()->expression.get());
+            break;
+    }
+}
+
+void write_statement(writer& w, const context::hlasm_statement& stmt)
+{
+    if (stmt.kind == context::statement_kind::DEFERRED)
+    {
+        auto deferred = dynamic_cast<const semantics::statement_si_deferred*>(&stmt);
+        if (!deferred)
+            throw unsupported_construct();
+
+        w.enumeration(statement_tag::deferred);
+        w.rng(deferred->stmt_range);
+        write_label(w, deferred->label);
+        write_instruction(w, deferred->instruction);
+        w.rng(deferred->deferred_operands.field_range);
+        w.string(deferred->deferred_operands.value);
+        w.number(deferred->deferred_operands.vars.size());
+        for (const auto& var : deferred->deferred_operands.vars)
+            write_var(w, *var);
+        return;
+    }
+
+    auto resolved = dynamic_cast<const processing::resolved_statement_impl*>(&stmt);
+    if (!resolved)
+        throw unsupported_construct();
+    auto base = dynamic_cast<const semantics::statement_si*>(resolved->base_stmt.get());
+    if (!base)
+        throw unsupported_construct();
+
+    w.enumeration(statement_tag::resolved);
+    w.enumeration(resolved->status.first.kind);
+    w.enumeration(resolved->status.first.form);
+    w.enumeration(resolved->status.first.occurence);
+    w.id(resolved->status.second.value);
+    w.enumeration(resolved->status.second.type);
+
+    w.rng(base->stmt_range);
+    write_label(w, base->label);
+    write_instruction(w, base->instruction);
+    w.rng(base->operands.field_range);
+    w.number(base->operands.value.size());
+    for (const auto& op : base->operands.value)
+    {
+        if (!op)
+            throw unsupported_construct();
+        write_operand(w, *op);
+    }
+    w.rng(base->remarks.field_range);
+    w.number(base->remarks.value.size());
+    for (const auto& r : base->remarks.value)
+        w.rng(r);
+}
+
+void write_macro_data(writer& w, const context::macro_param_data_component& data)
+{
+    if (dynamic_cast<const context::macro_param_data_dummy*>(&data))
+        w.enumeration(macro_data_tag::dummy);
+    else if (dynamic_cast<const context::macro_param_data_single*>(&data))
+    {
+        w.enumeration(macro_data_tag::single);
+        w.string(data.get_value());
+    }
+    else if (dynamic_cast<const context::macro_param_data_composite*>(&data))
+    {
+        w.enumeration(macro_data_tag::composite);
+        w.number(data.size());
+        for (size_t i = 0; i < data.size(); ++i)
+            write_macro_data(w, *data.get_ith(i));
+    }
+    else
+        throw unsupported_construct();
+}
+
+void write_definition(writer& w, const context::macro_definition& def)
+{
+    w.id(def.id);
+    w.id(def.get_label_param_name());
+
+    const auto& positional = def.get_positional_params();
+    // the first positional parameter is the label parameter
+    w.number(positional.size() - 1);
+    for (size_t i = 1; i < positional.size(); ++i)
+        w.id(positional[i] ? positional[i]->id : nullptr);
+
+    const auto& keyword = def.get_keyword_params();
+    w.number(keyword.size());
+    for (const auto& param : keyword)
+    {
+        w.id(param->id);
+        write_macro_data(w, *param->default_data);
+    }
+
+    w.number(def.cached_definition.size());
+    for (const auto& cache : def.cached_definition)
+        write_statement(w, *cache.get_base());
+
+    w.number(def.copy_nests.size());
+    for (const auto& nest : def.copy_nests)
+    {
+        w.number(nest.size());
+        for (const auto& l : nest)
+            w.loc(l);
+    }
+
+    w.number(def.labels.size());
+    for (const auto& [name, symbol] : def.labels)
+    {
+        const auto* macro_symbol = symbol->access_macro_symbol();
+        if (!macro_symbol)
+            throw unsupported_construct();
+        w.id(macro_symbol->name);
+        w.loc(macro_symbol->symbol_location);
+        w.number(macro_symbol->statement_offset);
+    }
+
+    w.loc(def.definition_location);
+}
+
+void write_lsp_info(writer& w, const lsp::macro_info& macro_i)
+{
+    w.number(macro_i.var_definitions.size());
+    for (const auto& var : macro_i.var_definitions)
+    {
+        w.id(var.name);
+        w.boolean(var.macro_param);
+        w.enumeration(var.type);
+        w.boolean(var.global);
+        w.number(var.def_location);
+        w.string(var.file);
+        w.pos(var.def_position);
+    }
+
+    w.number(macro_i.file_scopes_.size());
+    for (const auto& [file, slices] : macro_i.file_scopes_)
+    {
+        w.string(file);
+        w.number(slices.size());
+        for (const auto& slice : slices)
+        {
+            w.number(slice.begin_statement);
+            w.number(slice.end_statement);
+            w.boolean(slice.inner_macro);
+        }
+    }
+
+    w.number(macro_i.file_occurences_.size());
+    for (const auto& [file, occurences] : macro_i.file_occurences_)
+    {
+        w.string(file);
+        w.number(occurences.size());
+        for (const auto& occ : occurences)
+        {
+            w.enumeration(occ.kind);
+            w.id(occ.name);
+            w.rng(occ.occurence_range);
+            if (!occ.opcode)
+                w.enumeration(opcode_tag::null);
+            else if (occ.opcode == macro_i.macro_definition)
+                w.enumeration(opcode_tag::self);
+            else
+                w.enumeration(opcode_tag::other);
+        }
+    }
+}
+
+//
+// deserialization
+//
+
+expressions::ca_expr_ptr read_expr(reader& r);
+semantics::concat_chain read_chain(reader& r);
+
+std::vector<expressions::ca_expr_ptr> read_exprs(reader& r)
+{
+    std::vector<expressions::ca_expr_ptr> exprs(r.size());
+    for (auto& expr : exprs)
+        expr = read_expr(r);
+    return exprs;
+}
+
+semantics::vs_ptr read_var(reader& r)
+{
+    if (r.boolean())
+    {
+        auto name = read_chain(r);
+        auto subscript = read_exprs(r);
+        return std::make_unique<semantics::created_variable_symbol>(std::move(name), std::move(subscript), r.rng());
+    }
+    else
+    {
+        auto name = r.id();
+        auto subscript = read_exprs(r);
+        return std::make_unique<semantics::basic_variable_symbol>(name, std::move(subscript), r.rng());
+    }
+}
+
+semantics::concat_chain read_chain(reader& r)
+{
+    semantics::concat_chain chain(r.size());
+    for (auto& point : chain)
+    {
+        switch (r.enumeration(semantics::concat_type::EQU))
+        {
+            case semantics::concat_type::STR: {
+                auto value = r.string();
+                point = std::make_unique<semantics::char_str_conc>(std::move(value), r.rng());
+                break;
+            }
+            case semantics::concat_type::VAR:
+                point = std::make_unique<semantics::var_sym_conc>(read_var(r));
+                break;
+            case semantics::concat_type::DOT:
+                point = std::make_unique<semantics::dot_conc>();
+                break;
+            case semantics::concat_type::EQU:
+                point = std::make_unique<semantics::equals_conc>();
+                break;
+            case semantics::concat_type::SUB: {
+                std::vector<semantics::concat_chain> list(r.size());
+                for (auto& sub_chain : list)
+                    sub_chain = read_chain(r);
+                point = std::make_unique<semantics::sublist_conc>(std::move(list));
+                break;
+            }
+        }
+    }
+    return chain;
+}
+
+template<typename OP>
+expressions::ca_expr_ptr read_basic_binary(reader& r, const range& expr_range)
+{
+    auto left = read_expr(r);
+    auto right = read_expr(r);
+    return std::make_unique<expressions::ca_basic_binary_operator<OP>>(std::move(left), std::move(right), expr_range);
+}
+
+expressions::ca_expr_ptr read_expr(reader& r)
+{
+    using namespace expressions;
+
+    auto tag = r.enumeration(expr_tag::function_binary);
+    if (tag == expr_tag::null)
+        return nullptr;
+
+    auto kind = r.enumeration(context::SET_t_enum::UNDEF_TYPE);
+    auto expr_range = r.rng();
+    std::optional<context::A_t> constant;
+    if (r.boolean())
+        constant = (context::A_t)r.signed_number();
+
+    ca_expr_ptr expr;
+    switch (tag)
+    {
+        case expr_tag::constant:
+            expr = std::make_unique<ca_constant>((context::A_t)r.signed_number(), expr_range);
+            break;
+        case expr_tag::list:
+            expr = std::make_unique<ca_expr_list>(read_exprs(r), expr_range);
+            break;
+        case expr_tag::function: {
+            auto name = r.id();
+            auto function = r.enumeration(ca_expr_funcs::UNKNOWN);
+            auto parameters = read_exprs(r);
+            auto duplication_factor = read_expr(r);
+            expr = std::make_unique<ca_function>(
+                name, function, std::move(parameters), std::move(duplication_factor), expr_range);
+            break;
+        }
+        case expr_tag::string: {
+            auto value = read_chain(r);
+            auto duplication_factor = read_expr(r);
+            ca_string::substring_t substring;
+            substring.start = read_expr(r);
+            substring.count = read_expr(r);
+            substring.substring_range = r.rng();
+            expr = std::make_unique<ca_string>(
+                std::move(value), std::move(duplication_factor), std::move(substring), expr_range);
+            break;
+        }
+        case expr_tag::symbol:
+            expr = std::make_unique<ca_symbol>(r.id(), expr_range);
+            break;
+        case expr_tag::symbol_attribute: {
+            auto attribute = r.enumeration(context::data_attr_kind::UNKNOWN);
+            auto symbol_range = r.rng();
+            if (r.boolean())
+                expr = std::make_unique<ca_symbol_attribute>(read_var(r), attribute, expr_range, symbol_range);
+            else
+                expr = std::make_unique<ca_symbol_attribute>(r.id(), attribute, expr_range, symbol_range);
+            break;
+        }
+        case expr_tag::var_sym:
+            expr = std::make_unique<ca_var_sym>(read_var(r), expr_range);
+            break;
+        case expr_tag::plus:
+            expr = std::make_unique<ca_plus_operator>(read_expr(r), expr_range);
+            break;
+        case expr_tag::minus:
+            expr = std::make_unique<ca_minus_operator>(read_expr(r), expr_range);
+            break;
+        case expr_tag::par:
+            expr = std::make_unique<ca_par_operator>(read_expr(r), expr_range);
+            break;
+        case expr_tag::function_unary: {
+            auto function = r.enumeration(ca_expr_ops::UNKNOWN);
+            expr = std::make_unique<ca_function_unary_operator>(read_expr(r), function, kind, expr_range);
+            break;
+        }
+        case expr_tag::function_binary: {
+            auto function = r.enumeration(ca_expr_ops::UNKNOWN);
+            auto left = read_expr(r);
+            auto right = read_expr(r);
+            expr = std::make_unique<ca_function_binary_operator>(
+                std::move(left), std::move(right), function, kind, expr_range);
+            break;
+        }
+        case expr_tag::add:
+            expr = read_basic_binary<ca_add>(r, expr_range);
+            break;
+        case expr_tag::sub:
+            expr = read_basic_binary<ca_sub>(r, expr_range);
+            break;
+        case expr_tag::mul:
+            expr = read_basic_binary<ca_mul>(r, expr_range);
+            break;
+        case expr_tag::div:
+            expr = read_basic_binary<ca_div>(r, expr_range);
+            break;
+        case expr_tag::conc:
+            expr = read_basic_binary<ca_conc>(r, expr_range);
+            break;
+        default:
+            throw invalid_data();
+    }
+
+    // the kind and the folded value were determined when the expression tree was resolved after parsing
+    expr->expr_kind = kind;
+    expr->set_constant_value(constant);
+    return expr;
+}
+
+semantics::label_si read_label(reader& r)
+{
+    auto type = r.enumeration(semantics::label_si_type::EMPTY);
+    auto field_range = r.rng();
+    switch (type)
+    {
+        case semantics::label_si_type::ORD:
+            return semantics::label_si(field_range, r.string());
+        case semantics::label_si_type::MAC:
+            return semantics::label_si(field_range, r.string(), semantics::label_si::mac_flag());
+        case semantics::label_si_type::SEQ: {
+            auto name = r.id();
+            return semantics::label_si(field_range, semantics::seq_sym { name, r.rng() });
+        }
+        case semantics::label_si_type::VAR:
+            return semantics::label_si(field_range, read_var(r));
+        case semantics::label_si_type::CONC:
+            return semantics::label_si(field_range, read_chain(r));
+        default:
+            return semantics::label_si(field_range);
+    }
+}
+
+semantics::instruction_si read_instruction(reader& r)
+{
+    auto type = r.enumeration(semantics::instruction_si_type::EMPTY);
+    auto field_range = r.rng();
+    switch (type)
+    {
+        case semantics::instruction_si_type::ORD:
+            return semantics::instruction_si(field_range, r.id());
+        case semantics::instruction_si_type::CONC:
+            return semantics::instruction_si(field_range, read_chain(r));
+        default:
+            return semantics::instruction_si(field_range);
+    }
+}
+
+semantics::operand_ptr read_operand(reader& r)
+{
+    auto type = r.enumeration(semantics::operand_type::EMPTY);
+    auto operand_range = r.rng();
+
+    if (type == semantics::operand_type::EMPTY)
+        return std::make_unique<semantics::empty_operand>(operand_range);
+    if (type != semantics::operand_type::CA)
+        throw invalid_data();
+
+    switch (r.enumeration(semantics::ca_kind::BRANCH))
+    {
+        case semantics::ca_kind::VAR:
+            return std::make_unique<semantics::var_ca_operand>(read_var(r), operand_range);
+        case semantics::ca_kind::EXPR:
+            return std::make_unique<semantics::expr_ca_operand>(read_expr(r), operand_range);
+        case semantics::ca_kind::SEQ: {
+            auto name = r.id();
+            return std::make_unique<semantics::seq_ca_operand>(semantics::seq_sym { name, r.rng() }, operand_range);
+        }
+        default: {
+            auto name = r.id();
+            semantics::seq_sym seq { name, r.rng() };
+            return std::make_unique<semantics::branch_ca_operand>(std::move(seq), read_expr(r), operand_range);
+        }
+    }
+}
+
+context::shared_stmt_ptr read_statement(reader& r)
+{
+    if (r.enumeration(statement_tag::resolved) == statement_tag::deferred)
+    {
+        auto stmt_range = r.rng();
+        auto label = read_label(r);
+        auto instruction = read_instruction(r);
+        auto field_range = r.rng();
+        auto value = r.string();
+        std::vector<semantics::vs_ptr> vars(r.size());
+        for (auto& var : vars)
+            var = read_var(r);
+
+        return std::make_shared<semantics::statement_si_deferred>(stmt_range,
+            std::move(label),
+            std::move(instruction),
+            semantics::deferred_operands_si(field_range, std::move(value), std::move(vars)));
+    }
+
+    auto kind = r.enumeration(processing::processing_kind::COPY);
+    auto form = r.enumeration(processing::processing_form::UNKNOWN);
+    auto occurence = r.enumeration(processing::operand_occurence::ABSENT);
+    auto opcode_value = r.id();
+    auto opcode_type = r.enumeration(context::instruction_type::UNDEF);
+    processing::processing_status status(
+        processing::processing_format(kind, form, occurence), processing::op_code(opcode_value, opcode_type));
+
+    auto stmt_range = r.rng();
+    auto label = read_label(r);
+    auto instruction = read_instruction(r);
+    auto operands_range = r.rng();
+    semantics::operand_list operands(r.size());
+    for (auto& op : operands)
+        op = read_operand(r);
+    auto remarks_range = r.rng();
+    std::vector<range> remarks(r.size());
+    for (auto& rem : remarks)
+        rem = r.rng();
+
+    auto base = std::make_shared<semantics::statement_si>(stmt_range,
+        std::move(label),
+        std::move(instruction),
+        semantics::operands_si(operands_range, std::move(operands)),
+        semantics::remarks_si(remarks_range, std::move(remarks)));
+    return std::make_shared<processing::resolved_statement_impl>(std::move(base), std::move(status));
+}
+
+context::macro_data_ptr read_macro_data(reader& r)
+{
+    switch (r.enumeration(macro_data_tag::composite))
+    {
+        case macro_data_tag::dummy:
+            return std::make_unique<context::macro_param_data_dummy>();
+        case macro_data_tag::single:
+            return std::make_unique<context::macro_param_data_single>(r.string());
+        default: {
+            std::vector<context::macro_data_ptr> data(r.size());
+            for (auto& d : data)
+                d = read_macro_data(r);
+            return std::make_unique<context::macro_param_data_composite>(std::move(data));
+        }
+    }
+}
+
+context::macro_def_ptr read_definition(reader& r)
+{
+    auto id = r.id();
+    auto label_param_name = r.id();
+
+    std::vector<context::macro_arg> params;
+    for (size_t i = r.size(); i > 0; --i)
+        params.emplace_back(nullptr, r.id());
+    for (size_t i = r.size(); i > 0; --i)
+    {
+        auto name = r.id();
+        if (!name)
+            throw invalid_data();
+        params.emplace_back(read_macro_data(r), name);
+    }
+
+    context::statement_block definition(r.size());
+    for (auto& stmt : definition)
+        stmt = read_statement(r);
+
+    context::copy_nest_storage copy_nests(r.size());
+    for (auto& nest : copy_nests)
+    {
+        nest.resize(r.size());
+        for (auto& l : nest)
+            l = r.loc();
+    }
+
+    context::label_storage labels;
+    for (size_t i = r.size(); i > 0; --i)
+    {
+        auto name = r.id();
+        auto symbol_location = r.loc();
+        auto offset = r.number();
+        labels.try_emplace(
+            name, std::make_unique<context::macro_sequence_symbol>(name, std::move(symbol_location), (size_t)offset));
+    }
+
+    auto definition_location = r.loc();
+
+    return std::make_shared<context::macro_definition>(id,
+        label_param_name,
+        std::move(params),
+        std::move(definition),
+        std::move(copy_nests),
+        std::move(labels),
+        std::move(definition_location));
+}
+
+} // namespace
+
+std::optional<std::string> serialize_macro(const lsp::macro_info& macro_i)
+{
+    writer w;
+    try
+    {
+        w.number(macro_serialization_version);
+        w.boolean(macro_i.external);
+        w.loc(macro_i.definition_location);
+        write_definition(w, *macro_i.macro_definition);
+        write_lsp_info(w, macro_i);
+    }
+    catch (const unsupported_construct&)
+    {
+        return std::nullopt;
+    }
+    return w.take();
+}
+
+lsp::macro_info_ptr deserialize_macro(std::string_view data, context::hlasm_context& hlasm_ctx)
+{
+    reader r(data, hlasm_ctx.ids());
+    try
+    {
+        if (r.number() != macro_serialization_version)
+            return nullptr;
+
+        auto external = r.boolean();
+        auto definition_location = r.loc();
+        auto macro_def = read_definition(r);
+
+        lsp::vardef_storage var_definitions;
+        for (size_t i = r.size(); i > 0; --i)
+        {
+            auto name = r.id();
+            auto macro_param = r.boolean();
+            auto type = r.enumeration(context::SET_t_enum::UNDEF_TYPE);
+            auto global = r.boolean();
+            auto def_location = (size_t)r.number();
+            auto file = r.string();
+            auto def_position = r.pos();
+
+            auto& var = var_definitions.emplace_back(name, def_location, def_position);
+            var.macro_param = macro_param;
+            var.type = type;
+            var.global = global;
+            var.file = std::move(file);
+        }
+
+        lsp::file_scopes_t file_scopes;
+        for (size_t i = r.size(); i > 0; --i)
+        {
+            auto& slices = file_scopes[r.string()];
+            for (size_t j = r.size(); j > 0; --j)
+            {
+                auto begin = (size_t)r.number();
+                auto end = (size_t)r.number();
+                slices.emplace_back(begin, end, r.boolean());
+            }
+        }
+
+        lsp::file_occurences_t file_occurences;
+        const auto& macros = hlasm_ctx.macros();
+        for (size_t i = r.size(); i > 0; --i)
+        {
+            auto& occurences = file_occurences[r.string()];
+            for (size_t j = r.size(); j > 0; --j)
+            {
+                auto kind = r.enumeration(lsp::occurence_kind::COPY_OP);
+                auto name = r.id();
+                auto occurence_range = r.rng();
+                auto& occ = occurences.emplace_back(kind, name, occurence_range);
+                switch (r.enumeration(opcode_tag::other))
+                {
+                    case opcode_tag::self:
+                        occ.opcode = macro_def;
+                        break;
+                    case opcode_tag::other:
+                        // refer to the macro of the same name, if the context already knows it
+                        if (auto found = macros.find(name); found != macros.end())
+                            occ.opcode = found->second;
+                        else
+                            occ.macro_by_name = true;
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        if (!r.finished())
+            return nullptr;
+
+        return std::make_shared<lsp::macro_info>(external,
+            std::move(definition_location),
+            std::move(macro_def),
+            std::move(var_definitions),
+            std::move(file_scopes),
+            std::move(file_occurences));
+    }
+    catch (const invalid_data&)
+    {
+        return nullptr;
+    }
+}
+
+} // namespace hlasm_plugin::parser_library::workspaces
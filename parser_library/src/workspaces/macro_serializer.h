@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#ifndef HLASMPLUGIN_PARSERLIBRARY_MACRO_SERIALIZER_H
+#define HLASMPLUGIN_PARSERLIBRARY_MACRO_SERIALIZER_H
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "context/hlasm_context.h"
+#include "lsp/macro_info.h"
+
+namespace hlasm_plugin::parser_library::workspaces {
+
+// Version of the binary format produced by serialize_macro.
+// Has to be changed whenever the layout of any serialized structure changes.
+constexpr unsigned macro_serialization_version = 3;
+
+// Converts the macro definition together with its LSP information into a binary form.
+// Returns nullopt, if the definition contains a construct that the format does not support.
+std::optional<std::string> serialize_macro(const lsp::macro_info& macro_i);
+
+// Reconstructs the macro definition from the output of serialize_macro.
+// Identifiers are added into the storage of the context and references to other macros are resolved in it.
+// Returns nullptr, if the data are not valid.
+lsp::macro_info_ptr deserialize_macro(std::string_view data, context::hlasm_context& hlasm_ctx);
+
+} // namespace hlasm_plugin::parser_library::workspaces
+
+#endif
@@ -38,6 +38,10 @@ public:
 
     virtual const asm_option& get_asm_options(const std::string&) = 0;
 
+    // Returns identifier storage for a new open code context.
+    // Providers that share library definitions between programs return one common storage.
+    virtual std::shared_ptr<context::id_storage> get_id_storage() { return std::make_shared<context::id_storage>(); }
+
     virtual ~parse_lib_provider() = default;
 };
 
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "persistent_macro_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+#include "macro_serializer.h"
+
+namespace hlasm_plugin::parser_library::workspaces {
+
+namespace {
+constexpr char cache_magic[] = "HLASMMAC";
+constexpr char entry_extension[] = ".macro";
+
+uint64_t fnv1a_hash(std::string_view text)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : text)
+    {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Describes the state of the library member at the time its macro was stored.
+struct member_stamp
+{
+    std::string file_name;
+    std::string member;
+    std::string sysparm;
+    std::string profile;
+    uint64_t size;
+    uint64_t hash;
+
+    bool operator==(const member_stamp& other) const
+    {
+        return file_name == other.file_name && member == other.member && sysparm == other.sysparm
+            && profile == other.profile && size == other.size && hash == other.hash;
+    }
+};
+
+// the stamp is computed from the text provided by the file manager, so it works for any kind of file
+member_stamp create_stamp(const macro_cache_key& key, file& member_file)
+{
+    const auto& text = member_file.get_text();
+    return member_stamp {
+        key.file_name,
+        *key.member,
+        key.asm_options.sysparm,
+        key.asm_options.profile,
+        text.size(),
+        fnv1a_hash(text),
+    };
+}
+
+void write_string(std::ostream& out, const std::string& s)
+{
+    uint64_t size = s.size();
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.write(s.data(), s.size());
+}
+
+bool read_string(std::istream& in, std::string& s)
+{
+    uint64_t size = 0;
+    if (!in.read(reinterpret_cast<char*>(&size), sizeof(size)) || size > (1ULL << 20))
+        return false;
+    s.resize((size_t)size);
+    return (bool)in.read(s.data(), s.size());
+}
+
+template<typename T>
+void write_value(std::ostream& out, T value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename T>
+bool read_value(std::istream& in, T& value)
+{
+    return (bool)in.read(reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+void write_stamp(std::ostream& out, const member_stamp& stamp)
+{
+    write_string(out, stamp.file_name);
+    write_string(out, stamp.member);
+    write_string(out, stamp.sysparm);
+    write_string(out, stamp.profile);
+    write_value(out, stamp.size);
+    write_value(out, stamp.hash);
+}
+
+bool read_stamp(std::istream& in, member_stamp& stamp)
+{
+    return read_string(in, stamp.file_name) && read_string(in, stamp.member) && read_string(in, stamp.sysparm)
+        && read_string(in, stamp.profile) && read_value(in, stamp.size) && read_value(in, stamp.hash);
+}
+
+// checks that the entry was written in the current format
+bool read_header(std::istream& in)
+{
+    char magic[sizeof(cache_magic)] = {};
+    uint32_t version = 0;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(std::begin(magic), std::end(magic), cache_magic))
+        return false;
+    return read_value(in, version) && version == macro_serialization_version;
+}
+
+std::filesystem::path entry_path(const std::filesystem::path& directory, const member_stamp& stamp)
+{
+    std::ostringstream name;
+    name << std::hex << fnv1a_hash(stamp.file_name + '\0' + stamp.member) << entry_extension;
+    return directory / name.str();
+}
+} // namespace
+
+persistent_macro_cache::persistent_macro_cache(std::filesystem::path directory)
+    : directory_(std::move(directory))
+{}
+
+bool persistent_macro_cache::is_cacheable(const macro_cache_key& key, file& member_file)
+{
+    // members opened in the editor change too often to be worth storing
+    return key.proc_kind == processing::processing_kind::MACRO && key.opsyn_state.empty() && key.member
+        && !member_file.get_lsp_editing();
+}
+
+bool persistent_macro_cache::load(const macro_cache_key& key, const analyzing_context& ctx, file& member_file) const
+{
+    if (!is_cacheable(key, member_file))
+        return false;
+
+    const auto current = create_stamp(key, member_file);
+    const auto path = entry_path(directory_, current);
+    std::ifstream in(path, std::ios::binary);
+    if (!in || !read_header(in))
+        return false;
+
+    member_stamp stored;
+    if (!read_stamp(in, stored) || !(stored == current))
+        return false;
+
+    std::string payload((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    auto macro_i = deserialize_macro(payload, *ctx.hlasm_ctx);
+    if (!macro_i || macro_i->macro_definition->id != key.member)
+        return false;
+
+    ctx.hlasm_ctx->add_macro(macro_i->macro_definition);
+    ctx.lsp_ctx->add_macro(std::move(macro_i), lsp::text_data_ref_t(member_file.get_text()));
+
+    // marks the entry as recently used for cleanup
+    in.close();
+    std::error_code ec;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+    return true;
+}
+
+void persistent_macro_cache::save(const macro_cache_key& key, const analyzing_context& ctx, file& member_file) const
+{
+    if (!is_cacheable(key, member_file))
+        return;
+
+    const auto& macros = ctx.hlasm_ctx->macros();
+    auto found = macros.find(key.member);
+    if (found == macros.end() || found->second->definition_location.file != key.file_name
+        || !found->second->defined_in_single_file())
+        return;
+
+    auto macro_i = ctx.lsp_ctx->get_macro_info(found->second);
+    if (!macro_i)
+        return;
+
+    auto payload = serialize_macro(*macro_i);
+    if (!payload)
+        return;
+
+    const auto stamp = create_stamp(key, member_file);
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    if (ec)
+        return;
+
+    // write into a temporary file first, so concurrent readers never see a partial entry
+    auto path = entry_path(directory_, stamp);
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return;
+        out.write(cache_magic, sizeof(cache_magic));
+        write_value(out, (uint32_t)macro_serialization_version);
+        write_stamp(out, stamp);
+        out.write(payload->data(), payload->size());
+        if (!out)
+        {
+            out.close();
+            std::filesystem::remove(tmp_path, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec)
+        std::filesystem::remove(tmp_path, ec);
+}
+
+void persistent_macro_cache::cleanup(uintmax_t size_limit) const
+{
+    struct entry
+    {
+        std::filesystem::path path;
+        std::filesystem::file_time_type used;
+        uintmax_t size;
+    };
+    std::vector<entry> entries;
+
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(directory_, ec), end; !ec && it != end; it.increment(ec))
+    {
+        std::error_code entry_ec;
+        if (!it->is_regular_file(entry_ec))
+            continue;
+
+        const auto& path = it->path();
+        bool current_format = false;
+        if (path.extension() == entry_extension)
+        {
+            std::ifstream in(path, std::ios::binary);
+            current_format = in && read_header(in);
+        }
+        if (!current_format)
+        {
+            std::filesystem::remove(path, entry_ec);
+            continue;
+        }
+
+        auto size = it->file_size(entry_ec);
+        if (entry_ec)
+            continue;
+        auto used = it->last_write_time(entry_ec);
+        if (entry_ec)
+            continue;
+        entries.push_back({ path, used, size });
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const entry& l, const entry& r) { return l.used > r.used; });
+
+    uintmax_t total_size = 0;
+    for (const auto& e : entries)
+    {
+        total_size += e.size;
+        if (total_size > size_limit)
+            std::filesystem::remove(e.path, ec);
+    }
+}
+
+} // namespace hlasm_plugin::parser_library::workspaces
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#ifndef HLASMPLUGIN_PARSERLIBRARY_PERSISTENT_MACRO_CACHE_H
+#define HLASMPLUGIN_PARSERLIBRARY_PERSISTENT_MACRO_CACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "analyzing_context.h"
+#include "file.h"
+#include "macro_cache.h"
+
+namespace hlasm_plugin::parser_library::workspaces {
+
+// Stores parsed library macros on disk, so that they do not need to be parsed again
+// after the language server is restarted.
+// Every macro is stored in its own file together with the size and hash of the text
+// of the library member it was parsed from. Entries that do not match
+// the current state of the member are ignored and overwritten on the next save.
+// The modification time of an entry is updated whenever it is loaded, so that the entries
+// that were not used for the longest time are removed first when the directory grows too large.
+// All I/O errors are silently ignored, the macro is parsed as usual in such case.
+class persistent_macro_cache final
+{
+    std::filesystem::path directory_;
+
+public:
+    static constexpr uintmax_t default_size_limit = 64 * 1024 * 1024;
+
+    explicit persistent_macro_cache(std::filesystem::path directory);
+
+    // Registers the stored macro into the context, if there is one that is still up to date.
+    // Returns true, if the macro was loaded.
+    bool load(const macro_cache_key& key, const analyzing_context& ctx, file& member_file) const;
+
+    // Stores the macro that has just been parsed into the context.
+    void save(const macro_cache_key& key, const analyzing_context& ctx, file& member_file) const;
+
+    // Removes the entries written in another format and the leftovers of interrupted saves,
+    // then the least recently used entries until the total size of the rest is within the limit.
+    void cleanup(uintmax_t size_limit = default_size_limit) const;
+
+    // Only macros parsed with the default opcode table can be reused across sessions.
+    static bool is_cacheable(const macro_cache_key& key, file& member_file);
+};
+
+} // namespace hlasm_plugin::parser_library::workspaces
+
+#endif
@@ -42,7 +42,16 @@ bool processor_file_impl::is_once_only() const { return false; }
 
 parse_result processor_file_impl::parse(parse_lib_provider& lib_provider)
 {
-    analyzer_ = std::make_unique<analyzer>(get_text(), get_file_name(), lib_provider, get_lsp_editing());
+    const auto& text = get_text();
+
+    // statements parsed by the previous analysis are reused wherever their text did not change
+    parsing::statement_checkpoints checkpoints;
+    if (analyzer_ && get_lsp_editing())
+        checkpoints = analyzer_->take_checkpoints();
+
+    analyzer_ = std::make_unique<analyzer>(text, get_file_name(), lib_provider, get_lsp_editing());
+    if (get_lsp_editing())
+        analyzer_->use_checkpoints(std::move(checkpoints));
 
     auto old_dep = dependencies_;
 
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "text_document.h"
+
+#include <utility>
+#include <vector>
+
+#include "file_impl.h"
+
+namespace hlasm_plugin::parser_library::workspaces {
+
+// Node of a treap ordered by line numbers. Every line except the last one includes its terminator.
+struct line_node
+{
+    std::string line;
+    uint32_t priority;
+    size_t lines = 1;
+    size_t bytes;
+    std::unique_ptr<line_node> left;
+    std::unique_ptr<line_node> right;
+
+    line_node(std::string line, uint32_t priority)
+        : line(std::move(line))
+        , priority(priority)
+        , bytes(this->line.size())
+    {}
+    line_node(const line_node& other)
+        : line(other.line)
+        , priority(other.priority)
+        , lines(other.lines)
+        , bytes(other.bytes)
+        , left(other.left ? std::make_unique<line_node>(*other.left) : nullptr)
+        , right(other.right ? std::make_unique<line_node>(*other.right) : nullptr)
+    {}
+};
+
+namespace {
+using node_ptr = std::unique_ptr<line_node>;
+
+size_t line_count(const node_ptr& n) { return n ? n->lines : 0; }
+size_t byte_count(const node_ptr& n) { return n ? n->bytes : 0; }
+
+void update(line_node& n)
+{
+    n.lines = 1 + line_count(n.left) + line_count(n.right);
+    n.bytes = n.line.size() + byte_count(n.left) + byte_count(n.right);
+}
+
+// splits the tree into the first 'count' lines and the rest
+std::pair<node_ptr, node_ptr> split(node_ptr t, size_t count)
+{
+    if (!t)
+        return {};
+    if (line_count(t->left) >= count)
+    {
+        auto [l, r] = split(std::move(t->left), count);
+        t->left = std::move(r);
+        update(*t);
+        return { std::move(l), std::move(t) };
+    }
+    else
+    {
+        auto [l, r] = split(std::move(t->right), count - line_count(t->left) - 1);
+        t->right = std::move(l);
+        update(*t);
+        return { std::move(t), std::move(r) };
+    }
+}
+
+node_ptr merge(node_ptr l, node_ptr r)
+{
+    if (!l)
+        return r;
+    if (!r)
+        return l;
+    if (l->priority > r->priority)
+    {
+        l->right = merge(std::move(l->right), std::move(r));
+        update(*l);
+        return l;
+    }
+    else
+    {
+        r->left = merge(std::move(l), std::move(r->left));
+        update(*r);
+        return r;
+    }
+}
+
+// returns the node of the line together with the offset of its beginning
+std::pair<const line_node*, size_t> find_line(const line_node* t, size_t line)
+{
+    size_t offset = 0;
+    while (t)
+    {
+        size_t left_lines = line_count(t->left);
+        if (line < left_lines)
+        {
+            t = t->left.get();
+            continue;
+        }
+        offset += byte_count(t->left);
+        if (line == left_lines)
+            return { t, offset };
+        offset += t->line.size();
+        line -= left_lines + 1;
+        t = t->right.get();
+    }
+    return { nullptr, offset };
+}
+
+// returns the line that contains the offset, the end of the text belongs to the last line
+size_t find_line_by_offset(const line_node* t, size_t offset)
+{
+    size_t line = 0;
+    while (t)
+    {
+        size_t left_bytes = byte_count(t->left);
+        if (offset < left_bytes)
+        {
+            t = t->left.get();
+            continue;
+        }
+        offset -= left_bytes;
+        line += line_count(t->left);
+        if (offset < t->line.size() || !t->right)
+            return line;
+        offset -= t->line.size();
+        ++line;
+        t = t->right.get();
+    }
+    return line;
+}
+
+void append_text(const line_node* t, std::string& text)
+{
+    if (!t)
+        return;
+    append_text(t->left.get(), text);
+    text.append(t->line);
+    append_text(t->right.get(), text);
+}
+
+// whether the text ends with a line terminator that is not continued by the next line
+bool ends_line(const std::string& text, const std::string& next_line)
+{
+    return text.back() == '\n' || (text.back() == '\r' && (next_line.empty() || next_line.front() != '\n'));
+}
+} // namespace
+
+text_document::text_document()
+    : text_(std::make_shared<const std::string>())
+{}
+
+text_document::text_document(std::string text)
+    : text_(std::make_shared<const std::string>(std::move(text)))
+{}
+
+text_document::text_document(const text_document& other)
+{
+    std::lock_guard guard(other.text_mutex_);
+    text_ = other.text_;
+    text_valid_ = other.text_valid_;
+    lines_ = other.lines_ ? std::make_unique<line_node>(*other.lines_) : nullptr;
+    seed_ = other.seed_;
+}
+
+text_document& text_document::operator=(const text_document& other)
+{
+    if (this != &other)
+        *this = text_document(other);
+    return *this;
+}
+
+text_document::text_document(text_document&& other) noexcept
+    : text_(other.text_)
+    , text_valid_(other.text_valid_)
+    , lines_(std::move(other.lines_))
+    , seed_(other.seed_)
+{}
+
+text_document& text_document::operator=(text_document&& other) noexcept
+{
+    std::lock_guard guard(text_mutex_);
+    // the text is immutable, the moved-from document keeps it as well
+    text_ = other.text_;
+    text_valid_ = other.text_valid_;
+    lines_ = std::move(other.lines_);
+    seed_ = other.seed_;
+    return *this;
+}
+
+text_document::~text_document() = default;
+
+uint32_t text_document::next_priority()
+{
+    // xorshift32
+    seed_ ^= seed_ << 13;
+    seed_ ^= seed_ >> 17;
+    seed_ ^= seed_ << 5;
+    return seed_;
+}
+
+std::unique_ptr<line_node> text_document::build(const std::string& text, bool with_last_line)
+{
+    auto indices = file_impl::create_line_indices(text);
+    indices.push_back(text.size());
+    if (!with_last_line)
+        indices.pop_back();
+
+    // builds the treap in linear time, the stack holds its right spine
+    std::vector<node_ptr> spine;
+    for (size_t i = 0; i + 1 < indices.size(); ++i)
+    {
+        auto n = std::make_unique<line_node>(text.substr(indices[i], indices[i + 1] - indices[i]), next_priority());
+        node_ptr last;
+        while (!spine.empty() && spine.back()->priority < n->priority)
+        {
+            auto top = std::move(spine.back());
+            spine.pop_back();
+            top->right = std::move(last);
+            update(*top);
+            last = std::move(top);
+        }
+        n->left = std::move(last);
+        spine.push_back(std::move(n));
+    }
+
+    node_ptr last;
+    while (!spine.empty())
+    {
+        auto top = std::move(spine.back());
+        spine.pop_back();
+        top->right = std::move(last);
+        update(*top);
+        last = std::move(top);
+    }
+    return last;
+}
+
+size_t text_document::index_from_position(position pos) const
+{
+    auto [n, offset] = find_line(lines_.get(), (size_t)pos.line);
+    if (!n)
+        return byte_count(lines_);
+
+    // the column may point beyond the end of the line, the following lines are counted as well
+    size_t utf16_count = (size_t)pos.column;
+    size_t line = (size_t)pos.line;
+    while (true)
+    {
+        size_t i = file_impl::advance_utf16(n->line, 0, utf16_count);
+        if (utf16_count == 0 || ++line == line_count(lines_))
+            return offset + i;
+        offset += n->line.size();
+        n = find_line(lines_.get(), line).first;
+    }
+}
+
+size_t text_document::replace(range r, std::string_view new_text)
+{
+    std::lock_guard guard(text_mutex_);
+    if (!lines_)
+        lines_ = build(*text_, true);
+
+    size_t begin = index_from_position(r.start);
+    size_t end = index_from_position(r.end);
+
+    size_t first = find_line_by_offset(lines_.get(), begin);
+    size_t last = find_line_by_offset(lines_.get(), end);
+    // \r at the end of the previous line may be joined with \n at the beginning of the new text
+    if (first > 0 && find_line(lines_.get(), first - 1).first->line.back() == '\r')
+        --first;
+
+    auto [prefix, rest] = split(std::move(lines_), first);
+    auto [changed, suffix] = split(std::move(rest), last - first + 1);
+
+    std::string text;
+    append_text(changed.get(), text);
+    size_t offset = byte_count(prefix);
+    text.replace(begin - offset, end - begin, new_text);
+
+    // the changed lines must be terminated independently of the line that follows them
+    while (suffix && !text.empty() && !ends_line(text, find_line(suffix.get(), 0).first->line))
+    {
+        auto [next, remaining] = split(std::move(suffix), 1);
+        text.append(next->line);
+        suffix = std::move(remaining);
+    }
+
+    auto new_lines = build(text, !suffix);
+    lines_ = merge(merge(std::move(prefix), std::move(new_lines)), std::move(suffix));
+    text_valid_ = false;
+
+    return first;
+}
+
+std::shared_ptr<const std::string> text_document::text() const
+{
+    std::lock_guard guard(text_mutex_);
+    if (!text_valid_)
+    {
+        std::string text;
+        text.reserve(byte_count(lines_));
+        append_text(lines_.get(), text);
+        text_ = std::make_shared<const std::string>(std::move(text));
+        text_valid_ = true;
+    }
+    return text_;
+}
+
+} // namespace hlasm_plugin::parser_library::workspaces
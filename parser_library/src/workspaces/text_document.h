@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#ifndef HLASMPLUGIN_PARSERLIBRARY_TEXT_DOCUMENT_H
+#define HLASMPLUGIN_PARSERLIBRARY_TEXT_DOCUMENT_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "range.h"
+
+namespace hlasm_plugin::parser_library::workspaces {
+
+struct line_node;
+
+// Text of a file. The text is kept as a single string until the first incremental change.
+// From then on it is stored as a balanced tree of lines, so that a change and the mapping of a position
+// to an offset take time logarithmic in the number of lines. The contiguous text is rebuilt only when requested
+// after a change. It is never modified afterwards, so readers on other threads may keep it while the document
+// changes.
+class text_document
+{
+public:
+    text_document();
+    explicit text_document(std::string text);
+
+    text_document(const text_document& other);
+    text_document& operator=(const text_document& other);
+    text_document(text_document&& other) noexcept;
+    text_document& operator=(text_document&& other) noexcept;
+    ~text_document();
+
+    // Replaces the text in the utf-16 based range and returns the first line that was modified.
+    size_t replace(range r, std::string_view new_text);
+
+    std::shared_ptr<const std::string> text() const;
+
+private:
+    mutable std::mutex text_mutex_;
+    // the last requested text, replaced by the first request after a change
+    mutable std::shared_ptr<const std::string> text_;
+    mutable bool text_valid_ = true;
+    // empty until the first change
+    std::unique_ptr<line_node> lines_;
+    uint32_t seed_ = 2463534242;
+
+    uint32_t next_priority();
+    std::unique_ptr<line_node> build(const std::string& text, bool with_last_line);
+    // Returns the index in the text that corresponds to utf-16 based location, see file_impl::index_from_position
+    size_t index_from_position(position pos) const;
+};
+
+} // namespace hlasm_plugin::parser_library::workspaces
+
+#endif
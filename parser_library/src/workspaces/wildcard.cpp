@@ -39,4 +39,102 @@ std::regex wildcard2regex(const std::string& wildcard)
     return std::regex(regex_str);
 }
 
+void wildcard_matcher::add(std::string_view wildcard)
+{
+    const size_t index = starts_.size();
+    starts_.push_back(nodes_.size());
+    for (char c : wildcard)
+    {
+        switch (c)
+        {
+            case '?':
+                nodes_.push_back({ node_kind::any_char, c, index });
+                break;
+            case '*':
+                nodes_.push_back({ node_kind::any_string, c, index });
+                break;
+            case '+':
+                nodes_.push_back({ node_kind::any_char, c, index });
+                nodes_.push_back({ node_kind::any_string, c, index });
+                break;
+            case '/':
+                // same as in wildcard2regex
+                nodes_.push_back({ node_kind::literal, utils::platform::is_windows() ? '\\' : c, index });
+                break;
+            default:
+                nodes_.push_back({ node_kind::literal, c, index });
+                break;
+        }
+    }
+    nodes_.push_back({ node_kind::accept, 0, index });
+}
+
+void wildcard_matcher::add_closure(
+    size_t node_index, std::vector<size_t>& states, std::vector<size_t>& added, size_t step) const
+{
+    while (added[node_index] != step)
+    {
+        added[node_index] = step;
+        states.push_back(node_index);
+        // any string may also be empty
+        if (nodes_[node_index].kind != node_kind::any_string)
+            break;
+        ++node_index;
+    }
+}
+
+std::optional<size_t> wildcard_matcher::match(std::string_view name) const
+{
+    std::vector<size_t> states;
+    std::vector<size_t> next;
+    // the step in which the node was added into the state set, prevents duplicates
+    std::vector<size_t> added(nodes_.size(), (size_t)-1);
+
+    size_t step = 0;
+    for (auto start : starts_)
+        add_closure(start, states, added, step);
+
+    for (char c : name)
+    {
+        if (states.empty())
+            return std::nullopt;
+
+        ++step;
+        next.clear();
+        for (auto s : states)
+        {
+            switch (nodes_[s].kind)
+            {
+                case node_kind::literal:
+                    if (nodes_[s].c == c)
+                        add_closure(s + 1, next, added, step);
+                    break;
+                case node_kind::any_char:
+                    add_closure(s + 1, next, added, step);
+                    break;
+                case node_kind::any_string:
+                    add_closure(s, next, added, step);
+                    break;
+                case node_kind::accept:
+                    break;
+            }
+        }
+        std::swap(states, next);
+    }
+
+    std::optional<size_t> result;
+    for (auto s : states)
+    {
+        if (nodes_[s].kind == node_kind::accept && (!result || nodes_[s].wildcard < *result))
+            result = nodes_[s].wildcard;
+    }
+    return result;
+}
+
+void wildcard_matcher::clear()
+{
+    nodes_.clear();
+    starts_.clear();
+}
+
 } // namespace hlasm_plugin::parser_library::workspaces
\ No newline at end of file
@@ -15,12 +15,51 @@
 #ifndef HLASMPLUGIN_PARSERLIBRARY_WILDCARD_H
 #define HLASMPLUGIN_PARSERLIBRARY_WILDCARD_H
 
+#include <optional>
 #include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace hlasm_plugin::parser_library::workspaces {
 // Returns a regex that can be used for wildcard matching.
 std::regex wildcard2regex(const std::string& wildcard);
 
+// Matches names against a list of wildcards with the same meaning as in wildcard2regex.
+// All wildcards are compiled into a single automaton, so a name is matched in a single pass
+// regardless of the number of wildcards.
+class wildcard_matcher
+{
+    enum class node_kind : unsigned char
+    {
+        literal,
+        any_char,
+        any_string,
+        accept,
+    };
+    struct node
+    {
+        node_kind kind;
+        char c;
+        // index of the wildcard that the node belongs to
+        size_t wildcard;
+    };
+
+    std::vector<node> nodes_;
+    std::vector<size_t> starts_;
+
+    void add_closure(size_t node_index, std::vector<size_t>& states, std::vector<size_t>& added, size_t step) const;
+
+public:
+    // Adds the wildcard to the end of the list.
+    void add(std::string_view wildcard);
+    // Returns the index of the first wildcard in the list that matches the whole name.
+    std::optional<size_t> match(std::string_view name) const;
+
+    size_t size() const { return starts_.size(); }
+    void clear();
+};
+
 } // namespace hlasm_plugin::parser_library::workspaces
 
 #endif
\ No newline at end of file
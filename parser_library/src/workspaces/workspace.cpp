@@ -16,11 +16,14 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <regex>
 #include <string>
 
+#include "analyzer.h"
+#include "lexing/statement_index.h"
 #include "lib_config.h"
 #include "library_local.h"
 #include "nlohmann/json.hpp"
@@ -49,6 +52,15 @@ workspace::workspace(const ws_uri& uri,
     auto hlasm_folder = utils::path::join(ws_path_, HLASM_PLUGIN_FOLDER);
     proc_grps_path_ = utils::path::join(hlasm_folder, FILENAME_PROC_GRPS);
     pgm_conf_path_ = utils::path::join(hlasm_folder, FILENAME_PGM_CONF);
+
+    std::error_code ec;
+    if (!uri_.empty() && std::filesystem::is_directory(hlasm_folder, ec))
+    {
+        persistent_macro_cache_ =
+            std::make_unique<persistent_macro_cache>(utils::path::join(hlasm_folder, MACRO_CACHE_FOLDER));
+        // the entries are trimmed once per workspace load, the saves in between only replace the stale ones
+        persistent_macro_cache_->cleanup();
+    }
 }
 
 workspace::workspace(
@@ -73,7 +85,14 @@ void workspace::collect_diags() const
         add_diagnostic(diag);
 }
 
-void workspace::add_proc_grp(processor_group pg) { proc_grps_.emplace(pg.name(), std::move(pg)); }
+void workspace::add_proc_grp(processor_group pg)
+{
+    {
+        std::lock_guard guard(*proc_grp_by_program_mutex_);
+        proc_grp_by_program_.clear();
+    }
+    proc_grps_.emplace(pg.name(), std::move(pg));
+}
 
 bool workspace::program_id_match(const std::string& filename, const program_id& program) const
 {
@@ -85,12 +104,9 @@ std::vector<processor_file_ptr> workspace::find_related_opencodes(const std::str
 {
     std::vector<processor_file_ptr> opencodes;
 
-    for (const auto& dep : dependants_)
+    for (const auto& dep : dependencies_.dependants_of(document_uri))
     {
-        auto f = file_manager_.find_processor_file(dep);
-        if (!f)
-            continue;
-        if (f->dependencies().find(document_uri) != f->dependencies().end())
+        if (auto f = file_manager_.find_processor_file(dep))
             opencodes.push_back(std::move(f));
     }
 
@@ -131,19 +147,20 @@ const processor_group& workspace::get_proc_grp_by_program(const std::string& fil
 {
     assert(opened_);
 
+    std::lock_guard guard(*proc_grp_by_program_mutex_);
+    auto [cached, inserted] = proc_grp_by_program_.try_emplace(filename, nullptr);
+    if (!inserted)
+        return cached->second ? *cached->second : implicit_proc_grp;
+
     std::string file = utils::path::lexically_normal(utils::path::lexically_relative(filename, uri_)).string();
 
     // direct match
-    auto program = exact_pgm_conf_.find(file);
-    if (program != exact_pgm_conf_.cend())
-        return proc_grps_.at(program->second.pgroup);
+    if (auto program = exact_pgm_conf_.find(file); program != exact_pgm_conf_.cend())
+        cached->second = &proc_grps_.at(program->second.pgroup);
+    else if (auto wildcard = wildcard_pgm_matcher_.match(file))
+        cached->second = &proc_grps_.at(wildcard_pgm_conf_[*wildcard].pgroup);
 
-    for (const auto& pgm : regex_pgm_conf_)
-    {
-        if (std::regex_match(file, pgm.second))
-            return proc_grps_.at(pgm.first.pgroup);
-    }
-    return implicit_proc_grp;
+    return cached->second ? *cached->second : implicit_proc_grp;
 }
 
 const ws_uri& workspace::uri() { return uri_; }
@@ -156,38 +173,30 @@ void workspace::parse_file(const std::string& file_uri)
     {
         if (load_and_process_config())
         {
-            for (auto fname : dependants_)
+            std::vector<processor_file_ptr> files;
+            for (const auto& fname : dependencies_.dependants())
             {
                 auto found = file_manager_.find_processor_file(fname);
                 if (found)
-                    found->parse(*this);
+                    files.push_back(found);
             }
+            parse_files_(files);
 
-            for (auto fname : dependants_)
-            {
-                auto found = file_manager_.find_processor_file(fname);
-                if (found)
-                    filter_and_close_dependencies_(found->files_to_close(), found);
-            }
+            for (const auto& f : files)
+                dependencies_.update(f->get_file_name(), f->dependencies());
+
+            for (const auto& f : files)
+                filter_and_close_dependencies_(f->files_to_close(), f);
         }
         return;
     }
     // what about removing files??? what if depentands_ points to not existing file?
     std::vector<processor_file_ptr> files_to_parse;
 
-    for (auto fname : dependants_)
+    for (const auto& fname : dependencies_.dependants_of(file_uri))
     {
-        auto f = file_manager_.find_processor_file(fname);
-        if (!f)
-            continue;
-        for (auto& name : f->dependencies())
-        {
-            if (name == file_uri)
-            {
-                files_to_parse.push_back(f);
-                break;
-            }
-        }
+        if (auto f = file_manager_.find_processor_file(fname))
+            files_to_parse.push_back(f);
     }
 
     if (files_to_parse.empty())
@@ -197,12 +206,11 @@ void workspace::parse_file(const std::string& file_uri)
             files_to_parse.push_back(f);
     }
 
+    parse_files_(files_to_parse);
+
     for (auto f : files_to_parse)
     {
-        f->parse(*this);
-        if (!f->dependencies().empty())
-            dependants_.insert(f->get_file_name());
-
+        dependencies_.update(f->get_file_name(), f->dependencies());
 
         // if there is no processor group assigned to the program, delete diagnostics that may have been created
         if (cancel_ && cancel_->load()) // skip, if parsing was cancelled using the cancellation token
@@ -221,6 +229,36 @@ void workspace::parse_file(const std::string& file_uri)
         filter_and_close_dependencies_(f->files_to_close(), f);
 }
 
+void workspace::parse_files_(const std::vector<processor_file_ptr>& files)
+{
+    // a file that is a dependency of another one may be parsed as its library, so it must not run concurrently
+    std::set<std::string> used_as_dependency;
+    for (const auto& f : files)
+        used_as_dependency.insert(f->dependencies().begin(), f->dependencies().end());
+
+    for (const auto& f : files)
+        prefetch_macros(f->get_file_name(), f->get_text());
+
+    std::vector<std::function<void()>> independent;
+    std::vector<processor_file_ptr> dependent;
+    for (const auto& f : files)
+    {
+        if (used_as_dependency.count(f->get_file_name()))
+            dependent.push_back(f);
+        else
+            independent.emplace_back([this, f]() { f->parse(*this); });
+    }
+
+    prefetch_->run_parallel(std::move(independent), cancel_);
+
+    for (const auto& f : dependent)
+    {
+        if (cancel_ && cancel_->load())
+            break;
+        f->parse(*this);
+    }
+}
+
 void workspace::refresh_libraries()
 {
     for (auto& proc_grp : proc_grps_)
@@ -246,14 +284,14 @@ void workspace::did_close_file(const std::string& file_uri)
     }
 
     // find if the file is a dependant
-    auto fname = dependants_.find(file_uri);
-    if (fname != dependants_.end())
+    if (dependencies_.is_dependant(file_uri))
     {
-        auto file = file_manager_.find_processor_file(*fname);
+        auto file = file_manager_.find_processor_file(file_uri);
         // filter the dependencies that should not be closed
-        filter_and_close_dependencies_(file->dependencies(), file);
+        if (file)
+            filter_and_close_dependencies_(file->dependencies(), file);
         // remove it from dependants
-        dependants_.erase(fname);
+        dependencies_.remove(file_uri);
     }
 
     // close the file itself
@@ -265,7 +303,13 @@ void workspace::did_change_file(const std::string file_uri, const document_chang
 
 void workspace::did_change_watched_files(const std::string& file_uri)
 {
-    refresh_libraries();
+    prefetch_->wait_all();
+    macro_cache_.erase(file_uri);
+    for (auto& proc_grp : proc_grps_)
+    {
+        for (auto& lib : proc_grp.second.libraries())
+            lib->file_changed(file_uri);
+    }
     parse_file(file_uri);
 }
 
@@ -308,7 +352,10 @@ lsp::completion_list_s workspace::completion(const std::string& document_uri,
     return opencodes.back()->get_lsp_feature_provider().completion(document_uri, pos, trigger_char, trigger_kind);
 }
 
-void workspace::open() { load_and_process_config(); }
+void workspace::open()
+{
+    load_and_process_config();
+}
 
 void workspace::close() { opened_ = false; }
 
@@ -331,10 +378,21 @@ bool workspace::load_and_process_config()
 
     opened_ = true;
 
+    // libraries and options may change, previously parsed members cannot be reused
+    prefetch_->wait_all();
+    macro_cache_.clear();
+    ids_ = std::make_shared<context::id_storage>();
+
     config::pgm_conf pgm_config;
     config::proc_conf proc_groups;
     file_ptr pgm_conf_file;
 
+    // the assignment of processor groups to programs is about to change
+    {
+        std::lock_guard guard(*proc_grp_by_program_mutex_);
+        proc_grp_by_program_.clear();
+    }
+
     bool load_ok = load_config(proc_groups, pgm_config, pgm_conf_file);
     if (!load_ok)
         return false;
@@ -404,7 +462,10 @@ bool workspace::load_and_process_config()
             if (!is_wildcard(pgm_name))
                 exact_pgm_conf_.emplace(pgm_name, program { pgm_name, pgm.pgroup });
             else
-                regex_pgm_conf_.push_back({ program { pgm_name, pgm.pgroup }, wildcard2regex(pgm_name) });
+            {
+                wildcard_pgm_conf_.emplace_back(pgm_name, pgm.pgroup);
+                wildcard_pgm_matcher_.add(pgm_name);
+            }
         }
         else
         {
@@ -449,7 +510,8 @@ bool workspace::load_config(config::proc_conf& proc_groups, config::pgm_conf& pg
     {
         nlohmann::json::parse(pgm_conf_file->get_text()).get_to(pgm_config);
         exact_pgm_conf_.clear();
-        regex_pgm_conf_.clear();
+        wildcard_pgm_conf_.clear();
+        wildcard_pgm_matcher_.clear();
     }
     catch (const nlohmann::json::exception&)
     {
@@ -476,16 +538,12 @@ void workspace::filter_and_close_dependencies_(const std::set<std::string>& depe
     }
 
     // filters the files that are dependencies of other dependants and externally open files
-    for (auto dependant : dependants_)
+    for (auto it = filtered.begin(); it != filtered.end();)
     {
-        auto fdependant = file_manager_.find_processor_file(dependant);
-        if (!fdependant)
-            continue;
-        for (auto& dependency : fdependant->dependencies())
-        {
-            if (fdependant->get_file_name() != file->get_file_name() && filtered.find(dependency) != filtered.end())
-                filtered.erase(dependency);
-        }
+        if (dependencies_.has_other_dependant(*it, file->get_file_name()))
+            it = filtered.erase(it);
+        else
+            ++it;
     }
 
     // close all exclusive dependencies of file
@@ -496,37 +554,233 @@ void workspace::filter_and_close_dependencies_(const std::set<std::string>& depe
     }
 }
 
-bool workspace::is_dependency_(const std::string& file_uri)
+bool workspace::is_dependency_(const std::string& file_uri) { return dependencies_.is_dependency(file_uri); }
+
+namespace {
+// set while the current thread parses a member in the background
+thread_local bool prefetching_member = false;
+} // namespace
+
+bool workspace::waits_for_current_thread(const std::string& member_name) const
 {
-    for (auto dependant : dependants_)
+    const auto current = std::this_thread::get_id();
+    for (auto it = members_in_parsing_.find(member_name); it != members_in_parsing_.end();)
     {
-        auto fdependant = file_manager_.find_processor_file(dependant);
-        if (!fdependant)
-            continue;
-        for (auto& dependency : fdependant->dependencies())
+        if (it->second.parser == current)
+            return true;
+        auto waiting = waiting_for_member_.find(it->second.parser);
+        if (waiting == waiting_for_member_.end())
+            return false;
+        it = members_in_parsing_.find(waiting->second);
+    }
+    return false;
+}
+
+parse_result workspace::parse_library(const std::string& library, analyzing_context ctx, const library_data data)
+{
+    std::shared_ptr<processor> found;
+    {
+        std::lock_guard guard(*library_mutex_);
+        auto& proc_grp = get_proc_grp_by_program(ctx.hlasm_ctx->opencode_file_name());
+        for (auto&& lib : proc_grp.libraries())
+        {
+            found = lib->find_file(library);
+            if (found)
+                break;
+        }
+    }
+    if (!found)
+        return false;
+
+    auto found_file = std::dynamic_pointer_cast<file>(found);
+    if (!found_file)
+        return found->parse_macro(*this, std::move(ctx), data);
+
+    const auto& member_name = found_file->get_file_name();
+    auto cache_key = macro_cache_key::create_from_context(member_name, *ctx.hlasm_ctx, data);
+
+    // the prefetch parses the macros with the options of the program and without OPSYN,
+    // the analysis waits only for a result it can use
+    // the library lock is not held here and the prefetch tasks never wait for the analysis
+    const auto& program_options = get_asm_options(ctx.hlasm_ctx->opencode_file_name());
+    if (cache_key.proc_kind == processing::processing_kind::MACRO && cache_key.opsyn_state.empty()
+        && cache_key.asm_options.sysparm == program_options.sysparm
+        && cache_key.asm_options.profile == program_options.profile)
+        prefetch_->wait_for(library);
+
+    // only one thread at a time parses the member, the others wait for it and use the cached result
+    std::promise<void> member_parsed;
+    {
+        std::unique_lock guard(*library_mutex_);
+        while (true)
         {
-            if (dependency == file_uri)
+            if (macro_cache_.load_from_cache(cache_key, ctx, found_file))
                 return true;
+
+            auto other_parse = members_in_parsing_.find(member_name);
+            if (other_parse == members_in_parsing_.end())
+                break;
+
+            // the prefetch never waits for the analysis, and the other parser may be waiting for a member
+            // this thread is parsing, the member is then parsed once more without updating the state of its file
+            if (prefetching_member || waits_for_current_thread(member_name))
+            {
+                guard.unlock();
+                return found->parse_no_lsp_update(*this, std::move(ctx), data);
+            }
+
+            auto parsed = other_parse->second.parsed;
+            waiting_for_member_.insert_or_assign(std::this_thread::get_id(), member_name);
+            guard.unlock();
+            parsed.wait();
+            guard.lock();
+            waiting_for_member_.erase(std::this_thread::get_id());
         }
+        members_in_parsing_.try_emplace(
+            member_name, member_in_parsing { member_parsed.get_future().share(), std::this_thread::get_id() });
+        // the text is loaded before the member is parsed outside of the lock
+        found_file->get_text();
     }
-    return false;
+
+    const bool result = parse_member(found, found_file, std::move(cache_key), ctx, data);
+
+    {
+        std::lock_guard guard(*library_mutex_);
+        members_in_parsing_.erase(member_name);
+    }
+    member_parsed.set_value();
+
+    return result;
 }
 
-parse_result workspace::parse_library(const std::string& library, analyzing_context ctx, const library_data data)
+bool workspace::parse_member(const std::shared_ptr<processor>& found,
+    const std::shared_ptr<file>& found_file,
+    macro_cache_key cache_key,
+    const analyzing_context& ctx,
+    const library_data& data)
 {
-    auto& proc_grp = get_proc_grp_by_program(ctx.hlasm_ctx->opencode_file_name());
-    for (auto&& lib : proc_grp.libraries())
+    if (persistent_macro_cache_ && persistent_macro_cache_->load(cache_key, ctx, *found_file))
     {
-        std::shared_ptr<processor> found = lib->find_file(library);
-        if (found)
-            return found->parse_macro(*this, std::move(ctx), data);
+        std::lock_guard guard(*library_mutex_);
+        macro_cache_.save(std::move(cache_key), ctx, found_file);
+        return true;
     }
 
-    return false;
+    // the macros called from the copy member can be parsed while the analysis continues
+    if (data.proc_kind == processing::processing_kind::COPY)
+        prefetch_macros(ctx.hlasm_ctx->opencode_file_name(), found_file->get_text());
+
+    if (!found->parse_macro(*this, ctx, data))
+        return false;
+
+    // diagnostics are not stored, members that produce any are always parsed again
+    if (persistent_macro_cache_ && found->diags().empty())
+        persistent_macro_cache_->save(cache_key, ctx, *found_file);
+
+    std::lock_guard guard(*library_mutex_);
+    macro_cache_.save(std::move(cache_key), ctx, found_file);
+    return true;
+}
+
+void workspace::set_library_prefetch(bool enabled) { library_prefetch_enabled_ = enabled; }
+
+void workspace::prefetch_macros(const std::string& program, const std::string& text)
+{
+    if (!library_prefetch_enabled_ || get_proc_grp_by_program(program).libraries().empty())
+        return;
+
+    // even the statements are looked through in the background, the analysis continues right away
+    prefetch_->start([this, program, text]() { start_prefetch(program, text); });
+}
+
+void workspace::start_prefetch(const std::string& program, const std::string& text)
+{
+    const auto& proc_grp = get_proc_grp_by_program(program);
+
+    std::shared_ptr<context::id_storage> ids;
+    {
+        std::lock_guard guard(*library_mutex_);
+        ids = ids_;
+    }
+    const auto& asm_options = proc_grp.asm_options();
+
+    std::set<context::id_index> names;
+    for (const auto& stmt : lexing::statement_index(text, lexing::source_format(), *ids).statements())
+        if (stmt.instruction && stmt.instruction != context::id_storage::empty_id
+            && !context::hlasm_context::find_instruction(stmt.instruction))
+            names.insert(stmt.instruction);
+
+    std::vector<std::pair<std::string, library_prefetch::task>> tasks;
+
+    std::unique_lock guard(*library_mutex_);
+    for (auto name : names)
+    {
+        std::shared_ptr<file> member;
+        for (auto&& lib : proc_grp.libraries())
+        {
+            if (auto found = lib->find_file(*name))
+            {
+                member = std::dynamic_pointer_cast<file>(found);
+                break;
+            }
+        }
+        // members open in the editor are parsed by the analysis, which keeps their LSP information
+        if (!member || member->get_lsp_editing())
+            continue;
+
+        // the key of a macro called before any OPSYN in the program
+        macro_cache_key key {
+            member->get_file_name(), processing::processing_kind::MACRO, name, asm_options, {}, ids.get()
+        };
+        if (macro_cache_.contains(key, member))
+            continue;
+
+        tasks.emplace_back(*name, [this, program, asm_options, ids, member, key = std::move(key)]() mutable {
+            prefetch_macro(program, asm_options, std::move(ids), std::move(member), std::move(key));
+        });
+    }
+    guard.unlock();
+
+    prefetch_->start(std::move(tasks));
+}
+
+void workspace::prefetch_macro(const std::string& program,
+    const asm_option& asm_options,
+    std::shared_ptr<context::id_storage> ids,
+    std::shared_ptr<file> member,
+    macro_cache_key key)
+{
+    std::string text;
+    version_t version;
+    {
+        std::lock_guard guard(*library_mutex_);
+        if (macro_cache_.contains(key, member))
+            return;
+        text = member->get_text();
+        version = member->get_version();
+    }
+
+    analyzing_context ctx { std::make_shared<context::hlasm_context>(program, asm_options, std::move(ids)),
+        std::make_shared<lsp::lsp_context>() };
+    analyzer a(text, member->get_file_name(), ctx, *this, library_data { key.proc_kind, key.member });
+    // the nested members are parsed without waiting for the analysis
+    prefetching_member = true;
+    a.analyze(cancel_);
+    prefetching_member = false;
+    a.collect_diags();
+
+    // members with diagnostics are left to the analysis, which reports them
+    if ((cancel_ && cancel_->load()) || !a.diags().empty())
+        return;
+
+    std::lock_guard guard(*library_mutex_);
+    if (member->get_version() == version)
+        macro_cache_.save(std::move(key), ctx, member);
 }
 
 bool workspace::has_library(const std::string& library, const std::string& program) const
 {
+    std::lock_guard guard(*library_mutex_);
     auto& proc_grp = get_proc_grp_by_program(program);
     for (auto&& lib : proc_grp.libraries())
     {
@@ -545,6 +799,18 @@ const asm_option& workspace::get_asm_options(const std::string& file_name)
     return proc_grp.asm_options();
 }
 
+std::shared_ptr<context::id_storage> workspace::get_id_storage()
+{
+    std::lock_guard guard(*library_mutex_);
+    // the cached members refer to the identifiers of the replaced storage, they can never be used again
+    if (ids_->size() > MAX_SHARED_IDS)
+    {
+        ids_ = std::make_shared<context::id_storage>();
+        macro_cache_.clear();
+    }
+    return ids_;
+}
+
 processor_file_ptr workspace::get_processor_file(const std::string& filename)
 {
     return get_file_manager().get_processor_file(filename);
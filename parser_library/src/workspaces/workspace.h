@@ -17,22 +17,31 @@
 
 #include <atomic>
 #include <filesystem>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <regex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "config/pgm_conf.h"
 #include "config/proc_conf.h"
+#include "dependency_index.h"
 #include "diagnosable_impl.h"
 #include "file_manager.h"
 #include "lib_config.h"
 #include "library.h"
+#include "library_prefetch.h"
+#include "macro_cache.h"
 #include "message_consumer.h"
+#include "persistent_macro_cache.h"
 #include "processor.h"
 #include "processor_group.h"
+#include "wildcard.h"
 
 
 namespace hlasm_plugin::parser_library::workspaces {
@@ -62,6 +71,8 @@ struct program
 class workspace : public diagnosable_impl, public parse_lib_provider, public lsp::feature_provider
 {
 public:
+    constexpr static size_t MAX_SHARED_IDS = 1 << 20;
+
     // Creates just a dummy workspace with no libraries - no dependencies
     // between files.
     workspace(file_manager& file_manager, const lib_config& global_config, std::atomic<bool>* cancel = nullptr);
@@ -78,7 +89,8 @@ public:
     workspace(const workspace& ws) = delete;
     workspace& operator=(const workspace&) = delete;
 
-    workspace(workspace&& ws) = default;
+    // the prefetch tasks refer to the workspace, it never moves
+    workspace(workspace&& ws) = delete;
     workspace& operator=(workspace&&) = delete;
 
     void collect_diags() const override;
@@ -105,6 +117,7 @@ public:
     parse_result parse_library(const std::string& library, analyzing_context ctx, const library_data data) override;
     bool has_library(const std::string& library, const std::string& program) const override;
     const asm_option& get_asm_options(const std::string& file_name) override;
+    std::shared_ptr<context::id_storage> get_id_storage() override;
     const ws_uri& uri();
 
     void open();
@@ -112,6 +125,9 @@ public:
 
     void set_message_consumer(message_consumer* consumer);
 
+    // parses the library macros called by the programs in the background (default)
+    void set_library_prefetch(bool enabled);
+
     processor_file_ptr get_processor_file(const std::string& filename);
 
 protected:
@@ -121,6 +137,7 @@ private:
     constexpr static char FILENAME_PROC_GRPS[] = "proc_grps.json";
     constexpr static char FILENAME_PGM_CONF[] = "pgm_conf.json";
     constexpr static char HLASM_PLUGIN_FOLDER[] = ".hlasmplugin";
+    constexpr static char MACRO_CACHE_FOLDER[] = "macro_cache";
 
     std::atomic<bool>* cancel_;
 
@@ -130,9 +147,33 @@ private:
 
     std::unordered_map<proc_grp_id, processor_group> proc_grps_;
     std::map<std::string, program> exact_pgm_conf_;
-    std::vector<std::pair<program, std::regex>> regex_pgm_conf_;
+    std::vector<program> wildcard_pgm_conf_;
+    wildcard_matcher wildcard_pgm_matcher_;
+    // processor groups already assigned to programs, nullptr stands for the implicit group
+    mutable std::unordered_map<std::string, const processor_group*> proc_grp_by_program_;
+    std::unique_ptr<std::mutex> proc_grp_by_program_mutex_ = std::make_unique<std::mutex>();
     processor_group implicit_proc_grp;
 
+    // identifiers shared by all open codes in the workspace, so they can share cached library members
+    // the storage only grows, it is replaced together with the cached members when the configuration is reloaded
+    // or when it holds more than MAX_SHARED_IDS identifiers, the running analyses keep the previous one
+    std::shared_ptr<context::id_storage> ids_ = std::make_shared<context::id_storage>();
+    macro_cache macro_cache_;
+    // present only when the workspace has the .hlasmplugin folder to store the cache in
+    std::unique_ptr<persistent_macro_cache> persistent_macro_cache_;
+    // open codes may be analyzed in parallel, libraries and the macro cache are accessed one at a time,
+    // the members are parsed outside of the lock
+    std::unique_ptr<std::recursive_mutex> library_mutex_ = std::make_unique<std::recursive_mutex>();
+    struct member_in_parsing
+    {
+        // completed once the member is parsed and cached
+        std::shared_future<void> parsed;
+        std::thread::id parser;
+    };
+    // library members being parsed and the members their parsers wait for, to detect the waits that would never end
+    std::unordered_map<std::string, member_in_parsing> members_in_parsing_;
+    std::unordered_map<std::thread::id, std::string> waiting_for_member_;
+
     std::filesystem::path ws_path_;
     std::filesystem::path proc_grps_path_;
     std::filesystem::path pgm_conf_path_;
@@ -140,6 +181,9 @@ private:
     bool opened_ = false;
 
 
+    // returns true, if the parser of the member waits, possibly through other parsers, for the current thread
+    bool waits_for_current_thread(const std::string& member_name) const;
+
     bool load_and_process_config();
     // Loads the pgm_conf.json and proc_grps.json from disk, adds them to file_manager_ and parses both jsons.
     // Returns false if there is any error.
@@ -147,12 +191,14 @@ private:
 
     bool is_wildcard(const std::string& str);
 
-    // files, that depend on others (e.g. open code files that use macros)
-    std::set<std::string> dependants_;
+    // files, that depend on others (e.g. open code files that use macros) and their dependencies
+    dependency_index dependencies_;
 
     diagnostic_container config_diags_;
 
     void filter_and_close_dependencies_(const std::set<std::string>& dependencies, processor_file_ptr file);
+    // parses the files, those that are not used as a dependency of the others are processed in parallel
+    void parse_files_(const std::vector<processor_file_ptr>& files);
     bool is_dependency_(const std::string& file_uri);
 
     bool program_id_match(const std::string& filename, const program_id& program) const;
@@ -160,6 +206,24 @@ private:
     std::vector<processor_file_ptr> find_related_opencodes(const std::string& document_uri) const;
     void delete_diags(processor_file_ptr file);
 
+    // parses the library member, the calling thread is the only one parsing it
+    bool parse_member(const std::shared_ptr<processor>& found,
+        const std::shared_ptr<file>& found_file,
+        macro_cache_key cache_key,
+        const analyzing_context& ctx,
+        const library_data& data);
+
+    // starts parsing the library macros called from the text on background threads, so that the analysis of the
+    // program finds them in the macro cache
+    void prefetch_macros(const std::string& program, const std::string& text);
+    // looks for the library macros called from the text and starts parsing them
+    void start_prefetch(const std::string& program, const std::string& text);
+    void prefetch_macro(const std::string& program,
+        const asm_option& asm_options,
+        std::shared_ptr<context::id_storage> ids,
+        std::shared_ptr<file> member,
+        macro_cache_key key);
+
     void show_message(const std::string& message);
 
     message_consumer* message_consumer_ = nullptr;
@@ -169,6 +233,10 @@ private:
     const lib_config& global_config_;
     lib_config local_config_;
     lib_config get_config();
+
+    bool library_prefetch_enabled_ = true;
+    // declared last, the running prefetch tasks use the other members
+    std::unique_ptr<library_prefetch> prefetch_ = std::make_unique<library_prefetch>();
 };
 
 } // namespace hlasm_plugin::parser_library::workspaces
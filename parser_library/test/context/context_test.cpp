@@ -63,6 +63,56 @@ TEST(context_id_storage, case_insensitive)
     ASSERT_TRUE(it1 == it3);
 }
 
+TEST(context_id_storage, uri_keeps_case)
+{
+    id_storage ids;
+
+    auto uri = ids.add("file:///dir/file", true);
+    EXPECT_EQ(*uri, "file:///dir/file");
+    EXPECT_EQ(ids.add("file:///dir/file", true), uri);
+    EXPECT_NE(ids.add("file:///dir/file"), uri);
+    EXPECT_EQ(*ids.find("file:///dir/file"), "FILE:///DIR/FILE");
+}
+
+TEST(context_id_storage, stable_indexes)
+{
+    id_storage ids;
+
+    std::vector<id_index> indexes;
+    for (size_t i = 0; i < 10000; ++i)
+        indexes.push_back(ids.add("sym" + std::to_string(i)));
+
+    for (size_t i = 0; i < indexes.size(); ++i)
+    {
+        const std::string name = "SYM" + std::to_string(i);
+        ASSERT_EQ(ids.find(std::string_view(name)), indexes[i]);
+        ASSERT_EQ(*indexes[i], name);
+    }
+    EXPECT_FALSE(ids.find("SYM10000"));
+    EXPECT_EQ(ids.find("copy"), ids.well_known.COPY);
+}
+
+TEST(context, find_instruction)
+{
+    hlasm_context ctx;
+
+    auto lr = hlasm_context::find_instruction(ctx.ids().add("lr"));
+    ASSERT_TRUE(lr);
+    EXPECT_TRUE(std::holds_alternative<const machine_instruction*>(*lr));
+
+    auto seta = hlasm_context::find_instruction(ctx.ids().add("SETA"));
+    ASSERT_TRUE(seta);
+    EXPECT_TRUE(std::holds_alternative<const ca_instruction*>(*seta));
+
+    auto b = hlasm_context::find_instruction(ctx.ids().add("B"));
+    ASSERT_TRUE(b);
+    EXPECT_TRUE(std::holds_alternative<const mnemonic_code*>(*b));
+
+    EXPECT_FALSE(hlasm_context::find_instruction(ctx.ids().add("NOTINSTR")));
+    EXPECT_FALSE(hlasm_context::find_instruction(id_storage::empty_id));
+    EXPECT_EQ(ctx.get_operation_code(ctx.ids().add("LR")).opcode_detail, *lr);
+}
+
 TEST(context, create_global_var)
 {
     hlasm_context ctx;
@@ -176,6 +226,71 @@ TEST(context_set_vars, set_non_scalar)
 }
 
 
+TEST(context_set_vars, set_non_scalar_keys)
+{
+    hlasm_context ctx;
+
+    auto idx = ctx.ids().add("var");
+
+    set_symbol<A_t> var(idx, false, false);
+
+    for (size_t i = 0; i < 100; ++i)
+        var.set_value((A_t)i, i);
+
+    // far beyond the filled values
+    var.set_value(7, 1000000);
+    var.set_value(5, 500);
+
+    EXPECT_EQ(var.size(), (size_t)102);
+    EXPECT_EQ(var.number({}), 1000001);
+    EXPECT_EQ(var.get_value(99), 99);
+    EXPECT_EQ(var.get_value(500), 5);
+    EXPECT_EQ(var.get_value(1000000), 7);
+    EXPECT_EQ(var.get_value(999999), 0);
+
+    auto keys = var.keys();
+    ASSERT_EQ(keys.size(), (size_t)102);
+    EXPECT_EQ(keys[99], (size_t)99);
+    EXPECT_EQ(keys[100], (size_t)500);
+    EXPECT_EQ(keys[101], (size_t)1000000);
+
+    // the values in between fill the gap
+    for (size_t i = 100; i < 500; ++i)
+        var.set_value(1, i);
+
+    EXPECT_EQ(var.size(), (size_t)502);
+    EXPECT_EQ(var.get_value(500), 5);
+    EXPECT_EQ(var.number({}), 1000001);
+}
+
+TEST(context_set_vars, set_t_values)
+{
+    SET_t a(10);
+    SET_t b(true);
+    SET_t c(std::string(100, 'C'));
+
+    EXPECT_EQ(a.access_a(), 10);
+    EXPECT_TRUE(a.access_b());
+    EXPECT_EQ(a.access_c(), "");
+    EXPECT_EQ(b.access_a(), 1);
+    EXPECT_EQ(c.access_a(), 0);
+    EXPECT_FALSE(c.access_b());
+
+    SET_t copy = c;
+    c = a;
+    EXPECT_EQ(c.type, SET_t_enum::A_TYPE);
+    EXPECT_EQ(c.access_a(), 10);
+    EXPECT_EQ(copy.access_c(), std::string(100, 'C'));
+
+    a = std::move(copy);
+    EXPECT_EQ(a.type, SET_t_enum::C_TYPE);
+    EXPECT_EQ(a.access_c(), std::string(100, 'C'));
+
+    // writes into the value of the other representation are not kept
+    b.access_c() = "X";
+    EXPECT_EQ(b.access_c(), "");
+}
+
 TEST(context_macro_param, param_data)
 {
     hlasm_context ctx;
@@ -312,7 +427,7 @@ TEST(context_macro, call_and_leave_macro)
     ASSERT_TRUE(ctx.is_in_macro());
     ASSERT_TRUE(ctx.this_macro() == m2);
 
-    auto SYSLIST = m2->named_params.find(ctx.ids().add("SYSLIST"))->second->access_system_variable();
+    auto SYSLIST = m2->find_param(ctx.ids().add("SYSLIST"))->access_system_variable();
     ASSERT_TRUE(SYSLIST);
     // testing syslist
     EXPECT_EQ(SYSLIST->get_value((size_t)0), "");
@@ -321,9 +436,9 @@ TEST(context_macro, call_and_leave_macro)
     EXPECT_EQ(SYSLIST->get_value((size_t)3), "");
 
     // testing named params
-    EXPECT_EQ(m2->named_params.find(op1)->second->get_value(), "ada");
-    EXPECT_EQ(m2->named_params.find(op3)->second->get_value(), "");
-    EXPECT_EQ(m2->named_params.find(key)->second->get_value(), "");
+    EXPECT_EQ(m2->find_param(op1)->get_value(), "ada");
+    EXPECT_EQ(m2->find_param(op3)->get_value(), "");
+    EXPECT_EQ(m2->find_param(key)->get_value(), "");
 
     ctx.leave_macro();
 
@@ -372,7 +487,7 @@ TEST(context_macro, repeat_call_same_macro)
     // call->|lbl		MAC		ada,mko,
     auto m2 = ctx.enter_macro(idx, move(lb), move(params));
 
-    EXPECT_EQ(m2->named_params.find(lbl)->second->get_value(), "lbl");
+    EXPECT_EQ(m2->find_param(lbl)->get_value(), "lbl");
 
     // leaving macro
     ctx.leave_macro();
@@ -404,7 +519,7 @@ TEST(context_macro, repeat_call_same_macro)
 
     ASSERT_TRUE(m2 != m3);
 
-    auto SYSLIST = m3->named_params.find(ctx.ids().add("SYSLIST"))->second->access_system_variable();
+    auto SYSLIST = m3->find_param(ctx.ids().add("SYSLIST"))->access_system_variable();
     ASSERT_TRUE(SYSLIST);
 
     for (size_t i = 0; i < 3; i++)
@@ -412,10 +527,10 @@ TEST(context_macro, repeat_call_same_macro)
         EXPECT_EQ(SYSLIST->get_value(i), "");
     }
 
-    EXPECT_EQ(m3->named_params.find(lbl)->second->get_value(), "");
-    EXPECT_EQ(m3->named_params.find(op1)->second->get_value(), "");
-    EXPECT_EQ(m3->named_params.find(op3)->second->get_value(), "(first,second,third)");
-    EXPECT_EQ(m3->named_params.find(key)->second->get_value(), "cas");
+    EXPECT_EQ(m3->find_param(lbl)->get_value(), "");
+    EXPECT_EQ(m3->find_param(op1)->get_value(), "");
+    EXPECT_EQ(m3->find_param(op3)->get_value(), "(first,second,third)");
+    EXPECT_EQ(m3->find_param(key)->get_value(), "cas");
 
     EXPECT_EQ(SYSLIST->get_value({ 2, 3 }), "");
     EXPECT_EQ(SYSLIST->get_value(3), "(first,second,third)");
@@ -503,9 +618,9 @@ TEST(context_macro, recurr_call)
     ASSERT_TRUE(ctx.is_in_macro());
     ASSERT_FALSE(m2 == m3);
 
-    auto SYSLIST2 = m2->named_params.find(ctx.ids().add("SYSLIST"))->second->access_system_variable();
+    auto SYSLIST2 = m2->find_param(ctx.ids().add("SYSLIST"))->access_system_variable();
     ASSERT_TRUE(SYSLIST2);
-    auto SYSLIST3 = m3->named_params.find(ctx.ids().add("SYSLIST"))->second->access_system_variable();
+    auto SYSLIST3 = m3->find_param(ctx.ids().add("SYSLIST"))->access_system_variable();
     ASSERT_TRUE(SYSLIST3);
 
     for (size_t i = 0; i < 2; i++)
@@ -514,10 +629,10 @@ TEST(context_macro, recurr_call)
     }
 
     // testing inner macro
-    EXPECT_EQ(m3->named_params.find(lbl)->second->get_value(), "");
-    EXPECT_EQ(m3->named_params.find(op1)->second->get_value(), "");
-    EXPECT_EQ(m3->named_params.find(op3)->second->get_value(), "(first,second,third)");
-    EXPECT_EQ(m3->named_params.find(key)->second->get_value(), "cas");
+    EXPECT_EQ(m3->find_param(lbl)->get_value(), "");
+    EXPECT_EQ(m3->find_param(op1)->get_value(), "");
+    EXPECT_EQ(m3->find_param(op3)->get_value(), "(first,second,third)");
+    EXPECT_EQ(m3->find_param(key)->get_value(), "cas");
 
     EXPECT_EQ(SYSLIST3->get_value(0), "");
     EXPECT_EQ(SYSLIST3->get_value({ 2, 3 }), "");
@@ -532,9 +647,9 @@ TEST(context_macro, recurr_call)
     EXPECT_EQ(SYSLIST2->get_value((size_t)2), "mko");
     EXPECT_EQ(SYSLIST2->get_value((size_t)3), "");
 
-    EXPECT_EQ(m2->named_params.find(op1)->second->get_value(), "ada");
-    EXPECT_EQ(m2->named_params.find(op3)->second->get_value(), "");
-    EXPECT_EQ(m2->named_params.find(key)->second->get_value(), "");
+    EXPECT_EQ(m2->find_param(op1)->get_value(), "ada");
+    EXPECT_EQ(m2->find_param(op3)->get_value(), "");
+    EXPECT_EQ(m2->find_param(key)->get_value(), "");
 
 
     ctx.leave_macro();
@@ -624,3 +739,43 @@ TEST(context_system_variables, SYSNEST_SYSMAC)
                   ->get_value(),
         "M1");
 }
+
+TEST(context_system_variables, values_at_macro_entry)
+{
+    hlasm_context ctx;
+
+    auto idx = ctx.ids().add("mac");
+    auto op = ctx.ids().add("op");
+
+    vector<macro_arg> args;
+    args.push_back({ nullptr, op });
+    ctx.add_macro(idx, nullptr, move(args), {}, {}, {}, {});
+
+    ctx.ord_ctx.set_section(ctx.ids().add("SECT"), section_kind::EXECUTABLE, location());
+
+    vector<macro_arg> params;
+    params.push_back({ make_unique<macro_param_data_single>("val") });
+    ctx.enter_macro(idx, nullptr, move(params));
+
+    // the system variables are first accessed after the section changes
+    ctx.ord_ctx.set_section(ctx.ids().add("OTHER"), section_kind::DUMMY, location());
+
+    auto value = [&ctx](const char* name) {
+        return ctx.get_var_sym(ctx.ids().add(name))->access_set_symbol_base()->access_set_symbol<C_t>()->get_value();
+    };
+    EXPECT_EQ(value("SYSECT"), "SECT");
+    EXPECT_EQ(value("SYSSTYP"), "CSECT");
+    EXPECT_EQ(value("SYSNDX"), "0000");
+    EXPECT_EQ(ctx.get_var_sym(ctx.ids().add("SYSNEST"))
+                  ->access_set_symbol_base()
+                  ->access_set_symbol<A_t>()
+                  ->get_value(),
+        1);
+
+    auto param = ctx.get_var_sym(op);
+    ctx.leave_macro();
+
+    // the parameter keeps its invocation alive
+    ASSERT_TRUE(param);
+    EXPECT_EQ(param->access_macro_param_base()->get_value(), "val");
+}
@@ -364,8 +364,8 @@ TEST(macro, macro_name_param_repetition)
             std::make_unique<macro_param_data_single>("1"), std::move(args), a.hlasm_ctx().ids().add("SYSLIST"));
         auto n = a.hlasm_ctx().ids().add("n");
         auto b = a.hlasm_ctx().ids().add("b");
-        EXPECT_EQ(invo->named_params.find(n)->second->get_value(), "1");
-        EXPECT_EQ(invo->named_params.find(b)->second->get_value(), "3");
+        EXPECT_EQ(invo->find_param(n)->get_value(), "1");
+        EXPECT_EQ(invo->find_param(b)->get_value(), "3");
     }
 
     {
@@ -375,9 +375,9 @@ TEST(macro, macro_name_param_repetition)
         auto invo = m2->call(nullptr, std::move(args), a.hlasm_ctx().ids().add("SYSLIST"));
         auto n = a.hlasm_ctx().ids().add("a");
         auto b = a.hlasm_ctx().ids().add("b");
-        EXPECT_EQ(invo->named_params.find(n)->second->get_value(), "1");
-        EXPECT_EQ(invo->named_params.find(b)->second->get_value(), "2");
-        EXPECT_EQ(invo->named_params.find(a.hlasm_ctx().ids().add("SYSLIST"))->second->get_value(1), "1");
+        EXPECT_EQ(invo->find_param(n)->get_value(), "1");
+        EXPECT_EQ(invo->find_param(b)->get_value(), "2");
+        EXPECT_EQ(invo->find_param(a.hlasm_ctx().ids().add("SYSLIST"))->get_value(1), "1");
     }
 
     {
@@ -388,8 +388,8 @@ TEST(macro, macro_name_param_repetition)
         auto invo = m3->call(nullptr, std::move(args), a.hlasm_ctx().ids().add("SYSLIST"));
         auto n = a.hlasm_ctx().ids().add("a");
         auto b = a.hlasm_ctx().ids().add("b");
-        EXPECT_EQ(invo->named_params.find(n)->second->access_keyword_param()->get_value(), "5");
-        EXPECT_EQ(invo->named_params.find(b)->second->get_value(), "2");
+        EXPECT_EQ(invo->find_param(n)->access_keyword_param()->get_value(), "5");
+        EXPECT_EQ(invo->find_param(b)->get_value(), "2");
     }
 }
 
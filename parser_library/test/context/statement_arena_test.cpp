@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "context/statement_arena.h"
+
+using namespace hlasm_plugin::parser_library::context;
+
+namespace {
+struct arena_object
+{
+    static void* operator new(size_t size) { return statement_arena::allocate_object(size, nullptr); }
+    static void* operator new(size_t size, statement_arena* arena)
+    {
+        return statement_arena::allocate_object(size, arena);
+    }
+    static void operator delete(void* p) noexcept { statement_arena::release_object(p); }
+    static void operator delete(void* p, statement_arena*) noexcept { statement_arena::release_object(p); }
+
+    explicit arena_object(std::string value, int* destroyed = nullptr)
+        : value(std::move(value))
+        , destroyed(destroyed)
+    {}
+    ~arena_object()
+    {
+        if (destroyed)
+            ++*destroyed;
+    }
+
+    std::string value;
+    int* destroyed;
+};
+} // namespace
+
+TEST(statement_arena, blocks_aligned)
+{
+    statement_arena arena;
+
+    std::vector<void*> blocks;
+    for (size_t size : { 1, 100, 1000, 5000, 100000, 8 })
+    {
+        auto p = arena.allocate(size);
+        ASSERT_TRUE(p);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % alignof(std::max_align_t), (uintptr_t)0);
+        std::memset(p, 0, size);
+        blocks.push_back(p);
+    }
+    EXPECT_EQ(std::unique(blocks.begin(), blocks.end()), blocks.end());
+}
+
+TEST(statement_arena, exhausted)
+{
+    statement_arena arena;
+    while (!arena.exhausted())
+        arena.allocate(statement_arena::capacity / 16);
+
+    // the objects are taken from the heap
+    auto object = make_arena_unique<arena_object>(&arena, "heap");
+    EXPECT_EQ(object->value, "heap");
+}
+
+TEST(statement_arena, objects_destroyed_before_arena)
+{
+    int destroyed = 0;
+    auto heap_object = make_arena_unique<arena_object>(nullptr, "heap", &destroyed);
+    {
+        statement_arena arena;
+        std::vector<std::unique_ptr<arena_object>> objects;
+        for (int i = 0; i < 1000; ++i)
+            objects.push_back(make_arena_unique<arena_object>(&arena, std::to_string(i), &destroyed));
+        // the object created without the arena comes from the heap
+        objects.push_back(std::move(heap_object));
+
+        EXPECT_EQ(objects[999]->value, "999");
+        objects.erase(objects.begin(), objects.begin() + 500);
+        EXPECT_EQ(destroyed, 500);
+        EXPECT_EQ(objects.back()->value, "heap");
+    }
+    // the remaining ones are destroyed while the arena still exists
+    EXPECT_EQ(destroyed, 1001);
+}
+
+TEST(statement_arena, shared_objects)
+{
+    auto arena = std::make_shared<statement_arena>();
+    std::weak_ptr<statement_arena> arena_alive = arena;
+
+    std::vector<std::shared_ptr<std::string>> strings;
+    for (int i = 0; i < 1000; ++i)
+        strings.push_back(make_arena_shared<std::string>(arena, std::to_string(i)));
+    strings.push_back(make_arena_shared<std::string>(nullptr, "heap"));
+
+    // the objects keep the arena alive
+    arena.reset();
+    EXPECT_FALSE(arena_alive.expired());
+    EXPECT_EQ(*strings[999], "999");
+    EXPECT_EQ(*strings[1000], "heap");
+
+    strings.erase(strings.begin(), strings.begin() + 999);
+    EXPECT_FALSE(arena_alive.expired());
+    strings.clear();
+    EXPECT_TRUE(arena_alive.expired());
+}
@@ -169,3 +169,59 @@ TEST_P(ca_op, test)
     else
         FAIL();
 }
+
+TEST(ca_op_folding, constant_operands)
+{
+    lib_prov_mock lib;
+    evaluation_context eval_ctx {
+        analyzing_context { std::make_shared<context::hlasm_context>(), std::make_shared<lsp::lsp_context>() }, lib
+    };
+
+    // 1+2*3
+    ca_expr_ptr op = std::make_unique<ca_basic_binary_operator<ca_add>>(std::make_unique<ca_constant>(1, range()),
+        std::make_unique<ca_basic_binary_operator<ca_mul>>(
+            std::make_unique<ca_constant>(2, range()), std::make_unique<ca_constant>(3, range()), range()),
+        range());
+    op->resolve_expression_tree(SET_t_enum::A_TYPE);
+
+    ASSERT_TRUE(op->constant_value());
+    EXPECT_EQ(*op->constant_value(), 7);
+    EXPECT_EQ(op->evaluate<A_t>(eval_ctx), 7);
+
+    // (1+6) GT 5
+    ca_expr_ptr rel = std::make_unique<ca_function_binary_operator>(
+        std::make_unique<ca_par_operator>(
+            std::make_unique<ca_basic_binary_operator<ca_add>>(
+                std::make_unique<ca_constant>(1, range()), std::make_unique<ca_constant>(6, range()), range()),
+            range()),
+        std::make_unique<ca_constant>(5, range()),
+        ca_expr_ops::GT,
+        SET_t_enum::B_TYPE,
+        range());
+    rel->resolve_expression_tree(SET_t_enum::B_TYPE);
+
+    ASSERT_TRUE(rel->constant_value());
+    EXPECT_EQ(*rel->constant_value(), 1);
+    EXPECT_TRUE(rel->evaluate<B_t>(eval_ctx));
+    EXPECT_EQ(rel->evaluate(eval_ctx).type, SET_t_enum::B_TYPE);
+
+    EXPECT_EQ(eval_ctx.diags().size(), 0U);
+}
+
+TEST(ca_op_folding, overflow)
+{
+    lib_prov_mock lib;
+    evaluation_context eval_ctx {
+        analyzing_context { std::make_shared<context::hlasm_context>(), std::make_shared<lsp::lsp_context>() }, lib
+    };
+
+    ca_expr_ptr op = std::make_unique<ca_basic_binary_operator<ca_mul>>(
+        std::make_unique<ca_constant>(2147483647, range()), std::make_unique<ca_constant>(2, range()), range());
+    op->resolve_expression_tree(SET_t_enum::A_TYPE);
+
+    // the overflow is reported each time the expression is evaluated
+    EXPECT_FALSE(op->constant_value());
+    EXPECT_EQ(op->evaluate<A_t>(eval_ctx), 0);
+    ASSERT_EQ(eval_ctx.diags().size(), 1U);
+    EXPECT_EQ(eval_ctx.diags().front().code, "CE013");
+}
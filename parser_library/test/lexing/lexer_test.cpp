@@ -21,6 +21,7 @@
 #include "hlasmparser.h"
 #include "lexing/input_source.h"
 #include "lexing/lexer.h"
+#include "lexing/token.h"
 #include "lexing/token_stream.h"
 
 using namespace hlasm_plugin::parser_library;
@@ -266,3 +267,19 @@ TEST(lexer_test, attribute_in_continuation)
     ASSERT_EQ(l.nextToken()->getType(), lexing::lexer::ATTR);
     ASSERT_EQ(l.nextToken()->getType(), lexing::lexer::ORDSYMBOL);
 }
+
+TEST(lexer_test, token_length_in_characters)
+{
+    // comment with characters encoded in 2 and 4 bytes
+    std::string in = "*\xC4\x80\xF0\x90\x80\x80X";
+
+    semantics::source_info_processor src_proc(false);
+    lexing::input_source input(in);
+    lexing::lexer l(&input, &src_proc);
+
+    auto comment = l.nextToken();
+    ASSERT_EQ(comment->getType(), lexing::lexer::COMMENT);
+    EXPECT_EQ(comment->getStartIndex(), (size_t)0);
+    EXPECT_EQ(comment->getStopIndex(), (size_t)7);
+    EXPECT_EQ(dynamic_cast<lexing::token&>(*comment).get_char_length(), (size_t)4);
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "gtest/gtest.h"
+
+#include "lexing/logical_lines.h"
+
+using namespace hlasm_plugin::parser_library::lexing;
+
+TEST(logical_lines, split)
+{
+    std::string continued = std::string(71, ' ') + "X";
+    std::string input = " LR 1,1\n" + continued + "\n" + continued + "\r\n           3\n\n LR 2,2";
+    logical_lines lines(input, source_format());
+
+    ASSERT_EQ(lines.lines().size(), (size_t)6);
+    EXPECT_EQ(lines.lines()[0].offset, (size_t)0);
+    EXPECT_EQ(lines.lines()[0].length, (size_t)7);
+    EXPECT_EQ(lines.lines()[2].length, (size_t)73);
+    EXPECT_EQ(lines.lines()[3].offset, input.find("\r\n") + 2);
+    EXPECT_EQ(lines.lines()[4].length, (size_t)0);
+    EXPECT_EQ(lines.lines()[5].offset, input.rfind(" LR"));
+
+    ASSERT_EQ(lines.statements().size(), (size_t)4);
+    EXPECT_EQ(lines.statements()[0].first, (size_t)0);
+    EXPECT_EQ(lines.statements()[0].count, (size_t)1);
+    EXPECT_EQ(lines.statements()[1].first, (size_t)1);
+    EXPECT_EQ(lines.statements()[1].count, (size_t)3);
+    EXPECT_EQ(lines.statements()[2].first, (size_t)4);
+    EXPECT_EQ(lines.statements()[3].first, (size_t)5);
+
+    source_format format;
+    format.continuation_enabled = false;
+    EXPECT_EQ(logical_lines(input, format).statements().size(), (size_t)6);
+
+    EXPECT_TRUE(logical_lines(" LR 1,1\r", source_format()).statements().empty());
+}
+
+TEST(logical_lines, text_scan)
+{
+    // one character of 2 bytes and one of 4 bytes
+    const std::string line = "ABCDEFGHIJ\xC3\x81KLMNOPQRSTUVWXYZ\xF0\x9F\x98\x80!";
+
+    EXPECT_EQ(text_scan::column_offset(line, 10), (size_t)10);
+    EXPECT_EQ(text_scan::column_offset(line, 11), (size_t)12);
+    EXPECT_EQ(text_scan::column_offset(line, 28), (size_t)32);
+    EXPECT_EQ(text_scan::column_offset(line, 100), line.size());
+
+    EXPECT_EQ(text_scan::characters(line), (size_t)29);
+    EXPECT_EQ(text_scan::utf16_units(line), (size_t)30);
+    EXPECT_EQ(text_scan::characters(std::string(100, 'A')), (size_t)100);
+
+    EXPECT_TRUE(text_scan::ascii(std::string(100, 'A')));
+    EXPECT_FALSE(text_scan::ascii(line));
+    EXPECT_FALSE(text_scan::ascii(std::string(100, 'A') + "\xC3\x81"));
+
+    EXPECT_EQ(text_scan::find_new_line("AB\nC", 0), (size_t)2);
+    EXPECT_EQ(text_scan::find_new_line("AB\nC", 3), (size_t)4);
+}
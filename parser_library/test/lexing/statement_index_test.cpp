@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "gtest/gtest.h"
+
+#include "lexing/statement_index.h"
+
+using namespace hlasm_plugin::parser_library;
+using namespace hlasm_plugin::parser_library::lexing;
+
+namespace {
+// pads the line with spaces up to the column and appends the character
+std::string padded(std::string line, size_t column, char c)
+{
+    line.resize(column, ' ');
+    return line + c;
+}
+} // namespace
+
+TEST(statement_index, fields)
+{
+    context::id_storage ids;
+    std::string input = R"(LABEL LR 1,1
+ copy MEMBER
+.SEQ ANOP
+* comment
+.* macro comment
+
+ &VAR
+ L'X
+ MVC   0(1,2),3(4)    remark
+)";
+    statement_index index(input, source_format(), ids);
+    const auto& stmts = index.statements();
+    ASSERT_EQ(stmts.size(), (size_t)9);
+
+    for (size_t i = 0; i < stmts.size(); ++i)
+        EXPECT_EQ(stmts[i].line, i);
+
+    EXPECT_TRUE(stmts[0].has_label);
+    EXPECT_FALSE(stmts[1].has_label);
+    EXPECT_EQ(stmts[1].instruction, ids.add("COPY"));
+    EXPECT_EQ(stmts[1].offset, input.find(" copy"));
+    EXPECT_TRUE(stmts[2].has_label);
+    for (size_t i : { 3, 4, 5 })
+    {
+        EXPECT_FALSE(stmts[i].has_label);
+        EXPECT_EQ(stmts[i].instruction, context::id_storage::empty_id);
+    }
+    EXPECT_EQ(stmts[6].instruction, nullptr);
+    EXPECT_EQ(stmts[7].instruction, nullptr);
+    EXPECT_EQ(stmts[8].instruction, ids.add("MVC"));
+
+    EXPECT_EQ(index.find(input.find(".SEQ")), (size_t)2);
+    EXPECT_EQ(index.find(input.find(".SEQ") + 1), stmts.size());
+}
+
+TEST(statement_index, continuation)
+{
+    context::id_storage ids;
+    std::string input = padded(" MVC   0(1,2),", 71, 'X') + "\n" //
+        + "               3(4)\n" //
+        + padded("* comment", 71, 'X') + "\n" //
+        + "                continued comment\n" //
+        + padded(" LR 1,1", 71, ' ') + "\n" //
+        + " LR 1,1\r\n" //
+        + " LR 1,1";
+    statement_index index(input, source_format(), ids);
+    const auto& stmts = index.statements();
+    ASSERT_EQ(stmts.size(), (size_t)5);
+
+    EXPECT_EQ(stmts[0].line, (size_t)0);
+    EXPECT_EQ(stmts[1].line, (size_t)2);
+    EXPECT_EQ(stmts[2].line, (size_t)4);
+    EXPECT_EQ(stmts[3].line, (size_t)5);
+    EXPECT_EQ(stmts[4].line, (size_t)6);
+    EXPECT_EQ(stmts[4].offset, input.rfind(" LR"));
+    EXPECT_EQ(stmts[3].instruction, ids.add("LR"));
+
+    // instruction field reaching the continuation column
+    input = padded(" " + std::string(69, 'A'), 71, 'X') + "\n" + std::string(15, ' ') + "B";
+    statement_index long_instruction(input, source_format(), ids);
+    ASSERT_EQ(long_instruction.statements().size(), (size_t)1);
+    EXPECT_EQ(long_instruction.statements()[0].instruction, nullptr);
+}
+
+TEST(statement_index, format)
+{
+    context::id_storage ids;
+    std::string input = "ABLABEL LR 1,1\n" + padded("XY LR 2,2", 31, 'X') + "\n" + "XXX   3,3\n";
+    source_format format;
+    format.begin = 2;
+    format.end = 31;
+    format.continuation = 5;
+    statement_index index(input, format, ids);
+    const auto& stmts = index.statements();
+    ASSERT_EQ(stmts.size(), (size_t)2);
+
+    EXPECT_TRUE(stmts[0].has_label);
+    EXPECT_FALSE(stmts[1].has_label);
+    EXPECT_EQ(stmts[1].instruction, ids.add("LR"));
+    EXPECT_EQ(stmts[1].line, (size_t)1);
+
+    format.continuation_enabled = false;
+    EXPECT_EQ(statement_index(input, format, ids).statements().size(), (size_t)3);
+}
+
+TEST(statement_index, unreliable_text)
+{
+    context::id_storage ids;
+
+    EXPECT_TRUE(statement_index(" LR 1,1\r LR 1,1\n", source_format(), ids).statements().empty());
+
+    // non-ascii character in the continuation column
+    std::string input = padded(" LR 1,1", 71, '\xC3') + "\x81\n LR 1,1";
+    EXPECT_TRUE(statement_index(input, source_format(), ids).statements().empty());
+
+    // but it is counted as a single column anywhere else
+    input = " LR 1,1 \xC3\x81" + std::string(62, ' ') + "X\n" + std::string(15, ' ') + "2\n LR 1,1";
+    statement_index index(input, source_format(), ids);
+    ASSERT_EQ(index.statements().size(), (size_t)2);
+    EXPECT_EQ(index.statements()[1].line, (size_t)2);
+}
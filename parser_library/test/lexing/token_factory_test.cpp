@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "lexing/token.h"
+#include "lexing/token_factory.h"
+
+using namespace hlasm_plugin::parser_library::lexing;
+
+namespace {
+std::vector<std::unique_ptr<token>> create_statement(token_factory& factory, size_t count, size_t line)
+{
+    std::vector<std::unique_ptr<token>> tokens;
+    for (size_t i = 0; i < count; ++i)
+        tokens.push_back(factory.create(nullptr, nullptr, i + 1, 0, i, i, line, i, i, i, i + 1, 1));
+    return tokens;
+}
+
+std::vector<const token*> addresses(const std::vector<std::unique_ptr<token>>& tokens)
+{
+    std::vector<const token*> result;
+    for (const auto& t : tokens)
+        result.push_back(t.get());
+    std::sort(result.begin(), result.end());
+    return result;
+}
+} // namespace
+
+TEST(token_pool, slot_reused)
+{
+    token_pool pool;
+
+    void* first = pool.allocate();
+    void* second = pool.allocate();
+    EXPECT_NE(first, second);
+
+    token_pool::release(first);
+    EXPECT_EQ(pool.allocate(), first);
+
+    token_pool::release(first);
+    token_pool::release(second);
+}
+
+TEST(token_factory, tokens_reused_across_statements)
+{
+    token_factory factory;
+
+    auto statement = create_statement(factory, 20, 0);
+    const auto first_addresses = addresses(statement);
+    EXPECT_EQ(std::adjacent_find(first_addresses.begin(), first_addresses.end()), first_addresses.end());
+
+    // the tokens of the following statements occupy the slots released by the previous one
+    for (size_t line = 1; line < 5; ++line)
+    {
+        statement.clear();
+        statement = create_statement(factory, 20, line);
+        EXPECT_EQ(addresses(statement), first_addresses);
+    }
+
+    for (size_t i = 0; i < statement.size(); ++i)
+    {
+        EXPECT_EQ(statement[i]->getType(), i + 1);
+        EXPECT_EQ(statement[i]->getLine(), (size_t)4);
+        EXPECT_EQ(statement[i]->getStartIndex(), i);
+        EXPECT_EQ(statement[i]->get_end_of_token_in_line_utf16(), i + 1);
+        EXPECT_EQ(statement[i]->get_char_length(), (size_t)1);
+    }
+}
+
+TEST(token_factory, statements_spanning_chunks)
+{
+    token_factory factory;
+
+    // more tokens than fit into a single chunk of the pool
+    auto large = create_statement(factory, 3000, 0);
+    const auto large_addresses = addresses(large);
+    EXPECT_EQ(std::adjacent_find(large_addresses.begin(), large_addresses.end()), large_addresses.end());
+    large.clear();
+
+    auto small = create_statement(factory, 10, 1);
+    for (const auto* t : addresses(small))
+        EXPECT_TRUE(std::binary_search(large_addresses.begin(), large_addresses.end(), t));
+}
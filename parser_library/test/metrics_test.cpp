@@ -151,6 +151,31 @@ TEST_F(benchmark_test, reparsed_statements)
 TEST_F(benchmark_test, lookahead_statements)
 {
     setUpAnalyzer(" AGO .HERE\n something\n something\n.HERE ANOP");
-    // 2 lines skipped by lookahead + 1 which finds the symbol
+    // the 2 statements without a label are skipped before parsing, only the one which finds the symbol is processed
+    EXPECT_EQ(a->get_metrics().lookahead_statements, (size_t)1);
+
+    // highlighting needs all the statements parsed
+    a = std::make_unique<analyzer>(
+        " AGO .HERE\n something\n something\n.HERE ANOP", SOURCE_FILE, lib_provider, true);
+    a->analyze();
     EXPECT_EQ(a->get_metrics().lookahead_statements, (size_t)3);
 }
+
+TEST_F(benchmark_test, ll_fallback_statements)
+{
+    const std::string input = " LR 1,2\n DC F'1'\n LR 1,(\n";
+
+    setUpAnalyzer(input);
+    // only the operand field with the syntax error is parsed again
+    EXPECT_EQ(a->get_metrics().ll_fallback_statements, (size_t)1);
+    a->collect_diags();
+    const auto diag_count = a->diags().size();
+    EXPECT_GT(diag_count, (size_t)0);
+
+    a = std::make_unique<analyzer>(input, SOURCE_FILE, lib_provider);
+    a->set_two_stage_prediction(false);
+    a->analyze();
+    a->collect_diags();
+    EXPECT_EQ(a->get_metrics().ll_fallback_statements, (size_t)0);
+    EXPECT_EQ(a->diags().size(), diag_count);
+}
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include <sstream>
+#include <typeinfo>
+
+#include "gtest/gtest.h"
+
+#include "../expressions/expr_mocks.h"
+#include "../gtest_stringers.h"
+#include "expressions/mach_expr_term.h"
+#include "expressions/mach_operator.h"
+#include "parsing/mach_operand_parser.h"
+#include "processing/statement.h"
+#include "processing/statement_analyzers/statement_analyzer.h"
+#include "semantics/operand_impls.h"
+
+using namespace hlasm_plugin::parser_library;
+using namespace hlasm_plugin::parser_library::expressions;
+using namespace hlasm_plugin::parser_library::parsing;
+using namespace hlasm_plugin::parser_library::semantics;
+
+namespace {
+struct mach_parser_fixture
+{
+    context::id_storage ids;
+    range_provider provider;
+
+    std::optional<mach_operand_field> parse(std::string_view text, position start = position(0, 7))
+    {
+        return mach_operand_parser(ids, provider, nullptr).parse(text, start);
+    }
+};
+
+const address_machine_operand* address(const operand_ptr& op)
+{
+    return op->access_mach() ? op->access_mach()->access_address() : nullptr;
+}
+
+void describe(std::ostream& out, const mach_expression* expr)
+{
+    if (expr)
+        out << ' ' << typeid(*expr).name() << ' ' << expr->get_range();
+    else
+        out << " -";
+}
+
+// analyzes the source and describes the operands of its statements, the highlighting and the diagnostics
+struct operand_field_description : public processing::statement_analyzer
+{
+    std::vector<std::string> statements;
+    std::vector<token_info> hl_symbols;
+    std::vector<std::string> diags;
+
+    operand_field_description(const std::string& text, bool use_parser)
+    {
+        analyzer a(text, "", workspaces::empty_parse_lib_provider::instance, true);
+        a.set_mach_operand_parser(use_parser);
+        a.register_stmt_analyzer(this);
+        a.analyze();
+        a.collect_diags();
+
+        hl_symbols = a.source_processor().semantic_tokens();
+        for (const auto& d : a.diags())
+        {
+            std::ostringstream out;
+            out << d.code << ' ' << d.diag_range;
+            diags.push_back(out.str());
+        }
+    }
+
+    void analyze(const context::hlasm_statement& statement,
+        processing::statement_provider_kind,
+        processing::processing_kind) override
+    {
+        auto resolved = statement.access_resolved();
+        if (!resolved)
+            return;
+
+        std::ostringstream out;
+        out << resolved->operands_ref().field_range << " remarks " << resolved->remarks_ref().field_range;
+        for (const auto& op : resolved->operands_ref().value)
+        {
+            out << "\n" << (int)op->type << ' ' << op->operand_range;
+            if (auto expr = dynamic_cast<const expr_machine_operand*>(op.get()))
+                describe(out, expr->expression.get());
+            else if (auto addr = dynamic_cast<const address_machine_operand*>(op.get()))
+            {
+                out << " state " << (int)addr->state;
+                describe(out, addr->displacement.get());
+                describe(out, addr->first_par.get());
+                describe(out, addr->second_par.get());
+            }
+        }
+        statements.push_back(out.str());
+    }
+};
+} // namespace
+
+TEST(mach_operand_parser, simple_operands)
+{
+    mach_parser_fixture f;
+    auto field = f.parse(" 1,LABEL");
+    ASSERT_TRUE(field);
+
+    ASSERT_EQ(field->operands.size(), (size_t)2);
+    auto first = field->operands[0]->access_mach()->access_expr();
+    ASSERT_TRUE(first);
+    EXPECT_TRUE(dynamic_cast<mach_expr_constant*>(first->expression.get()));
+    EXPECT_EQ(first->operand_range, range(position(0, 8), position(0, 9)));
+
+    auto second = field->operands[1]->access_mach()->access_expr();
+    ASSERT_TRUE(second);
+    auto symbol = dynamic_cast<mach_expr_symbol*>(second->expression.get());
+    ASSERT_TRUE(symbol);
+    EXPECT_EQ(*symbol->value, "LABEL");
+    EXPECT_EQ(second->operand_range, range(position(0, 10), position(0, 15)));
+
+    EXPECT_TRUE(field->remarks.empty());
+    EXPECT_EQ(field->field_range, range(position(0, 8), position(0, 15)));
+
+    ASSERT_EQ(field->hl_symbols.size(), (size_t)3);
+    EXPECT_EQ(field->hl_symbols[0].scope, hl_scopes::number);
+    EXPECT_EQ(field->hl_symbols[1].scope, hl_scopes::operator_symbol);
+    EXPECT_EQ(field->hl_symbols[2].scope, hl_scopes::ordinary_symbol);
+}
+
+TEST(mach_operand_parser, address_operands)
+{
+    mach_parser_fixture f;
+    auto field = f.parse(" 0(4,5),4(,12),8(3,),A(B)");
+    ASSERT_TRUE(field);
+    ASSERT_EQ(field->operands.size(), (size_t)4);
+
+    const checking::operand_state states[] = {
+        checking::operand_state::PRESENT,
+        checking::operand_state::FIRST_OMITTED,
+        checking::operand_state::SECOND_OMITTED,
+        checking::operand_state::ONE_OP,
+    };
+    for (size_t i = 0; i < 4; ++i)
+    {
+        auto op = address(field->operands[i]);
+        ASSERT_TRUE(op);
+        EXPECT_EQ(op->state, states[i]);
+        EXPECT_TRUE(op->displacement);
+    }
+
+    EXPECT_TRUE(address(field->operands[0])->first_par && address(field->operands[0])->second_par);
+    EXPECT_TRUE(!address(field->operands[1])->first_par && address(field->operands[1])->second_par);
+    EXPECT_TRUE(address(field->operands[2])->first_par && !address(field->operands[2])->second_par);
+    EXPECT_TRUE(!address(field->operands[3])->first_par && address(field->operands[3])->second_par);
+
+    EXPECT_EQ(field->operands[0]->operand_range, range(position(0, 8), position(0, 14)));
+    EXPECT_EQ(field->operands[3]->operand_range, range(position(0, 28), position(0, 32)));
+}
+
+TEST(mach_operand_parser, expressions)
+{
+    mach_parser_fixture f;
+    auto field = f.parse(" 2*(3-1)+4,-1,10/3*3,A-*");
+    ASSERT_TRUE(field);
+    ASSERT_EQ(field->operands.size(), (size_t)4);
+
+    auto expr = [&field](size_t i) { return field->operands[i]->access_mach()->access_expr()->expression.get(); };
+    dep_sol_mock solver;
+
+    EXPECT_TRUE(dynamic_cast<mach_expr_binary<add>*>(expr(0)));
+    EXPECT_EQ(expr(0)->get_range(), range(position(0, 8), position(0, 17)));
+    EXPECT_EQ(expr(0)->evaluate(solver).get_abs(), 8);
+
+    EXPECT_TRUE(dynamic_cast<mach_expr_unary<sub>*>(expr(1)));
+    EXPECT_EQ(expr(1)->get_range(), range(position(0, 18), position(0, 20)));
+    EXPECT_EQ(expr(1)->evaluate(solver).get_abs(), -1);
+
+    EXPECT_TRUE(dynamic_cast<mach_expr_binary<mul>*>(expr(2)));
+    EXPECT_EQ(expr(2)->get_range(), range(position(0, 21), position(0, 27)));
+    EXPECT_EQ(expr(2)->evaluate(solver).get_abs(), 9);
+
+    EXPECT_TRUE(dynamic_cast<mach_expr_binary<sub>*>(expr(3)));
+    EXPECT_EQ(field->hl_symbols.back(), token_info(range(position(0, 30), position(0, 31)), hl_scopes::operand));
+}
+
+TEST(mach_operand_parser, empty_operands)
+{
+    mach_parser_fixture f;
+    auto field = f.parse(" 1,,2,");
+    ASSERT_TRUE(field);
+    ASSERT_EQ(field->operands.size(), (size_t)4);
+
+    EXPECT_EQ(field->operands[1]->type, operand_type::EMPTY);
+    EXPECT_EQ(field->operands[1]->operand_range, range(position(0, 10)));
+    EXPECT_EQ(field->operands[3]->type, operand_type::EMPTY);
+    EXPECT_EQ(field->operands[3]->operand_range, range(position(0, 13)));
+}
+
+TEST(mach_operand_parser, remarks)
+{
+    mach_parser_fixture f;
+
+    auto field = f.parse(" 1,2   load 'A' & (B)");
+    EXPECT_FALSE(field);
+
+    field = f.parse(" 1,2   load 'A', (B)");
+    ASSERT_TRUE(field);
+    ASSERT_EQ(field->remarks.size(), (size_t)1);
+    EXPECT_EQ(field->remarks[0], range(position(0, 14), position(0, 27)));
+    EXPECT_EQ(field->field_range, range(position(0, 8), position(0, 27)));
+
+    // trailing spaces make an empty remark
+    field = f.parse(" 1,2   ");
+    ASSERT_TRUE(field);
+    ASSERT_EQ(field->remarks.size(), (size_t)1);
+    EXPECT_EQ(field->remarks[0], range(position(0, 14)));
+    EXPECT_EQ(field->field_range, range(position(0, 8), position(0, 14)));
+
+    // the space after a comma ends the operands
+    field = f.parse(" 1, 2");
+    ASSERT_TRUE(field);
+    ASSERT_EQ(field->operands.size(), (size_t)2);
+    EXPECT_EQ(field->operands[1]->type, operand_type::EMPTY);
+    ASSERT_EQ(field->remarks.size(), (size_t)1);
+    EXPECT_EQ(field->remarks[0], range(position(0, 11), position(0, 12)));
+}
+
+TEST(mach_operand_parser, continuation)
+{
+    mach_parser_fixture f;
+
+    // the operand field starts at column 14 and the comma is in column 70
+    std::string text = " " + std::string(55, 'A') + ",X" + "00000010\n" + std::string(15, ' ') + "2(3)";
+    auto field = f.parse(text, position(0, 14));
+    ASSERT_TRUE(field);
+    ASSERT_EQ(field->operands.size(), (size_t)2);
+    EXPECT_EQ(field->operands[0]->operand_range, range(position(0, 15), position(0, 70)));
+    EXPECT_EQ(field->operands[1]->operand_range, range(position(1, 15), position(1, 19)));
+    EXPECT_EQ(field->field_range, range(position(0, 15), position(1, 19)));
+
+    // symbol split by the continuation
+    text = " " + std::string(56, 'A') + "X\n" + std::string(15, ' ') + "B";
+    EXPECT_FALSE(f.parse(text, position(0, 14)));
+
+    // space in the continuation column ends the line
+    text = " " + std::string(55, 'A') + ", \n" + std::string(15, ' ') + "B";
+    EXPECT_FALSE(f.parse(text, position(0, 14)));
+}
+
+TEST(mach_operand_parser, substitution_ranges)
+{
+    mach_parser_fixture f;
+    const range field_range(position(3, 15), position(3, 25));
+    f.provider = range_provider(field_range, adjusting_state::SUBSTITUTION);
+
+    auto field = f.parse(" 3,0(4,5)");
+    ASSERT_TRUE(field);
+    for (const auto& op : field->operands)
+        EXPECT_EQ(op->operand_range, field_range);
+    for (const auto& symbol : field->hl_symbols)
+        EXPECT_EQ(symbol.token_range, field_range);
+}
+
+TEST(mach_operand_parser, grammar_needed)
+{
+    mach_parser_fixture f;
+
+    for (std::string_view text : {
+             "",
+             "1,2",
+             "   ",
+             " =F'1'",
+             " X'FF'",
+             " L'A",
+             " Q.A",
+             " &VAR",
+             " 1,A+",
+             " 99999999999",
+             " 1A",
+             " 0(1,2,3)",
+             " (1",
+             " 1)",
+             " A<B",
+             " 1,2\n",
+             " \xC3\x81",
+         })
+        EXPECT_FALSE(f.parse(text)) << text;
+}
+
+TEST(mach_operand_parser, same_as_grammar)
+{
+    // the fields the parser does not handle are left to the grammar in both analyses
+    std::string input = R"(A        EQU   1
+         LR    1,A                  load the value
+         L     1,0(4,5)
+         LA    1,4(,12)
+         LA    1,8(3,)
+         LA    1,*
+         LA    1,*+8
+         L     1,A-*
+         L     1,2*(3-1)+4,-1
+         MVC   0(2,1),A(3)
+         LR    1,
+         LR    1,,2 remark
+         LA    1,X'FF'
+         LA    1,C'A'(2)
+         LA    1,B'101'+1
+         L     1,=F'1'
+         LA    1,=A(*)
+         LA    1,L'A
+         LA    1,A+L'A
+         LA    1,(1
+         LA    1,1)
+         LA    1,0(1,2,3)
+         LA    1,0(1
+         LA    1,A+
+         LA    1,AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA,X
+               0(2,3)
+)";
+
+    operand_field_description grammar(input, false);
+    operand_field_description parser(input, true);
+
+    ASSERT_EQ(parser.statements.size(), grammar.statements.size());
+    for (size_t i = 0; i < grammar.statements.size(); ++i)
+        EXPECT_EQ(parser.statements[i], grammar.statements[i]) << i;
+    EXPECT_EQ(parser.hl_symbols, grammar.hl_symbols);
+    EXPECT_EQ(parser.diags, grammar.diags);
+    EXPECT_FALSE(grammar.diags.empty());
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "gtest/gtest.h"
+
+#include "../expressions/expr_mocks.h"
+#include "expressions/mach_expr_term.h"
+#include "expressions/mach_operator.h"
+#include "parsing/operand_field_cache.h"
+#include "semantics/operand_impls.h"
+
+using namespace hlasm_plugin::parser_library;
+using namespace hlasm_plugin::parser_library::expressions;
+using namespace hlasm_plugin::parser_library::parsing;
+using namespace hlasm_plugin::parser_library::processing;
+using namespace hlasm_plugin::parser_library::semantics;
+
+namespace {
+const range field_range(position(1, 10), position(1, 20));
+
+processing_status mach_status()
+{
+    return processing_status(processing_format(processing_kind::ORDINARY, processing_form::MACH), op_code());
+}
+
+operand_field_cache::parse_result make_fields()
+{
+    operand_list ops;
+    ops.push_back(std::make_unique<expr_machine_operand>(
+        std::make_unique<mach_expr_binary<add>>(std::make_unique<mach_expr_constant>(1, field_range),
+            std::make_unique<mach_expr_location_counter>(field_range),
+            field_range),
+        field_range));
+    ops.push_back(std::make_unique<address_machine_operand>(std::make_unique<mach_expr_constant>(4, field_range),
+        nullptr,
+        std::make_unique<mach_expr_constant>(12, field_range),
+        field_range,
+        checking::operand_state::FIRST_OMITTED));
+    ops.front()->access_mach()->diags().push_back(diagnostic_op::error_ME002(field_range));
+
+    return operand_field_cache::parse_result(
+        operands_si(field_range, std::move(ops)), remarks_si(field_range, { field_range }));
+}
+} // namespace
+
+TEST(operand_field_cache, provides_copies)
+{
+    operand_field_cache cache;
+    auto fields = make_fields();
+    cache.insert("1+*,4(,12)", field_range, mach_status(), fields);
+
+    auto first = cache.find("1+*,4(,12)", field_range, mach_status());
+    auto second = cache.find("1+*,4(,12)", field_range, mach_status());
+    ASSERT_TRUE(first && second);
+
+    auto& ops = first->first.value;
+    ASSERT_EQ(ops.size(), (size_t)2);
+    EXPECT_NE(ops[0].get(), second->first.value[0].get());
+    EXPECT_NE(ops[0].get(), fields.first.value[0].get());
+    EXPECT_EQ(ops[0]->operand_range, field_range);
+    EXPECT_EQ(first->second.value.size(), (size_t)1);
+
+    auto expr = ops[0]->access_mach()->access_expr();
+    ASSERT_TRUE(expr);
+    EXPECT_EQ(expr->diags().size(), (size_t)1);
+    EXPECT_NE(expr->expression.get(), second->first.value[0]->access_mach()->access_expr()->expression.get());
+
+    auto addr = ops[1]->access_mach()->access_address();
+    ASSERT_TRUE(addr);
+    EXPECT_TRUE(addr->displacement);
+    EXPECT_FALSE(addr->first_par);
+    EXPECT_TRUE(addr->second_par);
+    EXPECT_EQ(addr->state, checking::operand_state::FIRST_OMITTED);
+}
+
+TEST(operand_field_cache, constants_keep_their_values)
+{
+    operand_list ops;
+    ops.push_back(
+        std::make_unique<expr_machine_operand>(std::make_unique<mach_expr_constant>(12, field_range), field_range));
+    ops.push_back(std::make_unique<expr_machine_operand>(
+        std::make_unique<mach_expr_self_def>("X", "1F", field_range), field_range));
+    ops.push_back(std::make_unique<expr_machine_operand>(
+        std::make_unique<mach_expr_constant>("99999999999", field_range), field_range));
+    operand_field_cache::parse_result fields(operands_si(field_range, std::move(ops)), remarks_si(field_range, {}));
+
+    operand_field_cache cache;
+    cache.insert("12,X'1F',99999999999", field_range, mach_status(), fields);
+    auto copy = cache.find("12,X'1F',99999999999", field_range, mach_status());
+    ASSERT_TRUE(copy);
+
+    dep_sol_mock solver;
+    auto expression = [&copy](size_t i) {
+        return copy->first.value[i]->access_mach()->access_expr()->expression.get();
+    };
+    EXPECT_EQ(expression(0)->evaluate(solver).get_abs(), 12);
+    EXPECT_EQ(expression(1)->evaluate(solver).get_abs(), 31);
+    // the constant out of range stays undefined and keeps its diagnostic
+    EXPECT_EQ(expression(2)->evaluate(solver).value_kind(), context::symbol_value_kind::UNDEF);
+    EXPECT_EQ(expression(2)->diags().size(), (size_t)1);
+}
+
+TEST(operand_field_cache, key)
+{
+    operand_field_cache cache;
+    cache.insert("1+*,4(,12)", field_range, mach_status(), make_fields());
+
+    EXPECT_FALSE(cache.find("1+*,4(,13)", field_range, mach_status()));
+    EXPECT_FALSE(cache.find("1+*,4(,12)", range(position(2, 10), position(2, 20)), mach_status()));
+    EXPECT_FALSE(cache.find("1+*,4(,12)",
+        field_range,
+        processing_status(processing_format(processing_kind::ORDINARY, processing_form::ASM), op_code())));
+    EXPECT_TRUE(cache.find("1+*,4(,12)", field_range, mach_status()));
+}
+
+TEST(operand_field_cache, least_recently_used_evicted)
+{
+    operand_field_cache cache(2);
+    cache.insert("A", field_range, mach_status(), make_fields());
+    cache.insert("B", field_range, mach_status(), make_fields());
+    EXPECT_TRUE(cache.find("A", field_range, mach_status()));
+
+    cache.insert("C", field_range, mach_status(), make_fields());
+    EXPECT_EQ(cache.size(), (size_t)2);
+    EXPECT_TRUE(cache.find("A", field_range, mach_status()));
+    EXPECT_FALSE(cache.find("B", field_range, mach_status()));
+    EXPECT_TRUE(cache.find("C", field_range, mach_status()));
+}
+
+TEST(operand_field_cache, variable_symbols_not_cached)
+{
+    static std::string name = "VAR";
+    concat_chain sublist;
+    sublist.push_back(std::make_unique<char_str_conc>("X", field_range));
+    sublist.push_back(std::make_unique<var_sym_conc>(
+        std::make_unique<basic_variable_symbol>(&name, std::vector<ca_expr_ptr>(), field_range)));
+    std::vector<concat_chain> list;
+    list.push_back(std::move(sublist));
+
+    concat_chain chain;
+    chain.push_back(std::make_unique<char_str_conc>("Y", field_range));
+    chain.push_back(std::make_unique<sublist_conc>(std::move(list)));
+
+    operand_list ops;
+    ops.push_back(std::make_unique<macro_operand_chain>(std::move(chain), field_range));
+    operand_field_cache::parse_result fields(operands_si(field_range, std::move(ops)), remarks_si(field_range, {}));
+
+    operand_field_cache cache;
+    cache.insert("Y(X&VAR)", field_range, mach_status(), fields);
+    EXPECT_EQ(cache.size(), (size_t)0);
+    EXPECT_FALSE(cache.find("Y(X&VAR)", field_range, mach_status()));
+}
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "gtest/gtest.h"
+
+#include "../common_testing.h"
+#include "parsing/statement_checkpoints.h"
+
+using namespace hlasm_plugin::parser_library::parsing;
+
+namespace {
+statement_checkpoint make_checkpoint(std::string text, size_t line)
+{
+    return statement_checkpoint { std::move(text),
+        lexing::source_format(),
+        line,
+        line,
+        processing_status(processing_format(processing_kind::ORDINARY, processing_form::MACH), op_code()),
+        nullptr,
+        {},
+        false };
+}
+
+class shared_ids_provider : public workspaces::empty_parse_lib_provider
+{
+public:
+    std::shared_ptr<context::id_storage> get_id_storage() override { return ids; }
+
+    std::shared_ptr<context::id_storage> ids = std::make_shared<context::id_storage>();
+};
+} // namespace
+
+TEST(statement_checkpoints, find)
+{
+    statement_checkpoints checkpoints;
+    checkpoints.add(make_checkpoint(" LR 1,1\n", 0));
+    checkpoints.add(make_checkpoint(" LR 1,2\n", 1));
+    checkpoints.add(make_checkpoint(" LR 1,3\n", 1));
+    checkpoints.add(make_checkpoint(" LR 1,3\n", 5));
+
+    EXPECT_EQ(checkpoints.find(" LR 1,1\n LR 1,2", lexing::source_format()).size(), (size_t)1);
+    EXPECT_EQ(checkpoints.find(" LR 1,3\n", lexing::source_format()).size(), (size_t)1);
+    EXPECT_TRUE(checkpoints.find(" LR 1,4\n", lexing::source_format()).empty());
+    EXPECT_TRUE(checkpoints.find(" LR 1,", lexing::source_format()).empty());
+    // the same checkpoint is not recorded twice, not even for another line
+    EXPECT_EQ(checkpoints.size(), (size_t)3);
+}
+
+TEST(statement_checkpoints, matches)
+{
+    auto checkpoint = make_checkpoint(" LR 1,1\n", 0);
+    EXPECT_TRUE(checkpoint.matches(" LR 1,1\n LR 1,2", lexing::source_format()));
+    EXPECT_FALSE(checkpoint.matches(" LR 1,1", lexing::source_format()));
+    EXPECT_FALSE(checkpoint.matches(" LR 1,12\n", lexing::source_format()));
+
+    lexing::source_format ictl;
+    ictl.end = 40;
+    EXPECT_FALSE(checkpoint.matches(" LR 1,1\n", ictl));
+
+    // the statement at the end of the input is not followed by anything
+    auto last = make_checkpoint(" LR 1,1", 0);
+    EXPECT_TRUE(last.matches(" LR 1,1", lexing::source_format()));
+    EXPECT_FALSE(last.matches(" LR 1,10", lexing::source_format()));
+}
+
+TEST(statement_checkpoints, reuse_in_next_analysis)
+{
+    std::string input = R"(A EQU 1
+B EQU A+1
+ LR 1,B
+ LR 1,()
+)";
+    shared_ids_provider provider;
+
+    analyzer first(input, "source", provider);
+    first.use_checkpoints(statement_checkpoints(provider.ids));
+    first.analyze();
+    first.collect_diags();
+    auto checkpoints = first.take_checkpoints();
+    // the statement with a syntax error is not recorded
+    EXPECT_EQ(checkpoints.size(), (size_t)3);
+
+    analyzer second(input, "source", provider);
+    second.use_checkpoints(std::move(checkpoints));
+    second.analyze();
+    second.collect_diags();
+
+    EXPECT_EQ(second.get_metrics().reused_statements, (size_t)3);
+    EXPECT_EQ(second.diags().size(), first.diags().size());
+    EXPECT_EQ(second.hlasm_ctx().ord_ctx.get_symbol(second.hlasm_ctx().ids().add("B"))->value().get_abs(), 2);
+}
+
+TEST(statement_checkpoints, reuse_after_changed_line)
+{
+    shared_ids_provider provider;
+
+    analyzer first("A EQU 1\nB EQU A+1\n", "source", provider);
+    first.use_checkpoints(statement_checkpoints(provider.ids));
+    first.analyze();
+
+    analyzer second("A EQU 2\nB EQU A+1\n", "source", provider);
+    second.use_checkpoints(first.take_checkpoints());
+    second.analyze();
+
+    EXPECT_EQ(second.get_metrics().reused_statements, (size_t)1);
+    EXPECT_EQ(second.hlasm_ctx().ord_ctx.get_symbol(second.hlasm_ctx().ids().add("B"))->value().get_abs(), 3);
+}
+
+TEST(statement_checkpoints, checkpoints_outlive_analysis)
+{
+    std::string input = R"(A EQU 1
+ LR 1,A
+ LR 1,0(2,3)
+)";
+    shared_ids_provider provider;
+
+    statement_checkpoints checkpoints(provider.ids);
+    {
+        analyzer first(input, "source", provider);
+        first.use_checkpoints(std::move(checkpoints));
+        first.analyze();
+        checkpoints = first.take_checkpoints();
+    }
+    // the statements kept by the checkpoints keep the memory of the analysis that parsed them
+
+    analyzer second(input, "source", provider);
+    second.use_checkpoints(std::move(checkpoints));
+    second.analyze();
+    second.collect_diags();
+
+    EXPECT_EQ(second.get_metrics().reused_statements, (size_t)3);
+    EXPECT_TRUE(second.diags().empty());
+}
+
+TEST(statement_checkpoints, moved_statements_are_reused)
+{
+    std::string input = R"(A EQU 1
+B EQU A+1
+ DC C'A'
+ LR 1,UNDEF
+)";
+    std::string moved = "* COMMENT\n* COMMENT\n" + input;
+    shared_ids_provider provider;
+
+    analyzer first(input, "source", provider);
+    first.use_checkpoints(statement_checkpoints(provider.ids));
+    first.analyze();
+
+    analyzer second(moved, "source", provider);
+    second.use_checkpoints(first.take_checkpoints());
+    second.analyze();
+    second.collect_diags();
+
+    EXPECT_EQ(second.get_metrics().reused_statements, (size_t)4);
+    EXPECT_EQ(second.hlasm_ctx().ord_ctx.get_symbol(second.hlasm_ctx().ids().add("B"))->value().get_abs(), 2);
+
+    // the moved statements behave as if they were parsed on their new lines
+    analyzer parsed(moved);
+    parsed.analyze();
+    parsed.collect_diags();
+
+    EXPECT_EQ(second.source_processor().semantic_tokens(), parsed.source_processor().semantic_tokens());
+    ASSERT_FALSE(parsed.diags().empty());
+    ASSERT_EQ(second.diags().size(), parsed.diags().size());
+    for (size_t i = 0; i < parsed.diags().size(); ++i)
+        EXPECT_EQ(second.diags()[i].diag_range, parsed.diags()[i].diag_range);
+
+    // the statements are recorded at their new lines
+    auto checkpoints = second.take_checkpoints();
+    EXPECT_EQ(checkpoints.size(), (size_t)6);
+    auto found = checkpoints.find("A EQU 1\nB EQU A+1\n", lexing::source_format());
+    ASSERT_EQ(found.size(), (size_t)1);
+    EXPECT_EQ(found[0]->line, (size_t)2);
+}
+
+TEST(statement_checkpoints, statements_moved_up)
+{
+    shared_ids_provider provider;
+
+    analyzer first("* COMMENT\nA EQU 1\nB EQU A+1\n", "source", provider);
+    first.use_checkpoints(statement_checkpoints(provider.ids));
+    first.analyze();
+
+    analyzer second("A EQU 1\nB EQU A+1\n", "source", provider);
+    second.use_checkpoints(first.take_checkpoints());
+    second.analyze();
+
+    analyzer parsed("A EQU 1\nB EQU A+1\n");
+    parsed.analyze();
+
+    EXPECT_EQ(second.get_metrics().reused_statements, (size_t)2);
+    EXPECT_EQ(second.source_processor().semantic_tokens(), parsed.source_processor().semantic_tokens());
+}
+
+TEST(statement_checkpoints, statements_with_variables_are_parsed_when_moved)
+{
+    std::string input = R"(&A SETA 1
+B EQU &A
+)";
+    shared_ids_provider provider;
+
+    analyzer first(input, "source", provider);
+    first.use_checkpoints(statement_checkpoints(provider.ids));
+    first.analyze();
+
+    // the statements with variable symbols cannot be copied to the new lines
+    analyzer second("* COMMENT\n" + input, "source", provider);
+    second.use_checkpoints(first.take_checkpoints());
+    second.analyze();
+
+    EXPECT_EQ(second.get_metrics().reused_statements, (size_t)0);
+    EXPECT_EQ(second.hlasm_ctx().ord_ctx.get_symbol(second.hlasm_ctx().ids().add("B"))->value().get_abs(), 1);
+}
+
+TEST(statement_checkpoints, statements_revisited_by_aif)
+{
+    std::string input = R"(&I SETA 0
+.L ANOP
+&I SETA &I+1
+ AIF (&I LT 5).L
+)";
+    shared_ids_provider provider;
+
+    analyzer a(input, "source", provider);
+    a.use_checkpoints(statement_checkpoints(provider.ids));
+    a.analyze();
+    a.collect_diags();
+
+    // the loop body is parsed once and provided from the checkpoints in the next iterations
+    EXPECT_GT(a.get_metrics().reused_statements, (size_t)0);
+    EXPECT_TRUE(a.diags().empty());
+    EXPECT_EQ(a.hlasm_ctx()
+                  .get_var_sym(a.hlasm_ctx().ids().add("I"))
+                  ->access_set_symbol_base()
+                  ->access_set_symbol<context::A_t>()
+                  ->get_value(),
+        5);
+}
+
+TEST(statement_checkpoints, different_id_storage)
+{
+    std::string input = " LR 1,1";
+    shared_ids_provider provider;
+
+    analyzer first(input, "source", provider);
+    first.use_checkpoints(statement_checkpoints(provider.ids));
+    first.analyze();
+    auto checkpoints = first.take_checkpoints();
+
+    analyzer second(input);
+    second.use_checkpoints(std::move(checkpoints));
+    second.analyze();
+
+    EXPECT_EQ(second.get_metrics().reused_statements, (size_t)0);
+}
+
+TEST(statement_checkpoints, aread_stops_recording)
+{
+    std::string input = R"( MACRO
+ M
+&A AREAD
+ MEND
+ LR 1,1
+ M
+THIS IS READ
+ LR 1,2
+)";
+    shared_ids_provider provider;
+
+    analyzer first(input, "source", provider);
+    first.use_checkpoints(statement_checkpoints(provider.ids));
+    first.analyze();
+
+    auto checkpoints = first.take_checkpoints();
+    // statements after the first AREAD are not recorded
+    EXPECT_FALSE(checkpoints.find(" LR 1,1\n M\n", lexing::source_format()).empty());
+    EXPECT_TRUE(checkpoints.find(" LR 1,2\n", lexing::source_format()).empty());
+}
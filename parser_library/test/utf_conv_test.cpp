@@ -37,20 +37,46 @@ TEST(input_source, utf8conv)
 
     hlasm_plugin::parser_library::lexing::input_source input2(u8);
 
-    EXPECT_EQ(u8, input2.getText({ (ssize_t)0, (ssize_t)1 }));
+    EXPECT_EQ(u8, input2.getText({ (ssize_t)0, (ssize_t)4 }));
 
     u8.insert(u8.end(), (unsigned char)0xC5);
     u8.insert(u8.end(), (unsigned char)0x80);
 
     hlasm_plugin::parser_library::lexing::input_source input3(u8);
 
-    EXPECT_EQ(u8, input3.getText({ (ssize_t)0, (ssize_t)2 }));
+    EXPECT_EQ(u8, input3.getText({ (ssize_t)0, (ssize_t)7 }));
 
     u8.insert(u8.end(), (unsigned char)0x41);
 
     hlasm_plugin::parser_library::lexing::input_source input4(u8);
 
-    EXPECT_EQ(u8, input4.getText({ (ssize_t)0, (ssize_t)3 }));
+    EXPECT_EQ(u8, input4.getText({ (ssize_t)0, (ssize_t)9 }));
+}
+
+TEST(input_source, utf8_characters)
+{
+    // A, U+10000, U+A123, U+0140, B
+    hlasm_plugin::parser_library::lexing::input_source input("A\xF0\x90\x80\x80\xEA\x84\xA3\xC5\x80"
+                                                             "B");
+
+    EXPECT_EQ(input.size(), (size_t)11);
+    EXPECT_EQ(input.LA(1), (size_t)'A');
+    EXPECT_EQ(input.LA(2), (size_t)0x10000);
+    EXPECT_EQ(input.LA(3), (size_t)0xA123);
+    EXPECT_EQ(input.LA(4), (size_t)0x0140);
+    EXPECT_EQ(input.LA(5), (size_t)'B');
+    EXPECT_EQ(input.LA(6), (size_t)antlr4::CharStream::EOF);
+
+    // the stream indices are byte offsets
+    input.consume();
+    EXPECT_EQ(input.index(), (size_t)1);
+    input.consume();
+    EXPECT_EQ(input.index(), (size_t)5);
+    EXPECT_EQ(input.LA(-1), (size_t)0x10000);
+    EXPECT_EQ(input.LA(1), (size_t)0xA123);
+
+    EXPECT_EQ(input.getText({ (ssize_t)1, (ssize_t)7 }), "\xF0\x90\x80\x80\xEA\x84\xA3");
+    EXPECT_EQ(input.characters(0, input.size()), (size_t)5);
 }
 
 TEST(ebcdic_encoding, unicode)
@@ -159,4 +185,36 @@ TEST(replace_non_utf8_chars, middle_char)
     EXPECT_EQ(res[begin.size() + 2], '\xBD');
     EXPECT_EQ(res.substr(0, begin.size()), begin);
     EXPECT_EQ(res.substr(begin.size() + 3), end);
-}
\ No newline at end of file
+}
+
+TEST(replace_non_utf8_chars, multiple_chars)
+{
+    std::string text = "a long ascii text before" + std::string(1, '\x80') + "another long ascii text\xC5\x80"
+        + std::string(1, '\xE0') + "end";
+
+    std::string res = file_impl::replace_non_utf8_chars(text);
+
+    EXPECT_EQ(res,
+        "a long ascii text before\xEF\xBF\xBD"
+        "another long ascii text\xC5\x80\xEF\xBF\xBD"
+        "end");
+}
+
+TEST(find_non_utf8_char, positions)
+{
+    EXPECT_EQ(file_impl::find_non_utf8_char(""), (size_t)0);
+    EXPECT_EQ(file_impl::find_non_utf8_char("only ascii characters"), (size_t)21);
+    EXPECT_EQ(file_impl::find_non_utf8_char("valid \xEA\x84\xA3 utf-8 text"), (size_t)20);
+    EXPECT_EQ(file_impl::find_non_utf8_char("0123456789\xBF"), (size_t)10);
+    // truncated character at the end
+    EXPECT_EQ(file_impl::find_non_utf8_char("0123456789abcdef\xF0\x90\x80"), (size_t)16);
+}
+
+TEST(create_line_indices, long_lines)
+{
+    std::string text = "first line of the text\r\nsecond line of the text\rthird line of the text\n\nlast";
+
+    EXPECT_EQ(file_impl::create_line_indices(text), (std::vector<size_t> { 0, 24, 48, 71, 72 }));
+    EXPECT_EQ(file_impl::create_line_indices("no line terminators in this text"), (std::vector<size_t> { 0 }));
+    EXPECT_EQ(file_impl::create_line_indices("ends with carriage return\r"), (std::vector<size_t> { 0, 26 }));
+}
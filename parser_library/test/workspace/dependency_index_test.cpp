@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "gtest/gtest.h"
+
+#include "workspaces/dependency_index.h"
+
+using namespace hlasm_plugin::parser_library::workspaces;
+
+TEST(dependency_index, update)
+{
+    dependency_index index;
+    index.update("B", { "MAC1", "MAC2" });
+    index.update("A", { "MAC1" });
+
+    EXPECT_TRUE(index.is_dependant("A"));
+    EXPECT_TRUE(index.is_dependency("MAC2"));
+    EXPECT_FALSE(index.is_dependency("A"));
+    EXPECT_EQ(index.dependants_of("MAC1"), (std::vector<std::string> { "A", "B" }));
+    EXPECT_EQ(index.dependants(), (std::vector<std::string> { "A", "B" }));
+
+    index.update("B", { "MAC3" });
+
+    EXPECT_FALSE(index.is_dependency("MAC2"));
+    EXPECT_EQ(index.dependants_of("MAC1"), (std::vector<std::string> { "A" }));
+    EXPECT_EQ(index.dependants_of("MAC3"), (std::vector<std::string> { "B" }));
+}
+
+TEST(dependency_index, no_dependencies)
+{
+    dependency_index index;
+    index.update("A", {});
+    EXPECT_FALSE(index.is_dependant("A"));
+
+    // a dependant stays one even when it loses all its dependencies
+    index.update("A", { "MAC" });
+    index.update("A", {});
+    EXPECT_TRUE(index.is_dependant("A"));
+    EXPECT_FALSE(index.is_dependency("MAC"));
+}
+
+TEST(dependency_index, remove)
+{
+    dependency_index index;
+    index.update("A", { "MAC1" });
+    index.update("B", { "MAC1", "MAC2" });
+
+    index.remove("B");
+
+    EXPECT_FALSE(index.is_dependant("B"));
+    EXPECT_FALSE(index.is_dependency("MAC2"));
+    EXPECT_EQ(index.dependants_of("MAC1"), (std::vector<std::string> { "A" }));
+    EXPECT_TRUE(index.dependants_of("MAC2").empty());
+    EXPECT_TRUE(index.dependants_of("UNKNOWN").empty());
+}
+
+TEST(dependency_index, has_other_dependant)
+{
+    dependency_index index;
+    index.update("A", { "MAC1", "MAC2" });
+    index.update("B", { "MAC1" });
+
+    EXPECT_TRUE(index.has_other_dependant("MAC1", "A"));
+    EXPECT_FALSE(index.has_other_dependant("MAC2", "A"));
+    EXPECT_TRUE(index.has_other_dependant("MAC2", "B"));
+    EXPECT_FALSE(index.has_other_dependant("UNKNOWN", "A"));
+}
+
+TEST(dependency_index, names_released)
+{
+    dependency_index index;
+    index.update("A", { "MAC1", "MAC2" });
+    index.update("B", { "MAC1", "B" });
+    EXPECT_EQ(index.names_count(), (size_t)4);
+
+    index.update("A", { "MAC1" });
+    EXPECT_EQ(index.names_count(), (size_t)3);
+
+    index.remove("B");
+    EXPECT_EQ(index.names_count(), (size_t)2);
+    EXPECT_FALSE(index.is_dependency("B"));
+
+    index.remove("A");
+    EXPECT_EQ(index.names_count(), (size_t)0);
+    EXPECT_TRUE(index.dependants().empty());
+}
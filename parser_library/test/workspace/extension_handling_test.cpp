@@ -139,3 +139,37 @@ TEST(extension_handling_test, legacy_extension_selection_file_without_ext)
     const auto& diags = lib.diags();
     EXPECT_TRUE(std::none_of(diags.begin(), diags.end(), [](const auto& d) { return d.code == "L0003"; }));
 }
+
+class file_manager_extension_mock_added : public file_manager_extension_mock
+{
+    bool file_exists(const std::string&) override { return true; }
+};
+
+TEST(extension_handling_test, file_added)
+{
+    file_manager_extension_mock_added file_mngr;
+    library_local lib(file_mngr, "lib", { { ".hlasm" } });
+    EXPECT_NE(lib.find_file("MAC"), nullptr);
+
+    // the added member is opened with the same path as the listed ones
+    lib.file_changed(lib_path + "Other.hlasm");
+    EXPECT_NE(lib.find_file("OTHER"), nullptr);
+    EXPECT_NE(file_mngr.find(lib_path + "Mac.hlasm"), nullptr);
+    EXPECT_NE(file_mngr.find(lib_path + "Other.hlasm"), nullptr);
+}
+
+class file_manager_extension_mock_dir_added : public file_manager_extension_mock_added
+{
+    bool dir_exists(const std::string& dir_name) override { return dir_name == lib_path + "Nested.hlasm"; }
+};
+
+TEST(extension_handling_test, directory_added)
+{
+    file_manager_extension_mock_dir_added file_mngr;
+    library_local lib(file_mngr, "lib", { { ".hlasm" } });
+    EXPECT_NE(lib.find_file("MAC"), nullptr);
+
+    // only regular files are members, the directory is looked up through the file manager
+    lib.file_changed(lib_path + "Nested.hlasm");
+    EXPECT_EQ(lib.find_file("NESTED"), nullptr);
+}
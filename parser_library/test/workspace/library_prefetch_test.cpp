@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "workspaces/library_prefetch.h"
+
+using namespace hlasm_plugin::parser_library::workspaces;
+
+TEST(library_prefetch, wait_for_member)
+{
+    std::promise<void> start;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<bool> done = false;
+
+    library_prefetch prefetch;
+    prefetch.start({
+        { "MAC", [&start, released, &done]() {
+             start.set_value();
+             released.wait();
+             done = true;
+         } },
+    });
+    start.get_future().wait();
+
+    // unknown members are not waited for
+    prefetch.wait_for("OTHER");
+    EXPECT_FALSE(done);
+
+    release.set_value();
+    prefetch.wait_for("MAC");
+    EXPECT_TRUE(done);
+}
+
+TEST(library_prefetch, queued_task_cancelled)
+{
+    std::promise<void> start;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<bool> done = false;
+
+    // the blocked task occupies the only thread
+    library_prefetch prefetch(1);
+    prefetch.start({
+        { "BLOCKED", [&start, released]() {
+             start.set_value();
+             released.wait();
+         } },
+    });
+    start.get_future().wait();
+    prefetch.start({
+        { "MAC", [&done]() { done = true; } },
+    });
+
+    // the caller parses the member itself instead of waiting for the blocked task
+    prefetch.wait_for("MAC");
+
+    release.set_value();
+    prefetch.wait_all();
+    EXPECT_FALSE(done);
+}
+
+TEST(library_prefetch, all_tasks_run)
+{
+    std::atomic<int> finished = 0;
+    std::vector<std::pair<std::string, library_prefetch::task>> tasks;
+    for (int i = 0; i < 20; ++i)
+        tasks.emplace_back("MAC" + std::to_string(i), [&finished]() { ++finished; });
+
+    library_prefetch prefetch;
+    prefetch.start(std::move(tasks));
+    prefetch.wait_all();
+
+    EXPECT_EQ(finished, 20);
+}
+
+TEST(library_prefetch, failed_task)
+{
+    library_prefetch prefetch;
+    prefetch.start({
+        { "MAC", []() { throw std::runtime_error("failed"); } },
+    });
+
+    // the member is then parsed by the analysis
+    prefetch.wait_for("MAC");
+}
+
+TEST(library_prefetch, tasks_do_not_wait)
+{
+    std::promise<void> start;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::promise<void> done;
+
+    // the blocked task occupies one of the threads
+    library_prefetch prefetch(2);
+    prefetch.start({
+        { "BLOCKED", [&start, released]() {
+             start.set_value();
+             released.wait();
+         } },
+    });
+    start.get_future().wait();
+    prefetch.start({
+        { "MAC", [&prefetch, &done]() {
+             prefetch.wait_for("BLOCKED");
+             done.set_value();
+         } },
+    });
+
+    // the task does not wait for the running one
+    EXPECT_EQ(done.get_future().wait_for(std::chrono::seconds(10)), std::future_status::ready);
+
+    release.set_value();
+}
+
+TEST(library_prefetch, threads_limited)
+{
+    std::atomic<int> running = 0;
+    std::atomic<int> most_running = 0;
+    std::vector<std::pair<std::string, library_prefetch::task>> tasks;
+    for (int i = 0; i < 20; ++i)
+        tasks.emplace_back("MAC" + std::to_string(i), [&running, &most_running]() {
+            int now = ++running;
+            int most = most_running;
+            while (most < now && !most_running.compare_exchange_weak(most, now))
+                ;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            --running;
+        });
+
+    library_prefetch prefetch(3);
+    prefetch.start(std::move(tasks));
+    prefetch.start({ { "MAC20", []() {} } });
+    prefetch.wait_all();
+
+    EXPECT_GE(most_running, 1);
+    EXPECT_LE(most_running, 3);
+}
+
+TEST(library_prefetch, tasks_started_by_tasks)
+{
+    std::promise<void> queued;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<bool> done = false;
+
+    library_prefetch prefetch;
+    prefetch.start({
+        { "COPY", [&prefetch, &queued, released, &done]() {
+             prefetch.start({
+                 { "MAC", [released, &done]() {
+                      released.wait();
+                      done = true;
+                  } },
+             });
+             queued.set_value();
+         } },
+    });
+    queued.get_future().wait();
+
+    // the tasks queued by the other tasks are waited for as well
+    release.set_value();
+    prefetch.wait_all();
+    EXPECT_TRUE(done);
+}
+
+TEST(library_prefetch, parallel_all_tasks_run)
+{
+    std::vector<int> results(50);
+    std::vector<library_prefetch::task> tasks;
+    for (size_t i = 0; i < results.size(); ++i)
+        tasks.emplace_back([&results, i]() { results[i] = (int)i; });
+
+    library_prefetch prefetch(3);
+    prefetch.run_parallel(std::move(tasks));
+
+    for (size_t i = 0; i < results.size(); ++i)
+        EXPECT_EQ(results[i], (int)i);
+}
+
+TEST(library_prefetch, parallel_exception_rethrown)
+{
+    std::atomic<int> finished = 0;
+    std::vector<library_prefetch::task> tasks;
+    for (size_t i = 0; i < 10; ++i)
+        tasks.emplace_back([&finished, i]() {
+            if (i == 5)
+                throw std::runtime_error("failed");
+            ++finished;
+        });
+
+    library_prefetch prefetch(2);
+    EXPECT_THROW(prefetch.run_parallel(std::move(tasks)), std::runtime_error);
+    EXPECT_EQ(finished, 9);
+}
+
+TEST(library_prefetch, parallel_cancelled)
+{
+    std::atomic<bool> cancel = true;
+    std::atomic<int> finished = 0;
+    std::vector<library_prefetch::task> tasks(10, [&finished]() { ++finished; });
+
+    library_prefetch prefetch(1);
+    prefetch.run_parallel(std::move(tasks), &cancel);
+
+    EXPECT_EQ(finished, 0);
+}
+
+TEST(library_prefetch, parallel_not_blocked_by_prefetch)
+{
+    std::promise<void> start;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+
+    // the blocked task occupies the only thread, the calling thread runs the whole batch
+    library_prefetch prefetch(1);
+    prefetch.start({
+        { "BLOCKED", [&start, released]() {
+             start.set_value();
+             released.wait();
+         } },
+    });
+    start.get_future().wait();
+
+    std::atomic<int> finished = 0;
+    std::vector<library_prefetch::task> tasks(10, [&finished]() { ++finished; });
+    prefetch.run_parallel(std::move(tasks));
+    EXPECT_EQ(finished, 10);
+
+    release.set_value();
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../common_testing.h"
+#include "workspaces/macro_serializer.h"
+
+using namespace hlasm_plugin::parser_library::workspaces;
+
+namespace {
+const std::string macro_source = R"( MACRO
+&L MAC &P1,&P2,&K=(A,B),&E=
+ GBLA &RES
+ GBLC &STR
+ LCLA &I
+&I SETA 2*3-6
+.LOOP AIF (&I GE N'&K).DONE
+&I SETA &I+1
+&STR SETC '&STR'.'&K(&I)'
+ AGO .LOOP
+.DONE ANOP
+&RES SETA (&P1*2-&P2/1)+K'&P1+(&P2 AND 3)
+&L LR &P1,&P2
+ MEND
+)";
+
+// provides the MAC macro from its serialized form
+class serialized_macro_provider : public workspaces::empty_parse_lib_provider
+{
+public:
+    std::string member = "MAC";
+    std::string data;
+    bool loaded = false;
+
+    parse_result parse_library(const std::string& library, analyzing_context ctx, const library_data) override
+    {
+        if (library != member)
+            return false;
+        auto macro_i = deserialize_macro(data, *ctx.hlasm_ctx);
+        if (!macro_i)
+            return false;
+        ctx.hlasm_ctx->add_macro(macro_i->macro_definition);
+        ctx.lsp_ctx->add_macro(std::move(macro_i));
+        loaded = true;
+        return true;
+    }
+    bool has_library(const std::string& library, const std::string&) const override { return library == member; }
+};
+
+std::optional<std::string> serialize_source_macro(
+    const std::string& source = macro_source, const std::string& name = "MAC")
+{
+    analyzer a(source, name);
+    a.analyze();
+
+    auto& macros = a.hlasm_ctx().macros();
+    auto found = macros.find(a.hlasm_ctx().ids().add(name));
+    if (found == macros.end())
+        return std::nullopt;
+
+    return serialize_macro(*a.context().lsp_ctx->get_macro_info(found->second));
+}
+} // namespace
+
+TEST(macro_serializer, expand_deserialized_macro)
+{
+    auto data = serialize_source_macro();
+    ASSERT_TRUE(data.has_value());
+
+    std::string input = R"(
+ GBLA &RES
+ GBLC &STR
+LBL MAC 3,4,K=(X,YY,Z)
+)";
+    serialized_macro_provider provider;
+    provider.data = std::move(*data);
+
+    analyzer a(input, "OPEN", provider);
+    a.analyze();
+    a.collect_diags();
+
+    EXPECT_TRUE(provider.loaded);
+    EXPECT_EQ(a.diags().size(), (size_t)0);
+    EXPECT_EQ(a.hlasm_ctx()
+                  .get_var_sym(a.hlasm_ctx().ids().add("RES"))
+                  ->access_set_symbol_base()
+                  ->access_set_symbol<A_t>()
+                  ->get_value(),
+        3);
+    EXPECT_EQ(a.hlasm_ctx()
+                  .get_var_sym(a.hlasm_ctx().ids().add("STR"))
+                  ->access_set_symbol_base()
+                  ->access_set_symbol<C_t>()
+                  ->get_value(),
+        "XYYZ");
+    EXPECT_NE(a.hlasm_ctx().ord_ctx.get_symbol(a.hlasm_ctx().ids().add("LBL")), nullptr);
+}
+
+TEST(macro_serializer, corrupted_data)
+{
+    auto data = serialize_source_macro();
+    ASSERT_TRUE(data.has_value());
+
+    context::hlasm_context ctx;
+    EXPECT_TRUE(deserialize_macro(*data, ctx));
+    EXPECT_FALSE(deserialize_macro(std::string_view(*data).substr(0, data->size() / 2), ctx));
+    EXPECT_FALSE(deserialize_macro(*data + "X", ctx));
+
+    auto other_version = *data;
+    other_version[0] = (char)(macro_serialization_version + 1);
+    EXPECT_FALSE(deserialize_macro(other_version, ctx));
+}
+
+namespace {
+// values folded in the CA expression operands of the definition
+std::vector<std::optional<A_t>> folded_values(const context::macro_definition& def)
+{
+    std::vector<std::optional<A_t>> result;
+    for (const auto& cache : def.cached_definition)
+    {
+        const auto* resolved = cache.get_base()->access_resolved();
+        if (!resolved)
+            continue;
+        for (const auto& op : resolved->operands_ref().value)
+        {
+            if (auto ca_op = op->access_ca(); ca_op && ca_op->kind == semantics::ca_kind::EXPR)
+                result.push_back(ca_op->access_expr()->expression->constant_value());
+        }
+    }
+    return result;
+}
+} // namespace
+
+TEST(macro_serializer, constants_kept)
+{
+    analyzer a(macro_source, "MAC");
+    a.analyze();
+    auto found = a.hlasm_ctx().macros().find(a.hlasm_ctx().ids().add("MAC"));
+    ASSERT_NE(found, a.hlasm_ctx().macros().end());
+
+    auto data = serialize_macro(*a.context().lsp_ctx->get_macro_info(found->second));
+    ASSERT_TRUE(data.has_value());
+
+    context::hlasm_context ctx;
+    auto macro_i = deserialize_macro(*data, ctx);
+    ASSERT_TRUE(macro_i);
+
+    const auto expected = folded_values(*found->second);
+    ASSERT_NE(std::find(expected.begin(), expected.end(), std::optional<A_t>(0)), expected.end());
+    EXPECT_EQ(folded_values(*macro_i->macro_definition), expected);
+}
+
+namespace {
+const std::string outer_source = R"( MACRO
+ INNER
+ MEND
+ MACRO
+ OUTER
+ INNER
+ MEND
+)";
+
+const lsp::symbol_occurence* find_instr(const lsp::macro_info& macro_i, std::string_view name)
+{
+    for (const auto& [file, occurences] : macro_i.file_occurences_)
+        for (const auto& occ : occurences)
+            if (occ.kind == lsp::occurence_kind::INSTR && *occ.name == name)
+                return &occ;
+    return nullptr;
+}
+} // namespace
+
+TEST(macro_serializer, other_macro_opcode)
+{
+    analyzer a(outer_source, "OUTER");
+    a.analyze();
+    const auto& macros = a.hlasm_ctx().macros();
+    auto outer = macros.find(a.hlasm_ctx().ids().add("OUTER"));
+    auto inner = macros.find(a.hlasm_ctx().ids().add("INNER"));
+    ASSERT_NE(outer, macros.end());
+    ASSERT_NE(inner, macros.end());
+
+    auto data = serialize_macro(*a.context().lsp_ctx->get_macro_info(outer->second));
+    ASSERT_TRUE(data.has_value());
+
+    // the context that knows the called macro links it directly
+    auto known = deserialize_macro(*data, a.hlasm_ctx());
+    ASSERT_TRUE(known);
+    auto known_occ = find_instr(*known, "INNER");
+    ASSERT_TRUE(known_occ);
+    EXPECT_EQ(known_occ->opcode, inner->second);
+    EXPECT_FALSE(known_occ->macro_by_name);
+
+    // otherwise it is looked up by the name when needed
+    context::hlasm_context ctx;
+    auto unknown = deserialize_macro(*data, ctx);
+    ASSERT_TRUE(unknown);
+    auto unknown_occ = find_instr(*unknown, "INNER");
+    ASSERT_TRUE(unknown_occ);
+    EXPECT_EQ(unknown_occ->opcode, nullptr);
+    EXPECT_TRUE(unknown_occ->macro_by_name);
+}
+
+TEST(macro_serializer, definition_of_macro_defined_later)
+{
+    auto data = serialize_source_macro(outer_source, "OUTER");
+    ASSERT_TRUE(data.has_value());
+
+    std::string input = R"( OUTER
+ MACRO
+ INNER
+ MEND
+)";
+    serialized_macro_provider provider;
+    provider.member = "OUTER";
+    provider.data = std::move(*data);
+
+    analyzer a(input, "OPEN", provider);
+    a.analyze();
+
+    EXPECT_TRUE(provider.loaded);
+    auto res = a.context().lsp_ctx->definition("OUTER", { 5, 1 });
+    EXPECT_EQ(res.file, "OPEN");
+    EXPECT_EQ(res.pos, position(2, 1));
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "workspaces/macro_serializer.h"
+#include "workspaces/persistent_macro_cache.h"
+
+using namespace hlasm_plugin::parser_library::workspaces;
+
+namespace {
+class persistent_macro_cache_test : public testing::Test
+{
+protected:
+    std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "hlasm_persistent_macro_cache_test" / "macro_cache";
+
+    void SetUp() override
+    {
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+    }
+    void TearDown() override { std::filesystem::remove_all(directory.parent_path()); }
+
+    // creates an entry with the header of the given format version, used the given number of hours ago
+    void create_entry(const std::string& name, size_t size, int hours_unused, uint32_t version)
+    {
+        auto path = directory / name;
+        {
+            std::ofstream out(path, std::ios::binary);
+            out.write("HLASMMAC", sizeof("HLASMMAC"));
+            out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+            out << std::string(size, 'x');
+        }
+        std::filesystem::last_write_time(
+            path, std::filesystem::file_time_type::clock::now() - std::chrono::hours(hours_unused));
+    }
+
+    bool exists(const std::string& name) const { return std::filesystem::exists(directory / name); }
+};
+} // namespace
+
+TEST_F(persistent_macro_cache_test, cleanup_other_formats)
+{
+    create_entry("current.macro", 10, 0, macro_serialization_version);
+    create_entry("old.macro", 10, 0, macro_serialization_version - 1);
+    create_entry("interrupted.macro.tmp", 10, 0, macro_serialization_version);
+
+    persistent_macro_cache(directory).cleanup();
+
+    EXPECT_TRUE(exists("current.macro"));
+    EXPECT_FALSE(exists("old.macro"));
+    EXPECT_FALSE(exists("interrupted.macro.tmp"));
+}
+
+TEST_F(persistent_macro_cache_test, cleanup_least_recently_used)
+{
+    create_entry("a.macro", 1000, 1, macro_serialization_version);
+    create_entry("b.macro", 1000, 3, macro_serialization_version);
+    create_entry("c.macro", 1000, 2, macro_serialization_version);
+
+    persistent_macro_cache(directory).cleanup(2500);
+
+    EXPECT_TRUE(exists("a.macro"));
+    EXPECT_FALSE(exists("b.macro"));
+    EXPECT_TRUE(exists("c.macro"));
+
+    persistent_macro_cache(directory).cleanup(0);
+
+    EXPECT_FALSE(exists("a.macro"));
+    EXPECT_FALSE(exists("c.macro"));
+}
+
+TEST_F(persistent_macro_cache_test, cleanup_missing_directory)
+{
+    std::filesystem::remove_all(directory);
+
+    persistent_macro_cache(directory).cleanup();
+
+    EXPECT_FALSE(std::filesystem::exists(directory));
+}
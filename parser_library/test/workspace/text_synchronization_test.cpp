@@ -12,10 +12,15 @@
  *   Broadcom, Inc. - initial API and implementation
  */
 
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "workspaces/file_impl.h"
 
+using namespace hlasm_plugin::parser_library;
 using namespace hlasm_plugin::parser_library::workspaces;
 
 TEST(file, text_synchronization_rn)
@@ -216,4 +221,107 @@ TEST(file, text_synchronization_n)
 
     file_n.did_change({ { 0, 0 }, { 0, 0 } }, "one");
     EXPECT_EQ(file_n.get_text(), "one");
-}
\ No newline at end of file
+}
+TEST(file, text_synchronization_split_terminator)
+{
+    file_impl file("file_uri");
+    file.did_open("first\rsecond\nthird", 1);
+
+    // \r at the end of the first line and the inserted \n form a single terminator
+    file.did_change({ { 1, 0 }, { 1, 0 } }, "\n");
+    EXPECT_EQ(file.get_text(), "first\r\nsecond\nthird");
+
+    file.did_change({ { 1, 0 }, { 1, 0 } }, "X");
+    EXPECT_EQ(file.get_text(), "first\r\nXsecond\nthird");
+
+    // removing the \n splits the terminator again
+    file.did_change({ { 0, 6 }, { 0, 7 } }, "");
+    EXPECT_EQ(file.get_text(), "first\rXsecond\nthird");
+
+    file.did_change({ { 0, 5 }, { 0, 5 } }, "abc\r");
+    EXPECT_EQ(file.get_text(), "firstabc\r\rXsecond\nthird");
+
+    file.did_change({ { 2, 0 }, { 2, 0 } }, "\n");
+    EXPECT_EQ(file.get_text(), "firstabc\r\r\nXsecond\nthird");
+
+    file.did_change({ { 2, 1 }, { 3, 0 } }, "");
+    EXPECT_EQ(file.get_text(), "firstabc\r\r\nXthird");
+}
+
+TEST(file, text_synchronization_many_changes)
+{
+    const std::string pieces[] = { "", "a", "bcd", "\r", "\n", "\r\n", "ef\rgh", "\n\nij" };
+    std::string expected = "0123\n4567\r\n89\r";
+
+    file_impl file("file_uri");
+    file.did_open(expected, 1);
+
+    uint32_t seed = 1;
+    auto next = [&seed](uint32_t bound) {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) % bound;
+    };
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        auto lines = file_impl::create_line_indices(expected);
+        position start(next((uint32_t)lines.size() + 1), next(6));
+        position end = next(4) ? start : position(start.line + next(3), next(6));
+        size_t begin_i = file_impl::index_from_position(expected, lines, start);
+        size_t end_i = file_impl::index_from_position(expected, lines, end);
+        if (begin_i > end_i)
+            continue;
+
+        const auto& piece = pieces[next(std::size(pieces))];
+        expected.replace(begin_i, end_i - begin_i, piece);
+        file.did_change({ start, end }, piece);
+
+        if (i % 100 == 0)
+            ASSERT_EQ(file.get_text(), expected);
+    }
+    EXPECT_EQ(file.get_text(), expected);
+
+    file_impl copy(file);
+    copy.did_change({ { 0, 0 }, { 0, 0 } }, "copy");
+    EXPECT_EQ(file.get_text(), expected);
+    EXPECT_EQ(copy.get_text(), "copy" + expected);
+}
+
+TEST(file, text_synchronization_concurrent_readers)
+{
+    file_impl file("file_uri");
+    file.did_open("first\nsecond\nthird", 1);
+    file.did_change({ { 1, 0 }, { 1, 0 } }, "inserted\n");
+
+    // the text is rebuilt by the first reader, the others wait for it
+    std::vector<std::thread> readers;
+    std::vector<std::string> texts(4);
+    for (auto& text : texts)
+        readers.emplace_back([&file, &text]() { text = file.get_text(); });
+    for (auto& reader : readers)
+        reader.join();
+
+    for (const auto& text : texts)
+        EXPECT_EQ(text, "first\ninserted\nsecond\nthird");
+}
+
+TEST(file, text_synchronization_reader_during_changes)
+{
+    text_document document("first\nsecond\n");
+    const auto original = document.text();
+
+    // the reader gets either the text before or after a change, never one that is being rebuilt
+    std::thread reader([&document]() {
+        for (int i = 0; i < 500; ++i)
+        {
+            const auto text = document.text();
+            EXPECT_EQ(text->substr(text->size() - 13), "first\nsecond\n");
+        }
+    });
+    for (int i = 0; i < 500; ++i)
+        document.replace({ { 0, 0 }, { 0, 0 } }, "x");
+    reader.join();
+
+    EXPECT_EQ(*original, "first\nsecond\n");
+    EXPECT_EQ(*document.text(), std::string(500, 'x') + "first\nsecond\n");
+}
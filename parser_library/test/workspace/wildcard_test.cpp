@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2021 Broadcom.
+ * The term "Broadcom" refers to Broadcom Inc. and/or its subsidiaries.
+ *
+ * This program and the accompanying materials are made
+ * available under the terms of the Eclipse Public License 2.0
+ * which is available at https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Broadcom, Inc. - initial API and implementation
+ */
+
+#include "gtest/gtest.h"
+
+#include "workspaces/wildcard.h"
+
+using namespace hlasm_plugin::parser_library::workspaces;
+
+TEST(wildcard_matcher, same_as_regex)
+{
+    const std::vector<std::string> wildcards = {
+        "*",
+        "abc",
+        "a?c",
+        "*.asm",
+        "a*b*c",
+        "pgm+",
+        "(x)[y]*",
+        "*a*a*a",
+    };
+    const std::vector<std::string> names = {
+        "",
+        "abc",
+        "abbc",
+        "axc",
+        "ac",
+        "test.asm",
+        "test.asmx",
+        "aXbYc",
+        "abcabc",
+        "pgm",
+        "pgm1",
+        "(x)[y]z",
+        "xy",
+        "aaa",
+        "baaab",
+    };
+
+    for (const auto& wildcard : wildcards)
+    {
+        wildcard_matcher matcher;
+        matcher.add(wildcard);
+        auto regex = wildcard2regex(wildcard);
+
+        for (const auto& name : names)
+            EXPECT_EQ(matcher.match(name).has_value(), std::regex_match(name, regex)) << wildcard << " " << name;
+    }
+}
+
+TEST(wildcard_matcher, first_match_wins)
+{
+    wildcard_matcher matcher;
+    matcher.add("src*");
+    matcher.add("*.asm");
+    matcher.add("*");
+
+    EXPECT_EQ(matcher.size(), (size_t)3);
+    EXPECT_EQ(matcher.match("src.asm"), (size_t)0);
+    EXPECT_EQ(matcher.match("pgm.asm"), (size_t)1);
+    EXPECT_EQ(matcher.match("pgm"), (size_t)2);
+
+    matcher.clear();
+    EXPECT_EQ(matcher.match("pgm"), std::nullopt);
+}
@@ -16,6 +16,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iterator>
+#include <tuple>
 
 #include "gtest/gtest.h"
 
@@ -267,13 +268,20 @@ public:
 
     list_directory_result list_directory_files(const std::string&) override
     {
+        ++list_directory_calls;
         if (insert_correct_macro)
-            return { { { "ERROR", "ERROR" }, { "CORRECT", "CORRECT" } },
+            return { { { "ERROR", faulty_macro_path }, { "CORRECT", correct_macro_path } },
                 hlasm_plugin::utils::path::list_directory_rc::done };
-        return { { { "ERROR", "ERROR" } }, hlasm_plugin::utils::path::list_directory_rc::done };
+        return { { { "ERROR", faulty_macro_path } }, hlasm_plugin::utils::path::list_directory_rc::done };
+    }
+
+    bool file_exists(const std::string& file_name) override
+    {
+        return file_name == faulty_macro_path || (file_name == correct_macro_path && insert_correct_macro);
     }
 
     bool insert_correct_macro = true;
+    size_t list_directory_calls = 0;
 };
 
 enum class file_manager_opt_variant
@@ -318,7 +326,7 @@ public:
     list_directory_result list_directory_files(const std::string& path) override
     {
         if (path == "lib/" || path == "lib\\")
-            return { { { "CORRECT", "CORRECT" } }, hlasm_plugin::utils::path::list_directory_rc::done };
+            return { { { "CORRECT", correct_macro_path } }, hlasm_plugin::utils::path::list_directory_rc::done };
 
         return { {}, hlasm_plugin::utils::path::list_directory_rc::not_exists };
     }
@@ -393,6 +401,188 @@ TEST_F(workspace_test, did_change_watched_files)
     ASSERT_EQ(collect_and_get_diags_size(ws, file_manager), (size_t)0);
 }
 
+TEST_F(workspace_test, did_change_watched_files_incremental)
+{
+    file_manager_extended file_manager;
+    lib_config config;
+    workspace ws("", "workspace_name", file_manager, config);
+    ws.open();
+
+    ws.did_open_file("source3");
+    EXPECT_EQ(collect_and_get_diags_size(ws, file_manager), (size_t)0);
+    auto list_directory_calls = file_manager.list_directory_calls;
+
+    // the library applies the removal without listing the directory again
+    file_manager.insert_correct_macro = false;
+    ws.did_change_watched_files(correct_macro_path);
+    ASSERT_EQ(collect_and_get_diags_size(ws, file_manager), (size_t)1);
+    EXPECT_STREQ(diags()[0].code.c_str(), "E049");
+
+    file_manager.insert_correct_macro = true;
+    ws.did_change_watched_files(correct_macro_path);
+    ws.did_change_watched_files("source3");
+    EXPECT_EQ(collect_and_get_diags_size(ws, file_manager), (size_t)0);
+
+    EXPECT_EQ(file_manager.list_directory_calls, list_directory_calls);
+}
+
+TEST_F(workspace_test, macro_cache_shared_between_opencodes)
+{
+    file_manager_extended file_manager;
+    lib_config config;
+    workspace ws("", "workspace_name", file_manager, config);
+    ws.open();
+
+    // both open codes use the ERROR macro, the second one reuses the definition parsed for the first one
+    ws.did_open_file("source1");
+    ws.did_open_file("source2");
+
+    EXPECT_GT(file_manager.find_processor_file("source1")->get_metrics().macro_def_statements, (size_t)0);
+    EXPECT_EQ(file_manager.find_processor_file("source2")->get_metrics().macro_def_statements, (size_t)0);
+
+    // the macro file is still a dependency with its diagnostics
+    ASSERT_EQ(collect_and_get_diags_size(ws, file_manager), (size_t)3);
+    EXPECT_TRUE(match_strings({ faulty_macro_path, "source2", "source1" }));
+}
+
+std::string deferred_error_macro_file = R"( MACRO
+ DEFERR
+ LR 1,(
+ MEND
+)";
+const char* deferred_error_macro_path = is_windows() ? "lib\\DEFERR" : "lib/DEFERR";
+
+class file_manager_deferred_error : public file_manager_extended
+{
+public:
+    file_manager_deferred_error()
+    {
+        files_.insert_or_assign("source1", std::make_unique<file_with_text>("source1", " DEFERR"));
+        files_.insert_or_assign("source2", std::make_unique<file_with_text>("source2", " DEFERR"));
+        files_.emplace(deferred_error_macro_path,
+            std::make_unique<file_with_text>(deferred_error_macro_path, deferred_error_macro_file));
+    }
+
+    list_directory_result list_directory_files(const std::string&) override
+    {
+        return { { { "DEFERR", deferred_error_macro_path } }, hlasm_plugin::utils::path::list_directory_rc::done };
+    }
+};
+
+TEST_F(workspace_test, macro_cache_deferred_diags)
+{
+    file_manager_deferred_error file_manager;
+    lib_config config;
+    workspace ws("", "workspace_name", file_manager, config);
+    ws.open();
+
+    // the second open code reuses the macro with the operands parsed by the first one,
+    // the diagnostics of the operands are reported in both of them
+    ws.did_open_file("source1");
+    ws.did_open_file("source2");
+    EXPECT_EQ(file_manager.find_processor_file("source2")->get_metrics().macro_def_statements, (size_t)0);
+
+    auto macro_diags = [&file_manager](const std::string& program) {
+        const auto& d = file_manager.find_processor_file(program)->diags();
+        return std::count_if(
+            d.begin(), d.end(), [](const auto& diag) { return diag.file_name == deferred_error_macro_path; });
+    };
+    EXPECT_GT(macro_diags("source1"), 0);
+    EXPECT_EQ(macro_diags("source2"), macro_diags("source1"));
+}
+
+TEST_F(workspace_test, shared_ids_reset)
+{
+    file_manager_extended file_manager;
+    lib_config config;
+    workspace ws("", "workspace_name", file_manager, config);
+    ws.open();
+
+    ws.did_open_file("source1");
+    auto ids = ws.get_id_storage();
+    EXPECT_EQ(ws.get_id_storage(), ids);
+
+    // the storage is replaced once it grows too large, the cached members cannot be used with the new one
+    for (size_t i = 0; i <= workspace::MAX_SHARED_IDS; ++i)
+        ids->add(std::to_string(i));
+    ws.did_open_file("source2");
+
+    EXPECT_NE(ws.get_id_storage(), ids);
+    EXPECT_LT(ws.get_id_storage()->size(), workspace::MAX_SHARED_IDS);
+    EXPECT_GT(file_manager.find_processor_file("source2")->get_metrics().macro_def_statements, (size_t)0);
+}
+
+std::string copy_calling_macro_file = R"( MACCPY 1
+ MACCPY X
+)";
+const char* copy_calling_macro_path = is_windows() ? "lib\\CPYMAC" : "lib/CPYMAC";
+
+std::string copied_macro_file = R"( MACRO
+ MACCPY &P
+ LR &P,1
+ MEND
+)";
+const char* copied_macro_path = is_windows() ? "lib\\MACCPY" : "lib/MACCPY";
+
+// library members that are not open in the editor, so that they can be prefetched
+class library_file_with_text : public file_with_text
+{
+public:
+    library_file_with_text(const std::string& name, const std::string& text)
+        : file_impl(name)
+        , file_with_text(name, text)
+    {}
+
+    bool get_lsp_editing() override { return false; }
+};
+
+class file_manager_copy_macro : public file_manager_extended
+{
+public:
+    file_manager_copy_macro()
+    {
+        files_.insert_or_assign("source1", std::make_unique<file_with_text>("source1", " COPY CPYMAC\n LR 1,\n"));
+        files_.emplace(copy_calling_macro_path,
+            std::make_unique<library_file_with_text>(copy_calling_macro_path, copy_calling_macro_file));
+        files_.emplace(
+            copied_macro_path, std::make_unique<library_file_with_text>(copied_macro_path, copied_macro_file));
+    }
+
+    list_directory_result list_directory_files(const std::string&) override
+    {
+        return { { { "CPYMAC", copy_calling_macro_path }, { "MACCPY", copied_macro_path } },
+            hlasm_plugin::utils::path::list_directory_rc::done };
+    }
+};
+
+TEST_F(workspace_test, library_prefetch_same_results)
+{
+    auto analyze = [this](bool prefetch) {
+        file_manager_copy_macro file_manager;
+        lib_config config;
+        workspace ws("", "workspace_name", file_manager, config);
+        ws.set_library_prefetch(prefetch);
+        ws.open();
+
+        ws.did_open_file("source1");
+
+        collect_and_get_diags_size(ws, file_manager);
+        std::vector<std::tuple<std::string, std::string, size_t>> result;
+        for (const auto& d : diags())
+            result.emplace_back(d.file_name, d.code, d.diag_range.start.line);
+        std::sort(result.begin(), result.end());
+        return std::make_pair(result, file_manager.find_processor_file("source1")->dependencies());
+    };
+
+    // the macro called from the copy member is parsed in the background
+    const auto without_prefetch = analyze(false);
+    const auto with_prefetch = analyze(true);
+
+    EXPECT_FALSE(without_prefetch.first.empty());
+    EXPECT_EQ(without_prefetch.second.count(copied_macro_path), (size_t)1);
+    EXPECT_EQ(with_prefetch, without_prefetch);
+}
+
 TEST_F(workspace_test, missing_library_required)
 {
     for (auto type : { file_manager_opt_variant::old_school,